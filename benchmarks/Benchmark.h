@@ -0,0 +1,134 @@
+/**
+ * @file Benchmark.h
+ * @brief 性能测试程序的公共工具：计时、内存用量和JSON格式的测试结果输出
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+#include <initializer_list>
+#ifdef _WIN32
+	#include <windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+namespace rubber_duck{
+
+/**
+ * @brief 墙钟计时器
+ */
+class Stopwatch{
+private:
+	std::chrono::steady_clock::time_point start;
+public:
+	Stopwatch(){
+		reset();
+	}
+	/**
+	 * @brief 重新开始计时
+	 */
+	void reset(){
+		start = std::chrono::steady_clock::now();
+	}
+	/**
+	 * @brief 获得计时开始后经过的时间
+	 * @return double 经过的秒数
+	 */
+	double seconds() const{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+/**
+ * @brief 获得进程的内存用量峰值
+ * @return double 峰值常驻内存的KB数
+ */
+inline double peakMemoryKB(){
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if(GetProcessMemoryInfo(GetCurrentProcess(),&counters,sizeof(counters))){
+		return counters.PeakWorkingSetSize / 1024.0;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF,&usage);
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024.0;
+#else
+	return (double)usage.ru_maxrss;
+#endif
+#endif
+}
+
+/**
+ * @brief JSON格式的测试结果，每项测试结果由名称、字符串参数和数值指标组成，
+ * 用于性能回归跟踪
+ */
+class JsonReport{
+private:
+	std::string benchmark;
+	std::vector<std::string> results;
+public:
+	typedef std::pair<const char *,std::string> Param;
+	typedef std::pair<const char *,double> Metric;
+	/**
+	 * @brief 创建测试结果
+	 * @param  benchmark    测试程序名称
+	 */
+	JsonReport(const char * benchmark):benchmark(benchmark){}
+	/**
+	 * @brief 添加一项测试结果
+	 * @param  params    测试参数，值为字符串
+	 * @param  metrics   测试指标，值为数值
+	 */
+	void add(std::initializer_list<Param> params,std::initializer_list<Metric> metrics){
+		std::string result = "{";
+		char buf[64];
+		for(const Param & param:params){
+			if(result.size() > 1) result += ", ";
+			result += std::string("\"") + param.first + "\": \"" + param.second + "\"";
+		}
+		for(const Metric & metric:metrics){
+			if(result.size() > 1) result += ", ";
+			snprintf(buf,sizeof(buf),"%.6g",metric.second);
+			result += std::string("\"") + metric.first + "\": " + buf;
+		}
+		results.push_back(result + "}");
+	}
+	/**
+	 * @brief 输出全部测试结果
+	 * @param  fileName   JSON文件名称，NULL表示输出到控制台
+	 */
+	void write(const char * fileName = NULL){
+		FILE * file = fileName == NULL ? stdout : fopen(fileName,"w");
+		if(file == NULL){
+			printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+			return;
+		}
+		fprintf(file,"{\n  \"benchmark\": \"%s\",\n  \"results\": [",benchmark.c_str());
+		for(size_t i = 0;i < results.size();i ++){
+			fprintf(file,"%s\n    %s",i == 0 ? "" : ",",results[i].c_str());
+		}
+		fprintf(file,"\n  ]\n}\n");
+		if(file != stdout){
+			fclose(file);
+		}
+	}
+};
+
+}
+
+#endif /* BENCHMARK_H_ */
@@ -0,0 +1,121 @@
+/**
+ * @file Dispatch.cpp
+ * @brief 虚函数事件分派与EventDispatcher静态事件分派的性能对比测试程序
+ * 模型由三类普通事件和一类进程组成，事件在触发后按照伪随机间隔重新调度自身，
+ * 未来事件表长度保持不变，从而主要测量事件分派的开销。
+ * 用法：Dispatch [事件数量]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Simulator.h"
+#include "EventDispatch.h"
+#include "Benchmark.h"
+
+using namespace rubber_duck;
+
+template<int K> class Tick;
+class Cycle;
+
+typedef EventDispatcher<Tick<0>,Tick<1>,Tick<2>,Cycle> TickDispatcher;
+
+//已触发的事件数量
+long Triggered = 0;
+//停止仿真的事件数量
+long TotalEvents = 2000000;
+//事件间隔的伪随机数状态
+unsigned long Seed = 12345;
+
+//廉价的伪随机事件间隔，避免随机变量生成的开销影响测试结果
+double nextInterval(){
+	Seed = Seed * 6364136223846793005UL + 1442695040888963407UL;
+	return 1.0 + (double)((Seed >> 33) & 0xff) / 256.0;
+}
+
+//普通事件：触发后重新调度自身
+template<int K>
+class Tick:public EventNotice{
+public:
+	Tick(double time,bool typed):EventNotice(time){
+		reserved = true;
+		if(typed){
+			setTypeId(TickDispatcher::typeIdOf<Tick<K> >());
+		}
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		if(++ Triggered >= TotalEvents){
+			pSimulator->stop();
+		}
+		setTime(pSimulator->getClock() + nextInterval() * (K + 1));
+		pSimulator->scheduleEvent(this);
+	};
+};
+
+//进程：在两个复活点之间交替推进
+class Cycle:public ProcessNotice{
+public:
+	Cycle(double time,bool typed):ProcessNotice(time,0){
+		if(typed){
+			setTypeId(TickDispatcher::typeIdOf<Cycle>());
+		}
+	};
+
+	virtual const char * getPhaseName(){
+		return phase == 0 ? "推进" : "返回";
+	};
+
+	virtual double runToBlocked(Simulator * pSimulator){
+		if(++ Triggered >= TotalEvents){
+			pSimulator->stop();
+		}
+		phase = 1 - phase;
+		return pSimulator->getClock() + nextInterval();
+	};
+
+	virtual bool isConditionalBlocking(Simulator * pSimulator){
+		return false;
+	};
+};
+
+double runModel(bool typed){
+	Triggered = 0;
+	Seed = 12345;
+	Simulator * pSimulator = new Simulator(12345678,NULL);
+	for(int i = 0;i < 2;i ++){
+		pSimulator->scheduleEvent(new Tick<0>(nextInterval(),typed));
+		pSimulator->scheduleEvent(new Tick<1>(nextInterval(),typed));
+		pSimulator->scheduleEvent(new Tick<2>(nextInterval(),typed));
+		pSimulator->activate(new Cycle(nextInterval(),typed));
+	}
+	Stopwatch watch;
+	if(typed){
+		pSimulator->runDispatched<TickDispatcher>();
+	}else{
+		pSimulator->run();
+	}
+	double seconds = watch.seconds();
+	delete pSimulator;
+	return seconds;
+}
+
+int main(int argc, char* argv[]){
+	if(argc > 1){
+		TotalEvents = atol(argv[1]);
+	}
+	//预热一次，避免首次运行的缓存和页面分配影响
+	runModel(false);
+	double virtualSeconds = runModel(false);
+	double typedSeconds = runModel(true);
+
+	printf("%-12s %12s %12s %14s\n","DISPATCH","EVENTS","SECONDS","NS/EVENT");
+	printf("%-12s %12ld %12.4f %14.2f\n","virtual",TotalEvents,virtualSeconds,virtualSeconds * 1e9 / TotalEvents);
+	printf("%-12s %12ld %12.4f %14.2f\n","typed",TotalEvents,typedSeconds,typedSeconds * 1e9 / TotalEvents);
+	printf("speedup: %.3f\n",virtualSeconds / typedSeconds);
+	return 0;
+}
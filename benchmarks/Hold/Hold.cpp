@@ -0,0 +1,181 @@
+/**
+ * @file Hold.cpp
+ * @brief 未来事件表的经典hold模型性能测试程序
+ * 未来事件表预先装入指定数量的事件，每个事件触发后按照时间增量分布重新调度自身，
+ * 未来事件表长度保持不变，每次hold操作包括一次取出最早事件和一次插入事件。
+ * 时间增量分布的均值都为1：
+ *     exponential  指数分布
+ *     uniform      [0,2]均匀分布
+ *     bimodal      双峰分布，0.9的概率取[0,0.2]均匀分布，0.1的概率取[0,18.2]均匀分布
+ *     triangular   三角分布(0,1,2)
+ * 用法：Hold [-sizes 10,100,1000] [-dists exponential,uniform,bimodal,triangular] [-events 事件数量] [-json 文件]
+ * 输出每种组合的事件执行速度（事件/秒）、扣除时间增量生成开销后每个事件的纳秒数和内存用量峰值，
+ * 指定-json时同时输出JSON格式的测试结果。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "Simulator.h"
+#include "Benchmark.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//时间增量分布
+enum Distribution{ EXPONENTIAL, UNIFORM, BIMODAL, TRIANGULAR };
+const char * DistributionNames[] = {"exponential", "uniform", "bimodal", "triangular"};
+
+//已触发的事件数量
+long Triggered = 0;
+//停止仿真的事件数量
+long TotalEvents = 200000;
+//当前测试的时间增量分布
+Distribution CurrentDistribution = EXPONENTIAL;
+
+//产生均值为1的时间增量
+double nextIncrement(Random * random){
+	switch(CurrentDistribution){
+	case EXPONENTIAL:
+		return random->nextExponential(1.0);
+	case UNIFORM:
+		return random->nextDouble(0,2);
+	case BIMODAL:
+		return random->probability(0.9) ? random->nextDouble(0,0.2) : random->nextDouble(0,18.2);
+	case TRIANGULAR:
+		return random->nextTriang(0,1,2);
+	}
+	return 1.0;
+}
+
+//hold事件：触发后按照时间增量重新调度自身
+class HoldEvent:public EventNotice{
+public:
+	HoldEvent(double time):EventNotice(time){
+		reserved = true;
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		if(++ Triggered >= TotalEvents){
+			pSimulator->stop();
+		}
+		setTime(pSimulator->getClock() + nextIncrement(pSimulator->getRandom()));
+		pSimulator->scheduleEvent(this);
+	};
+};
+
+//运行一次hold模型，返回秒数
+double runHold(int size){
+	Triggered = 0;
+	Simulator * pSimulator = new Simulator(12345678,NULL);
+	for(int i = 0;i < size;i ++){
+		pSimulator->scheduleEvent(new HoldEvent(nextIncrement(pSimulator->getRandom())));
+	}
+	Stopwatch watch;
+	pSimulator->run();
+	double seconds = watch.seconds();
+	//事件触发后总是重新调度自身，仿真结束时全部事件仍在FEL中，由Simulator删除
+	delete pSimulator;
+	return seconds;
+}
+
+//测量生成时间增量的开销，返回每个样本的纳秒数
+double incrementCost(){
+	Random random(12345678);
+	double sum = 0;
+	Stopwatch watch;
+	for(long i = 0;i < TotalEvents;i ++){
+		sum += nextIncrement(&random);
+	}
+	double seconds = watch.seconds();
+	//使用sum避免循环被优化掉
+	if(sum < 0){
+		printf("%f\n",sum);
+	}
+	return seconds * 1e9 / TotalEvents;
+}
+
+//解析逗号分隔的参数列表
+vector<string> splitList(const char * text){
+	vector<string> items;
+	string item;
+	for(const char * p = text;;p ++){
+		if(*p == ',' || *p == 0){
+			if(!item.empty()){
+				items.push_back(item);
+			}
+			item.clear();
+			if(*p == 0){
+				break;
+			}
+		}else{
+			item += *p;
+		}
+	}
+	return items;
+}
+
+void usage(){
+	printf("用法：Hold [-sizes 10,100,1000] [-dists exponential,uniform,bimodal,triangular] [-events 事件数量] [-json 文件]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	vector<string> sizes = splitList("10,100,1000");
+	vector<string> dists = splitList("exponential,uniform,bimodal,triangular");
+	const char * jsonFileName = NULL;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-sizes") == 0 && i + 1 < argc){
+			sizes = splitList(argv[++ i]);
+		}else if(strcmp(argv[i],"-dists") == 0 && i + 1 < argc){
+			dists = splitList(argv[++ i]);
+		}else if(strcmp(argv[i],"-events") == 0 && i + 1 < argc){
+			TotalEvents = atol(argv[++ i]);
+		}else if(strcmp(argv[i],"-json") == 0 && i + 1 < argc){
+			jsonFileName = argv[++ i];
+		}else{
+			usage();
+		}
+	}
+
+	JsonReport report("Hold");
+	printf("%-12s %8s %10s %10s %14s %12s %12s %12s\n",
+			"DIST","FEL","EVENTS","SECONDS","EVENTS/S","NS/EVENT","NET NS/EV","PEAK KB");
+	for(size_t d = 0;d < dists.size();d ++){
+		int dist = -1;
+		for(int k = 0;k < 4;k ++){
+			if(dists[d] == DistributionNames[k]){
+				dist = k;
+			}
+		}
+		if(dist < 0){
+			printf("错误：未知的时间增量分布（%s）\n",dists[d].c_str());
+			usage();
+		}
+		CurrentDistribution = (Distribution)dist;
+		double cost = incrementCost();
+		for(size_t s = 0;s < sizes.size();s ++){
+			int size = atoi(sizes[s].c_str());
+			double seconds = runHold(size);
+			double rate = TotalEvents / seconds;
+			double ns = seconds * 1e9 / TotalEvents;
+			double memory = peakMemoryKB();
+			printf("%-12s %8d %10ld %10.4f %14.0f %12.2f %12.2f %12.0f\n",
+					DistributionNames[dist],size,TotalEvents,seconds,rate,ns,ns - cost,memory);
+			report.add({{"distribution",DistributionNames[dist]},{"fel_size",sizes[s]}},
+					{{"events",(double)TotalEvents},{"seconds",seconds},{"events_per_second",rate},
+					 {"ns_per_event",ns},{"net_ns_per_event",ns - cost},{"peak_rss_kb",memory}});
+		}
+	}
+	if(jsonFileName != NULL){
+		report.write(jsonFileName);
+	}
+	return 0;
+}
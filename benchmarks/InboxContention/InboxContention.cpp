@@ -0,0 +1,285 @@
+/**
+ * @file InboxContention.cpp
+ * @brief 跨线程事件收件箱的竞争性能测试程序
+ * 多个生产者线程同时向一个消费者投递共-items个元素，每个生产者投递的元素数量相同，
+ * 消费者线程不断批量取出元素，直到取出全部元素。比较三种收件箱：
+ * mpsc为无锁多生产者单消费者队列MpscQueue；mutex为互斥量保护的双端队列，消费者加锁后整体交换取出；
+ * simulator为Simulator::post投递事件，由运行中的仿真引擎在事件循环开始时取出并执行，
+ * 由于FEL按照时间顺序逐个插入事件，生产者在未执行的投递事件超过InFlight个时等待仿真引擎处理。
+ * 生产者数量按照1、2、4……加倍到-producers，输出墙钟时间、每秒投递元素数量、平均每批取出的元素数量，
+ * 并检查取出元素的总和以及每个生产者投递元素的先后顺序。
+ * 用法：InboxContention [-items 元素数量] [-producers 最多生产者数量] [-json 文件]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include "Simulator.h"
+#include "MpscQueue.h"
+#include "Benchmark.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//元素编码：高位为生产者序号，低位为生产者内的序号
+const int SequenceBits = 40;
+//simulator收件箱允许的最多未执行投递事件数量
+const uint64_t InFlight = 256;
+
+//消费者的检查结果
+struct Checker{
+	vector<uint64_t> last;
+	uint64_t sum = 0;
+	uint64_t count = 0;
+	bool ordered = true;
+
+	explicit Checker(unsigned producers):last(producers,0){
+	}
+	void consume(uint64_t value){
+		unsigned producer = (unsigned)(value >> SequenceBits);
+		uint64_t sequence = value & (((uint64_t)1 << SequenceBits) - 1);
+		//每个生产者的序号从1开始连续递增
+		ordered = ordered && sequence == last[producer] + 1;
+		last[producer] = sequence;
+		sum += value;
+		count ++;
+	}
+};
+
+//一次测试的结果
+struct Result{
+	double seconds = 0;
+	double batch = 0;
+	bool correct = false;
+};
+
+//互斥量保护的双端队列收件箱
+class MutexInbox{
+private:
+	std::mutex mutex;
+	deque<uint64_t> items;
+	deque<uint64_t> taken;
+public:
+	uint64_t batches = 0;
+	uint64_t popped = 0;
+
+	void push(uint64_t value){
+		lock_guard<std::mutex> lock(mutex);
+		items.push_back(value);
+	}
+	template<class F>
+	size_t drain(F consume){
+		{
+			lock_guard<std::mutex> lock(mutex);
+			if(items.empty()){
+				return 0;
+			}
+			taken.swap(items);
+		}
+		size_t count = taken.size();
+		for(size_t i = 0;i < count;i ++){
+			consume(taken[i]);
+		}
+		taken.clear();
+		popped += count;
+		batches ++;
+		return count;
+	}
+};
+
+//投递到仿真引擎的计数事件
+class CountEvent:public EventNotice{
+private:
+	uint64_t value;
+	Checker * checker;
+	atomic<uint64_t> * consumed;
+public:
+	CountEvent(uint64_t value,Checker * checker,atomic<uint64_t> * consumed)
+			:EventNotice(0),value(value),checker(checker),consumed(consumed){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		checker->consume(value);
+		consumed->store(checker->count,memory_order_release);
+	};
+};
+
+//轮询事件：尚未收到全部投递的事件时让出处理器，并在下一个时间单位重新调度，保持仿真运行
+class PollEvent:public EventNotice{
+private:
+	Checker * checker;
+	uint64_t total;
+public:
+	PollEvent(double time,Checker * checker,uint64_t total):EventNotice(time),checker(checker),total(total){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		if(checker->count < total){
+			this_thread::yield();
+			pSimulator->scheduleEvent(new PollEvent(pSimulator->getClock() + 1,checker,total));
+		}
+	};
+};
+
+//启动生产者线程，全部线程就绪后同时开始投递
+template<class Push>
+void startProducers(vector<thread> & threads,unsigned producers,uint64_t perProducer,atomic<bool> & go,Push push){
+	for(unsigned p = 0;p < producers;p ++){
+		threads.emplace_back([p,perProducer,&go,push](){
+			while(!go.load(memory_order_acquire)){
+				this_thread::yield();
+			}
+			uint64_t base = (uint64_t)p << SequenceBits;
+			for(uint64_t i = 1;i <= perProducer;i ++){
+				push(base + i);
+			}
+		});
+	}
+}
+
+//生产者投递元素的期望总和
+uint64_t expectedSum(unsigned producers,uint64_t perProducer){
+	uint64_t sum = 0;
+	for(unsigned p = 0;p < producers;p ++){
+		sum += ((uint64_t)p << SequenceBits) * perProducer + perProducer * (perProducer + 1) / 2;
+	}
+	return sum;
+}
+
+//测试队列收件箱，消费者为当前线程
+template<class Queue>
+Result runQueue(Queue & queue,unsigned producers,uint64_t perProducer){
+	Checker checker(producers);
+	uint64_t total = perProducer * producers;
+	atomic<bool> go(false);
+	vector<thread> threads;
+	startProducers(threads,producers,perProducer,go,[&queue](uint64_t value){ queue.push(value); });
+	Stopwatch watch;
+	go.store(true,memory_order_release);
+	while(checker.count < total){
+		if(queue.drain([&checker](uint64_t value){ checker.consume(value); }) == 0){
+			this_thread::yield();
+		}
+	}
+	Result result;
+	result.seconds = watch.seconds();
+	for(size_t i = 0;i < threads.size();i ++){
+		threads[i].join();
+	}
+	result.batch = queue.batches > 0 ? (double)queue.popped / queue.batches : 0;
+	result.correct = checker.ordered && checker.sum == expectedSum(producers,perProducer);
+	return result;
+}
+
+//MpscQueue的计数器通过访问函数获取
+struct MpscInbox:public MpscQueue<uint64_t>{
+	uint64_t batches = 0;
+	uint64_t popped = 0;
+
+	template<class F>
+	size_t drain(F consume){
+		size_t count = MpscQueue<uint64_t>::drain(consume);
+		batches = getBatches();
+		popped = getPopped();
+		return count;
+	}
+};
+
+//测试Simulator::post，消费者为运行仿真的当前线程
+Result runSimulator(unsigned producers,uint64_t perProducer){
+	Checker checker(producers);
+	uint64_t total = perProducer * producers;
+	Simulator * pSimulator = new Simulator(1,NULL);
+	pSimulator->scheduleEvent(new PollEvent(0,&checker,total));
+	atomic<bool> go(false);
+	vector<thread> threads;
+	atomic<uint64_t> consumed(0);
+	startProducers(threads,producers,perProducer,go,[pSimulator,&checker,&consumed](uint64_t value){
+		pSimulator->post(new CountEvent(value,&checker,&consumed));
+		while(pSimulator->getPostedEventCount() > consumed.load(memory_order_acquire) + InFlight){
+			this_thread::yield();
+		}
+	});
+	Stopwatch watch;
+	go.store(true,memory_order_release);
+	pSimulator->run();
+	Result result;
+	result.seconds = watch.seconds();
+	for(size_t i = 0;i < threads.size();i ++){
+		threads[i].join();
+	}
+	uint64_t batches = pSimulator->getPostedBatchCount();
+	result.batch = batches > 0 ? (double)checker.count / batches : 0;
+	result.correct = checker.ordered && checker.sum == expectedSum(producers,perProducer)
+			&& pSimulator->getPostedEventCount() == total;
+	delete pSimulator;
+	return result;
+}
+
+void usage(){
+	printf("用法：InboxContention [-items 元素数量] [-producers 最多生产者数量] [-json 文件]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	const char * jsonFileName = NULL;
+	long items = 1 << 20;
+	unsigned maxProducers = 64;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-items") == 0 && i + 1 < argc){
+			items = atol(argv[++ i]);
+		}else if(strcmp(argv[i],"-producers") == 0 && i + 1 < argc){
+			maxProducers = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-json") == 0 && i + 1 < argc){
+			jsonFileName = argv[++ i];
+		}else{
+			usage();
+		}
+	}
+	if(items < 1 || maxProducers < 1){
+		usage();
+	}
+	JsonReport report("InboxContention");
+	printf("%-10s %10s %10s %14s %10s %8s\n","INBOX","PRODUCERS","SECONDS","ITEMS/S","BATCH","RESULT");
+	const char * inboxes[] = {"mpsc","mutex","simulator"};
+	for(unsigned producers = 1;;producers *= 2){
+		producers = producers > maxProducers ? maxProducers : producers;
+		uint64_t perProducer = (uint64_t)(items / producers > 0 ? items / producers : 1);
+		for(int k = 0;k < 3;k ++){
+			Result result;
+			if(k == 0){
+				MpscInbox queue;
+				result = runQueue(queue,producers,perProducer);
+			}else if(k == 1){
+				MutexInbox queue;
+				result = runQueue(queue,producers,perProducer);
+			}else{
+				result = runSimulator(producers,perProducer);
+			}
+			double total = (double)perProducer * producers;
+			printf("%-10s %10u %10.4f %14.0f %10.1f %8s\n",inboxes[k],producers,result.seconds,
+					total / result.seconds,result.batch,result.correct ? "正确" : "错误");
+			report.add({{"inbox",inboxes[k]},{"producers",to_string(producers)}},{{"seconds",result.seconds},
+					{"items",total},{"items_per_second",total / result.seconds},{"batch",result.batch},
+					{"correct",result.correct ? 1.0 : 0.0}});
+		}
+		if(producers >= maxProducers){
+			break;
+		}
+	}
+	if(jsonFileName != NULL){
+		report.write(jsonFileName);
+	}
+	return 0;
+}
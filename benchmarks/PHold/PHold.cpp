@@ -0,0 +1,137 @@
+/**
+ * @file PHold.cpp
+ * @brief PHOLD模型性能测试程序
+ * 模型由若干逻辑对象组成，每个对象初始有指定数量的消息事件。对象收到消息后，
+ * 按照远程概率将新消息发送给随机选择的其他对象，否则发送给自身，新消息的时间戳为
+ * 当前时间加上前瞻量和均值为1的指数分布时间增量。与hold模型不同，每条消息都新建
+ * 事件对象并在执行后删除，因此同时测试事件表和内存分配的开销。
+ * 用法：PHold [-objects 对象数量] [-population 每个对象的初始消息数量] [-remote 远程概率]
+ *             [-lookahead 前瞻量] [-events 事件数量] [-json 文件]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "Simulator.h"
+#include "Benchmark.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//逻辑对象数量
+int Objects = 64;
+//每个对象的初始消息数量
+int Population = 16;
+//发送给其他对象的概率
+double Remote = 0.9;
+//消息时间戳的最小增量
+double Lookahead = 0.1;
+//已触发的事件数量
+long Triggered = 0;
+//停止仿真的事件数量
+long TotalEvents = 200000;
+//每个对象处理的消息数量
+vector<long> Received;
+
+//消息事件：目标对象处理后发送一条新消息
+class PHoldEvent:public EventNotice{
+private:
+	int target;
+public:
+	PHoldEvent(double time,int target):EventNotice(time),target(target){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		Received[target] ++;
+		if(++ Triggered >= TotalEvents){
+			pSimulator->stop();
+		}
+		Random * random = pSimulator->getRandom();
+		int destination = target;
+		if(Objects > 1 && random->probability(Remote)){
+			//在其他对象中均匀选择，nextInteger的取值范围不包括上界
+			destination = random->nextInteger(0,Objects - 1);
+			if(destination >= target){
+				destination ++;
+			}
+		}
+		double time = pSimulator->getClock() + Lookahead + random->nextExponential(1.0);
+		pSimulator->scheduleEvent(new PHoldEvent(time,destination));
+	};
+};
+
+void usage(){
+	printf("用法：PHold [-objects 对象数量] [-population 每个对象的初始消息数量] [-remote 远程概率] "
+			"[-lookahead 前瞻量] [-events 事件数量] [-json 文件]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	const char * jsonFileName = NULL;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-objects") == 0 && i + 1 < argc){
+			Objects = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-population") == 0 && i + 1 < argc){
+			Population = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-remote") == 0 && i + 1 < argc){
+			Remote = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-lookahead") == 0 && i + 1 < argc){
+			Lookahead = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-events") == 0 && i + 1 < argc){
+			TotalEvents = atol(argv[++ i]);
+		}else if(strcmp(argv[i],"-json") == 0 && i + 1 < argc){
+			jsonFileName = argv[++ i];
+		}else{
+			usage();
+		}
+	}
+	if(Objects < 1 || Population < 1){
+		usage();
+	}
+
+	Received.assign(Objects,0);
+	Simulator * pSimulator = new Simulator(12345678,NULL);
+	for(int o = 0;o < Objects;o ++){
+		for(int p = 0;p < Population;p ++){
+			double time = Lookahead + pSimulator->getRandom()->nextExponential(1.0);
+			pSimulator->scheduleEvent(new PHoldEvent(time,o));
+		}
+	}
+	Stopwatch watch;
+	pSimulator->run();
+	double seconds = watch.seconds();
+	double simulated = pSimulator->getClock();
+	delete pSimulator;
+
+	//各对象处理消息数量的最小值和最大值反映负载是否均衡
+	long minReceived = Received[0], maxReceived = Received[0];
+	for(int o = 1;o < Objects;o ++){
+		minReceived = Received[o] < minReceived ? Received[o] : minReceived;
+		maxReceived = Received[o] > maxReceived ? Received[o] : maxReceived;
+	}
+	double rate = TotalEvents / seconds;
+	double ns = seconds * 1e9 / TotalEvents;
+	double memory = peakMemoryKB();
+	printf("%-8s %-10s %-8s %-10s %10s %10s %14s %12s %12s\n",
+			"OBJECTS","POPULATION","REMOTE","LOOKAHEAD","EVENTS","SECONDS","EVENTS/S","NS/EVENT","PEAK KB");
+	printf("%-8d %-10d %-8.2f %-10.3f %10ld %10.4f %14.0f %12.2f %12.0f\n",
+			Objects,Population,Remote,Lookahead,TotalEvents,seconds,rate,ns,memory);
+	printf("仿真时间：%f，对象处理消息数量：最小%ld，最大%ld\n",simulated,minReceived,maxReceived);
+
+	if(jsonFileName != NULL){
+		JsonReport report("PHold");
+		report.add({{"objects",to_string(Objects)},{"population",to_string(Population)},
+				{"remote",to_string(Remote)},{"lookahead",to_string(Lookahead)}},
+				{{"events",(double)TotalEvents},{"seconds",seconds},{"events_per_second",rate},
+				 {"ns_per_event",ns},{"simulated_time",simulated},{"peak_rss_kb",memory}});
+		report.write(jsonFileName);
+	}
+	return 0;
+}
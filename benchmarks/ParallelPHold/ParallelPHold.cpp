@@ -0,0 +1,347 @@
+/**
+ * @file ParallelPHold.cpp
+ * @brief 并行仿真引擎的PHOLD模型加速比和效率测试程序
+ * 每个逻辑进程是一个PHOLD对象，初始有-population条消息。对象收到消息后，按照远程概率
+ * 将新消息发送给随机选择的其他对象，否则发送给自身，新消息的时间戳为当前时间加前瞻量和
+ * 均值为1的指数分布时间增量，全部对象两两之间建立前瞻量为-lookahead的通道。
+ * 程序先在一个Simulator中顺序运行同一模型作为基准，再以1、2、4……直到-threads个工作线程
+ * 分别运行保守同步（CMB）、时间窗口同步（YAWNS）和乐观同步（Time Warp）并行仿真引擎，并以同样数量的分区进程运行
+ * 共享内存多进程保守同步引擎（MultiProcessEngine），输出墙钟时间、提交的事件处理速率、
+ * 相对顺序仿真的加速比、空消息数量、回滚撤销的事件数量和效率（提交事件数量/执行事件数量）。
+ * -engine只运行指定的引擎，-batch和-window设置Time Warp每次推进执行的事件数量和乐观窗口。
+ * 事件处理前保存对象随机数子流的状态，回滚时恢复，顺序仿真和各次并行仿真提交的事件数量相同。
+ * 多进程引擎还检查各对象随机数子流的最终状态与顺序仿真相同。
+ * -work指定每个事件附加的计算量（循环次数），事件粒度越大，同步开销所占比例越小。
+ * -tick为每个对象增加一个按照该周期重新调度自身的保留事件，对事件进行计数，检查乐观同步回滚保留事件后
+ * 各对象的计数与顺序仿真相同。
+ * 用法：ParallelPHold [-lps 逻辑进程数量] [-population 每个对象的初始消息数量] [-remote 远程概率]
+ *                     [-lookahead 前瞻量] [-end 结束时间] [-work 计算量] [-threads 最多线程数量]
+ *                     [-engine cmb|window|timewarp|process] [-batch 事件数量] [-window 乐观窗口]
+ *                     [-tick 周期] [-json 文件]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "Simulator.h"
+#include "RandomStreams.h"
+#include "ThreadPool.h"
+#include "ConservativeEngine.h"
+#include "TimeWarpEngine.h"
+#include "WindowEngine.h"
+#include "MultiProcessEngine.h"
+#include "EventCodec.h"
+#include "Benchmark.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//逻辑进程（对象）数量
+int LPs = 8;
+//每个对象的初始消息数量
+int Population = 16;
+//发送给其他对象的概率
+double Remote = 0.5;
+//消息时间戳的最小增量，即通道前瞻量
+double Lookahead = 0.1;
+//仿真结束时间
+double EndTime = 1000;
+//每个事件附加的计算量
+long Work = 1000;
+//Time Warp每次推进执行的事件数量和乐观窗口
+unsigned Batch = 16;
+double Window = DBL_MAX;
+//计数事件的周期，0表示没有计数事件
+double TickPeriod = 0;
+
+//PHOLD对象
+struct PHoldObject{
+	//所属逻辑进程，顺序仿真时为NULL
+	LogicalProcess * lp = NULL;
+	//对象所在的仿真引擎
+	Simulator * simulator = NULL;
+	//对象的随机数子流
+	Random * random = NULL;
+	//计数事件的触发次数
+	long ticks = 0;
+};
+
+//全部对象，下标为对象序号
+vector<PHoldObject> Objects;
+//顺序仿真结束时各对象随机数子流的下一个随机数，用于检查多进程并行仿真的模型状态
+vector<uint64_t> FinalStates;
+//顺序仿真结束时各对象计数事件的触发次数
+vector<long> FinalTicks;
+
+//消息事件：目标对象处理后发送一条新消息
+class PHoldEvent:public EventNotice{
+private:
+	int target;
+public:
+	PHoldEvent(double time,int target):EventNotice(time),target(target){
+	};
+
+	//多进程并行仿真时编码和解码跨进程发送的消息
+	void encode(string & bytes){
+		EventCodec::put(bytes,target);
+	}
+	static EventNotice * decode(double time,const char * bytes,size_t size){
+		int target;
+		EventCodec::get(bytes,bytes + size,target);
+		return new PHoldEvent(time,target);
+	}
+
+	virtual void trigger(Simulator * pSimulator){
+		volatile double x = 0;
+		for(long i = 0;i < Work;i ++){
+			x += sqrt((double)i);
+		}
+		PHoldObject & object = Objects[target];
+		//乐观同步回滚时恢复随机数子流的状态
+		if(object.lp != NULL){
+			object.lp->saveState(object.random);
+		}
+		int destination = target;
+		if(LPs > 1 && object.random->probability(Remote)){
+			//在其他对象中均匀选择，nextInteger的取值范围不包括上界
+			destination = object.random->nextInteger(0,LPs - 1);
+			if(destination >= target){
+				destination ++;
+			}
+		}
+		double time = pSimulator->getClock() + Lookahead + object.random->nextExponential(1.0);
+		if(object.lp == NULL){
+			pSimulator->scheduleEvent(new PHoldEvent(time,destination));
+		}else{
+			object.lp->send(Objects[destination].lp,new PHoldEvent(time,destination));
+		}
+	};
+};
+
+//计数事件：保留的事件，触发后按照固定周期重新调度自身
+class TickEvent:public EventNotice{
+private:
+	int target;
+public:
+	TickEvent(double time,int target):EventNotice(time),target(target){
+		reserved = true;
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		PHoldObject & object = Objects[target];
+		if(object.lp != NULL){
+			object.lp->saveState(object.ticks);
+		}
+		object.ticks ++;
+		setTime(pSimulator->getClock() + TickPeriod);
+		pSimulator->scheduleEvent(this);
+	};
+};
+
+//创建对象的随机数子流并调度初始消息
+void initObjects(RandomStreams & streams){
+	char name[32];
+	for(int o = 0;o < LPs;o ++){
+		snprintf(name,sizeof(name),"object %d",o);
+		Objects[o].random = streams.get(name);
+		Objects[o].ticks = 0;
+		if(TickPeriod > 0){
+			Objects[o].simulator->scheduleEvent(new TickEvent(TickPeriod,o));
+		}
+		for(int p = 0;p < Population;p ++){
+			double time = Lookahead + Objects[o].random->nextExponential(1.0);
+			Objects[o].simulator->scheduleEvent(new PHoldEvent(time,o));
+		}
+	}
+}
+
+//在并行仿真引擎中建立逻辑进程并运行，保守同步和窗口同步需要全部对象两两之间的通道
+void runEngine(ParallelEngine & engine,unsigned threads,unsigned long seed){
+	char name[32];
+	for(int o = 0;o < LPs;o ++){
+		snprintf(name,sizeof(name),"object %d",o);
+		Objects[o].lp = engine.addLogicalProcess(name,seed + o);
+		Objects[o].simulator = Objects[o].lp->getSimulator();
+	}
+	for(int s = 0;s < LPs;s ++){
+		for(int d = 0;d < LPs;d ++){
+			if(s != d){
+				engine.connect(Objects[s].lp,Objects[d].lp,Lookahead);
+			}
+		}
+	}
+	RandomStreams streams(seed);
+	initObjects(streams);
+	engine.run(EndTime,threads);
+}
+
+//输出一次运行的结果
+void addResult(JsonReport & report,const char * engineName,unsigned threads,double seconds,uint64_t events,
+		double sequentialSeconds,uint64_t nulls,uint64_t rolledBack,double efficiency){
+	printf("%-12s %-8u %10.4f %12llu %14.0f %10.2f %12llu %12.4f %12llu %10.4f\n",engineName,threads,seconds,
+			(unsigned long long)events,events / seconds,sequentialSeconds / seconds,(unsigned long long)nulls,
+			(double)nulls / events,(unsigned long long)rolledBack,efficiency);
+	report.add({{"engine",engineName},{"threads",to_string(threads)}},
+			{{"seconds",seconds},{"events",(double)events},{"events_per_second",events / seconds},
+			 {"speedup",sequentialSeconds / seconds},{"null_messages",(double)nulls},
+			 {"rolled_back",(double)rolledBack},{"efficiency",efficiency}});
+}
+
+void usage(){
+	printf("用法：ParallelPHold [-lps 逻辑进程数量] [-population 每个对象的初始消息数量] [-remote 远程概率]\n"
+			"                    [-lookahead 前瞻量] [-end 结束时间] [-work 计算量] [-threads 最多线程数量]\n"
+			"                    [-engine cmb|window|timewarp|process] [-batch 事件数量] [-window 乐观窗口]\n"
+			"                    [-tick 周期] [-json 文件]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	const char * jsonFileName = NULL;
+	unsigned maxThreads = ThreadPool::hardwareThreads();
+	unsigned long seed = 12345678;
+	bool conservative = true, windowed = true, optimistic = true, multiprocess = true;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-lps") == 0 && i + 1 < argc){
+			LPs = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-population") == 0 && i + 1 < argc){
+			Population = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-remote") == 0 && i + 1 < argc){
+			Remote = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-lookahead") == 0 && i + 1 < argc){
+			Lookahead = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-end") == 0 && i + 1 < argc){
+			EndTime = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-work") == 0 && i + 1 < argc){
+			Work = atol(argv[++ i]);
+		}else if(strcmp(argv[i],"-threads") == 0 && i + 1 < argc){
+			maxThreads = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-engine") == 0 && i + 1 < argc){
+			i ++;
+			conservative = strcmp(argv[i],"cmb") == 0;
+			windowed = strcmp(argv[i],"window") == 0;
+			optimistic = strcmp(argv[i],"timewarp") == 0;
+			multiprocess = strcmp(argv[i],"process") == 0;
+		}else if(strcmp(argv[i],"-batch") == 0 && i + 1 < argc){
+			Batch = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-window") == 0 && i + 1 < argc){
+			Window = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-tick") == 0 && i + 1 < argc){
+			TickPeriod = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-json") == 0 && i + 1 < argc){
+			jsonFileName = argv[++ i];
+		}else{
+			usage();
+		}
+	}
+	if(LPs < 1 || Population < 1 || Lookahead <= 0 || EndTime <= 0 || maxThreads < 1 || Batch < 1 || Window <= 0
+			|| TickPeriod < 0
+			|| !(conservative || windowed || optimistic || multiprocess)){
+		usage();
+	}
+	EventCodec::add<PHoldEvent>("PHoldEvent");
+	JsonReport report("ParallelPHold");
+	printf("%-12s %-8s %10s %12s %14s %10s %12s %12s %12s %10s\n","ENGINE","THREADS","SECONDS","EVENTS",
+			"EVENTS/S","SPEEDUP","NULLS","NULLS/EVENT","ROLLED BACK","EFFICIENCY");
+
+	//顺序仿真基准
+	Objects.assign(LPs,PHoldObject());
+	Simulator * pSimulator = new Simulator(seed,NULL);
+	for(int o = 0;o < LPs;o ++){
+		Objects[o].simulator = pSimulator;
+	}
+	RandomStreams sequentialStreams(seed);
+	initObjects(sequentialStreams);
+	Stopwatch watch;
+	pSimulator->runUntil(nextafter(EndTime,DBL_MAX));
+	double sequentialSeconds = watch.seconds();
+	uint64_t sequentialEvents = pSimulator->getEventCount();
+	for(int o = 0;o < LPs;o ++){
+		FinalStates.push_back((*Objects[o].random->getEngine())());
+		FinalTicks.push_back(Objects[o].ticks);
+	}
+	delete pSimulator;
+	addResult(report,"sequential",1,sequentialSeconds,sequentialEvents,sequentialSeconds,0,0,1.0);
+
+	//线程数量按照1、2、4……加倍，最后一次为最多线程数量
+	for(unsigned threads = 1;;threads *= 2){
+		threads = threads > maxThreads ? maxThreads : threads;
+		if(conservative){
+			ConservativeEngine engine;
+			runEngine(engine,threads,seed);
+			if(engine.getEventCount() != sequentialEvents){
+				printf("错误：保守同步并行仿真事件数量（%llu）与顺序仿真（%llu）不一致\n",
+						(unsigned long long)engine.getEventCount(),(unsigned long long)sequentialEvents);
+			}
+			addResult(report,"cmb",engine.getThreadCount(),engine.getWallTime(),engine.getEventCount(),
+					sequentialSeconds,engine.getNullMessageCount(),0,1.0);
+		}
+		if(windowed){
+			WindowEngine engine;
+			runEngine(engine,threads,seed);
+			if(engine.getEventCount() != sequentialEvents){
+				printf("错误：窗口同步并行仿真事件数量（%llu）与顺序仿真（%llu）不一致\n",
+						(unsigned long long)engine.getEventCount(),(unsigned long long)sequentialEvents);
+			}
+			addResult(report,"window",engine.getThreadCount(),engine.getWallTime(),engine.getEventCount(),
+					sequentialSeconds,0,0,1.0);
+		}
+		if(optimistic){
+			TimeWarpEngine engine(Batch);
+			engine.setWindow(Window);
+			runEngine(engine,threads,seed);
+			if(engine.getEventCount() != sequentialEvents){
+				printf("错误：乐观同步并行仿真提交的事件数量（%llu）与顺序仿真（%llu）不一致\n",
+						(unsigned long long)engine.getEventCount(),(unsigned long long)sequentialEvents);
+			}
+			for(int o = 0;o < LPs;o ++){
+				if(Objects[o].ticks != FinalTicks[o]){
+					printf("错误：乐观同步并行仿真对象%d的计数（%ld）与顺序仿真（%ld）不一致\n",o,
+							Objects[o].ticks,FinalTicks[o]);
+					break;
+				}
+			}
+			addResult(report,"timewarp",engine.getThreadCount(),engine.getWallTime(),engine.getEventCount(),
+					sequentialSeconds,0,engine.getRolledBackEventCount(),engine.getEfficiency());
+		}
+		if(multiprocess){
+			//分区进程结束前返回对象随机数子流的下一个随机数，逻辑进程序号即对象序号
+			MultiProcessEngine engine;
+			engine.setCollector([](LogicalProcess * lp,string & bytes){
+				EventCodec::put(bytes,(*Objects[lp->getId()].random->getEngine())());
+			});
+			runEngine(engine,threads,seed);
+			bool same = engine.isSucceeded() && engine.getEventCount() == sequentialEvents;
+			for(int o = 0;o < LPs && same;o ++){
+				const string & data = engine.getResult(o).data;
+				const char * bytes = data.data();
+				uint64_t state;
+				EventCodec::get(bytes,data.data() + data.size(),state);
+				same = state == FinalStates[o];
+			}
+			if(!same){
+				printf("错误：多进程并行仿真事件数量（%llu）或模型状态与顺序仿真（%llu）不一致\n",
+						(unsigned long long)engine.getEventCount(),(unsigned long long)sequentialEvents);
+			}
+			addResult(report,"process",engine.getThreadCount(),engine.getWallTime(),engine.getEventCount(),
+					sequentialSeconds,engine.getNullMessageCount(),0,1.0);
+		}
+		if(threads >= maxThreads || threads >= (unsigned)LPs){
+			break;
+		}
+	}
+	printf("逻辑进程数量：%d，初始消息数量：%d，远程概率：%g，前瞻量：%g，结束时间：%g，事件计算量：%ld，计数周期：%g\n",
+			LPs,Population,Remote,Lookahead,EndTime,Work,TickPeriod);
+	if(jsonFileName != NULL){
+		report.write(jsonFileName);
+	}
+	return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file RandomBench.cpp
+ * @brief 随机变量生成性能测试程序
+ * 测量Random各分布随机变量生成的每个样本纳秒数，对于耗时与参数有关的分布分别测试
+ * 不同参数：Poisson分布的小lambda和大lambda（lambda>30时采用拒绝法）、二项分布的小n和大n、
+ * Gamma分布的alpha<1、alpha=1和alpha>1，以及nextDiscrete的不同经验分布表长度。
+ * 每项测试成倍增加样本数量，直到耗时不少于指定时间。
+ * 用法：RandomBench [-filter 名称] [-time 每项测试的最少秒数] [-json 文件]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "Random.h"
+#include "Benchmark.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//每项测试的最少秒数
+double MinSeconds = 0.2;
+//只运行名称包含该字符串的测试
+const char * Filter = NULL;
+//累加样本值，避免生成样本的代码被优化掉
+volatile double Sink = 0;
+
+JsonReport Report("RandomBench");
+
+//测量一项测试的每个样本纳秒数，sample为生成一个样本的函数对象
+template<class F>
+void measure(const char * name,const char * params,F sample){
+	if(Filter != NULL && strstr(name,Filter) == NULL){
+		return;
+	}
+	//预热
+	double sum = 0;
+	for(int i = 0;i < 1000;i ++){
+		sum += sample();
+	}
+	long samples = 1000;
+	double seconds = 0;
+	while(true){
+		Stopwatch watch;
+		for(long i = 0;i < samples;i ++){
+			sum += sample();
+		}
+		seconds = watch.seconds();
+		if(seconds >= MinSeconds){
+			break;
+		}
+		samples *= 2;
+	}
+	Sink = Sink + sum;
+	double ns = seconds * 1e9 / samples;
+	printf("%-18s %-24s %12ld %12.2f %16.0f\n",name,params,samples,ns,samples / seconds);
+	Report.add({{"distribution",name},{"params",params}},
+			{{"samples",(double)samples},{"ns_per_sample",ns},{"samples_per_second",samples / seconds}});
+}
+
+void usage(){
+	printf("用法：RandomBench [-filter 名称] [-time 每项测试的最少秒数] [-json 文件]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	const char * jsonFileName = NULL;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-filter") == 0 && i + 1 < argc){
+			Filter = argv[++ i];
+		}else if(strcmp(argv[i],"-time") == 0 && i + 1 < argc){
+			MinSeconds = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-json") == 0 && i + 1 < argc){
+			jsonFileName = argv[++ i];
+		}else{
+			usage();
+		}
+	}
+
+	Random random(12345678);
+	Random * r = &random;
+	char params[64];
+
+	printf("%-18s %-24s %12s %12s %16s\n","DISTRIBUTION","PARAMS","SAMPLES","NS/SAMPLE","SAMPLES/S");
+	measure("nextDouble","[0,1)",[r]{ return r->nextDouble(); });
+	measure("nextDouble","[2,5)",[r]{ return r->nextDouble(2,5); });
+	measure("nextInteger","[0,100)",[r]{ return (double)r->nextInteger(0,100); });
+	measure("probability","p=0.3",[r]{ return r->probability(0.3) ? 1.0 : 0.0; });
+	measure("nextExponential","mean=1",[r]{ return r->nextExponential(1.0); });
+	measure("nextNormal","mean=0,sd=1",[r]{ return r->nextNormal(0,1); });
+	measure("nextNormalBM","mean=0,sd=1",[r]{ return r->nextNormalBM(0,1); });
+	measure("nextTruncNormal","mean=1,sd=1",[r]{ return r->nextTruncNormal(1,1); });
+	measure("nextLogNormal","mean=1,sd=0.5",[r]{ return r->nextLogNormal(1,0.5); });
+	measure("nextChiSquare","n=5",[r]{ return r->nextChiSquare(5); });
+	measure("nextStudentT","n=5",[r]{ return r->nextStudentT(5); });
+	measure("nextF","n1=5,n2=10",[r]{ return r->nextF(5,10); });
+	measure("nextWeibull","alpha=2,beta=1",[r]{ return r->nextWeibull(2,1); });
+	measure("nextTriang","(0,1,2)",[r]{ return r->nextTriang(0,1,2); });
+	measure("nextBeta","alpha=2,beta=3",[r]{ return r->nextBeta(2,3); });
+	measure("nextGeometric","p=0.3",[r]{ return r->nextGeometric(0.3); });
+	measure("nextNegBinomial","p=0.3,r=5",[r]{ return r->nextNegBinomial(0.3,5); });
+	//Erlang分布k<7时为k个均匀分布乘积，否则采用Gamma分布
+	static const unsigned erlangK[] = {2, 10};
+	for(unsigned k:erlangK){
+		snprintf(params,sizeof(params),"k=%u,mean=1",k);
+		measure("nextErlang",params,[r,k]{ return r->nextErlang(k,1.0); });
+	}
+	static const double gammaAlpha[] = {0.5, 1.0, 2.5, 10.0};
+	for(double alpha:gammaAlpha){
+		snprintf(params,sizeof(params),"alpha=%g,beta=1",alpha);
+		measure("nextGamma",params,[r,alpha]{ return r->nextGamma(alpha,1.0); });
+	}
+	//lambda>30时采用拒绝法，否则为均匀分布乘积法，耗时与lambda成正比
+	static const double poissonLambda[] = {1, 10, 30, 31, 100, 1000};
+	for(double lambda:poissonLambda){
+		snprintf(params,sizeof(params),"lambda=%g",lambda);
+		measure("nextPoisson",params,[r,lambda]{ return r->nextPoisson(lambda); });
+	}
+	//二项分布由n次伯努利试验求和，耗时与n成正比
+	static const unsigned binomialN[] = {10, 100, 1000};
+	for(unsigned n:binomialN){
+		snprintf(params,sizeof(params),"p=0.3,n=%u",n);
+		measure("nextBinomial",params,[r,n]{ return r->nextBinomial(0.3,n); });
+	}
+	//nextDiscrete顺序查找累计概率表，耗时与表长度成正比
+	static const int discreteSizes[] = {4, 16, 64, 256, 1024};
+	for(int size:discreteSizes){
+		vector<int> values(size);
+		vector<double> probs(size,1.0 / size);
+		for(int i = 0;i < size;i ++){
+			values[i] = i;
+		}
+		//makeDiscreteCDFTable将概率累加为累计概率，保证最后一项为1
+		CDFDiscreteTable * table = makeDiscreteCDFTable(size,values.data(),probs.data());
+		table->y_axis[size - 1] = 1.0;
+		snprintf(params,sizeof(params),"size=%d",size);
+		measure("nextDiscrete",params,[r,table]{ return (double)r->nextDiscrete(table); });
+		delete table;
+	}
+	{
+		double x[] = {0, 1, 2, 3, 4};
+		double y[] = {0.25, 0.5, 0.75, 1.0, 1.0};
+		CDFTable * table = makeCDFTable(5,x,y);
+		measure("nextContinuous","size=4",[r,table]{ return r->nextContinuous(table); });
+		delete table;
+	}
+
+	if(jsonFileName != NULL){
+		Report.write(jsonFileName);
+	}
+	return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file SimultaneousEvents.cpp
+ * @brief 同时事件并行执行（Simulator::setSimultaneousThreads）的加速比测试程序
+ * 模型由-machines台机器组成，每台机器在每个整数时刻发生一次加工事件，事件的冲突键为机器序号，
+ * 只修改本机器的状态并使用本机器的随机数子流，附加-work次循环的计算量。加工时间超过阈值时，
+ * 机器在半个时间单位后调度一个未设置冲突键的报告事件，报告事件串行执行，按照执行顺序累计校验和，
+ * 用于检查并行执行时推迟提交的事件调度顺序与串行执行相同。
+ * 程序先串行运行作为基准，再以2、4……直到-threads个线程并行执行同时事件，
+ * 输出墙钟时间、事件处理速率、加速比，并检查各机器的统计结果和校验和与串行执行完全一致。
+ * 用法：SimultaneousEvents [-machines 机器数量] [-steps 时间步数] [-work 计算量] [-threads 最多线程数量] [-json 文件]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "Simulator.h"
+#include "RandomStreams.h"
+#include "ThreadPool.h"
+#include "Benchmark.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//机器数量和时间步数
+int Machines = 64;
+int Steps = 200;
+//每个加工事件附加的计算量
+long Work = 20000;
+//调度报告事件的加工时间阈值
+const double ReportThreshold = 2.0;
+
+//机器状态
+struct Machine{
+	Random * random = NULL;
+	long jobs = 0;
+	double busy = 0;
+	double work = 0;
+};
+
+//全部机器，下标为机器序号
+vector<Machine> Plant;
+//报告事件按照执行顺序累计的校验和
+uint64_t Checksum = 0;
+
+//报告事件：串行执行，校验和与执行顺序有关
+class ReportEvent:public EventNotice{
+private:
+	int machine;
+public:
+	ReportEvent(double time,int machine):EventNotice(time),machine(machine){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		Checksum = Checksum * 1000003 + machine + 1;
+	};
+};
+
+//加工事件：冲突键为机器序号，不同机器的加工事件可以并行执行
+class WorkEvent:public EventNotice{
+private:
+	int machine;
+public:
+	WorkEvent(double time,int machine):EventNotice(time),machine(machine){
+		setConflictKey(machine);
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		Machine & m = Plant[machine];
+		double x = 0;
+		for(long i = 0;i < Work;i ++){
+			x += sqrt((double)i + m.busy);
+		}
+		double service = m.random->nextExponential(1.0);
+		m.jobs ++;
+		m.busy += service;
+		m.work += x;
+		double now = pSimulator->getClock();
+		if(service > ReportThreshold){
+			pSimulator->scheduleEvent(new ReportEvent(now + 0.5,machine));
+		}
+		pSimulator->scheduleEvent(new WorkEvent(now + 1,machine));
+	};
+};
+
+//运行一次仿真，返回事件数量
+uint64_t runModel(unsigned threads,unsigned long seed){
+	RandomStreams streams(seed);
+	Plant.assign(Machines,Machine());
+	Checksum = 0;
+	char name[32];
+	Simulator * pSimulator = new Simulator(seed,NULL);
+	pSimulator->setSimultaneousThreads(threads);
+	for(int i = 0;i < Machines;i ++){
+		snprintf(name,sizeof(name),"machine %d",i);
+		Plant[i].random = streams.get(name);
+		pSimulator->scheduleEvent(new WorkEvent(1,i));
+	}
+	//结束时间与加工事件和报告事件的时间都不相同
+	pSimulator->run(Steps + 0.75,true);
+	uint64_t events = pSimulator->getEventCount();
+	delete pSimulator;
+	return events;
+}
+
+void usage(){
+	printf("用法：SimultaneousEvents [-machines 机器数量] [-steps 时间步数] [-work 计算量] [-threads 最多线程数量] [-json 文件]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	const char * jsonFileName = NULL;
+	unsigned maxThreads = ThreadPool::hardwareThreads();
+	unsigned long seed = 12345678;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-machines") == 0 && i + 1 < argc){
+			Machines = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-steps") == 0 && i + 1 < argc){
+			Steps = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-work") == 0 && i + 1 < argc){
+			Work = atol(argv[++ i]);
+		}else if(strcmp(argv[i],"-threads") == 0 && i + 1 < argc){
+			maxThreads = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-json") == 0 && i + 1 < argc){
+			jsonFileName = argv[++ i];
+		}else{
+			usage();
+		}
+	}
+	if(Machines < 1 || Steps < 1 || Work < 0 || maxThreads < 1){
+		usage();
+	}
+	JsonReport report("SimultaneousEvents");
+	printf("%-8s %10s %12s %14s %10s %8s\n","THREADS","SECONDS","EVENTS","EVENTS/S","SPEEDUP","RESULT");
+
+	//串行执行基准
+	Stopwatch watch;
+	uint64_t serialEvents = runModel(0,seed);
+	double serialSeconds = watch.seconds();
+	vector<Machine> serialPlant = Plant;
+	uint64_t serialChecksum = Checksum;
+	printf("%-8d %10.4f %12llu %14.0f %10.2f %8s\n",1,serialSeconds,(unsigned long long)serialEvents,
+			serialEvents / serialSeconds,1.0,"-");
+	report.add({{"threads","1"}},{{"seconds",serialSeconds},{"events",(double)serialEvents},
+			{"events_per_second",serialEvents / serialSeconds},{"speedup",1.0}});
+
+	//线程数量按照2、4……加倍，最后一次为最多线程数量
+	for(unsigned threads = 2;maxThreads > 1;threads *= 2){
+		threads = threads > maxThreads ? maxThreads : threads;
+		watch.reset();
+		uint64_t events = runModel(threads,seed);
+		double seconds = watch.seconds();
+		bool same = events == serialEvents && Checksum == serialChecksum;
+		for(int i = 0;i < Machines && same;i ++){
+			same = Plant[i].jobs == serialPlant[i].jobs && Plant[i].busy == serialPlant[i].busy
+					&& Plant[i].work == serialPlant[i].work;
+		}
+		printf("%-8u %10.4f %12llu %14.0f %10.2f %8s\n",threads,seconds,(unsigned long long)events,
+				events / seconds,serialSeconds / seconds,same ? "一致" : "不一致");
+		report.add({{"threads",to_string(threads)}},{{"seconds",seconds},{"events",(double)events},
+				{"events_per_second",events / seconds},{"speedup",serialSeconds / seconds},{"identical",same ? 1.0 : 0.0}});
+		if(threads >= maxThreads){
+			break;
+		}
+	}
+	printf("机器数量：%d，时间步数：%d，事件计算量：%ld，报告事件校验和：%llu\n",
+			Machines,Steps,Work,(unsigned long long)serialChecksum);
+	if(jsonFileName != NULL){
+		report.write(jsonFileName);
+	}
+	return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file MM1Overflow.cpp
+ * @brief M/M/1排队系统溢出概率的重要性分裂（RESTART）仿真模型
+ * 经典的稀有事件问题：忙期从一个顾客开始，估计队长（包括正在服务的顾客）在系统变空之前达到-B的概率。
+ * 到达率为1，服务率为1/ρ，该概率的精确值为(r-1)/(r^B-1)，r=1/ρ。
+ * 重要性函数为队长，在2到B-1的每个整数设置阈值，越过阈值时分裂为-split条轨迹（SplittingEngine），
+ * 仿真状态通过Checkpoint在内存中复制。普通蒙特卡洛方法连续仿真同一模型，每个忙期为一次试验，共-crude次，
+ * 按照每次试验的事件数量和墙钟时间计算相对于普通蒙特卡洛方法的加速比（方差与计算量乘积之比）。
+ * 用法：MM1Overflow [-B 溢出队长] [-rho 服务强度] [-trials 分裂主试验次数] [-split 分裂数量]
+ *                   [-crude 普通试验次数] [-seed 种子]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <chrono>
+#include "Simulator.h"
+#include "EventCodec.h"
+#include "Checkpoint.h"
+#include "SplittingEngine.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//平均到达间隔和平均服务时间
+double MeanInterArrivalTime = 1.0;
+double MeanServiceTime = 0.5;
+
+//队长（包括正在服务的顾客）和溢出队长
+long QueueLength = 0;
+long Overflow = 20;
+
+//普通蒙特卡洛方法连续仿真，统计忙期数量和溢出的忙期数量，达到CrudeCycles个忙期时结束
+bool Continuous = false;
+long Cycles = 0, Overflows = 0, CrudeCycles = 0;
+bool Overflowed = false;
+
+//随机变量生成器
+Random * stream;
+
+//到达事件
+class ArrivalEvent:public EventNotice{
+public:
+	ArrivalEvent(double time):EventNotice(time){
+		setName("到达");
+	}
+
+	virtual void trigger(Simulator * pSimulator);
+
+	void encode(string & bytes){
+	}
+
+	static EventNotice * decode(double time,const char * bytes,size_t size){
+		return new ArrivalEvent(time);
+	}
+};
+
+//服务完成事件，系统变空时忙期结束：分裂的主试验终止，连续仿真时进入空闲期
+class DepartureEvent:public EventNotice{
+public:
+	DepartureEvent(double time):EventNotice(time){
+		setName("离开");
+	}
+
+	virtual void trigger(Simulator * pSimulator){
+		QueueLength --;
+		if(QueueLength == 0){
+			if(Continuous){
+				Cycles ++;
+				Overflowed = false;
+				if(Cycles >= CrudeCycles){
+					pSimulator->stop();
+				}
+				return;
+			}
+			pSimulator->stop();
+			return;
+		}
+		pSimulator->scheduleEvent(new DepartureEvent(pSimulator->getClock() + stream->nextExponential() * MeanServiceTime));
+	}
+
+	void encode(string & bytes){
+	}
+
+	static EventNotice * decode(double time,const char * bytes,size_t size){
+		return new DepartureEvent(time);
+	}
+};
+
+void ArrivalEvent::trigger(Simulator * pSimulator){
+	QueueLength ++;
+	if(Continuous){
+		//空闲期结束，新忙期开始
+		if(QueueLength == 1){
+			pSimulator->scheduleEvent(new DepartureEvent(pSimulator->getClock() + stream->nextExponential() * MeanServiceTime));
+		}
+		if(QueueLength >= Overflow && !Overflowed){
+			Overflowed = true;
+			Overflows ++;
+		}
+	}
+	pSimulator->scheduleEvent(new ArrivalEvent(pSimulator->getClock() + stream->nextExponential() * MeanInterArrivalTime));
+}
+
+//忙期开始：第一个顾客刚刚到达并开始服务
+void Initialization(Simulator * pSimulator){
+	QueueLength = 1;
+	pSimulator->scheduleEvent(new ArrivalEvent(stream->nextExponential() * MeanInterArrivalTime));
+	pSimulator->scheduleEvent(new DepartureEvent(stream->nextExponential() * MeanServiceTime));
+}
+
+void usage(){
+	printf("用法：MM1Overflow [-B 溢出队长] [-rho 服务强度] [-trials 分裂主试验次数] [-split 分裂数量]\n"
+			"                  [-crude 普通试验次数] [-seed 种子]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	int B = 20;
+	double rho = 0.5;
+	int trials = 10000;
+	int split = 2;
+	int crude = 200000;
+	unsigned long seed = 12345678;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-B") == 0 && i + 1 < argc){
+			B = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-rho") == 0 && i + 1 < argc){
+			rho = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-trials") == 0 && i + 1 < argc){
+			trials = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-split") == 0 && i + 1 < argc){
+			split = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-crude") == 0 && i + 1 < argc){
+			crude = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-seed") == 0 && i + 1 < argc){
+			seed = strtoul(argv[++ i],NULL,10);
+		}else{
+			usage();
+		}
+	}
+	if(B < 2 || rho <= 0 || rho == 1 || trials < 2 || split < 1 || crude < 2){
+		usage();
+	}
+	MeanServiceTime = rho * MeanInterArrivalTime;
+	Overflow = B;
+	double r = 1 / rho;
+	double exact = (r - 1) / (pow(r,B) - 1);
+
+	stream = new Random(seed);
+	Simulator * pSimulator = new Simulator(seed,NULL);
+	Checkpoint checkpoint;
+	EventCodec::add<ArrivalEvent>("ArrivalEvent");
+	EventCodec::add<DepartureEvent>("DepartureEvent");
+	checkpoint.addRandom(stream);
+	checkpoint.addState([](CheckpointWriter & writer){
+		writer.put(QueueLength);
+	},[](CheckpointReader & reader){
+		reader.get(QueueLength);
+	});
+	SplittingEngine::ImportanceFunction importance = [](Simulator * pSimulator){
+		return (double)QueueLength;
+	};
+	SplittingEngine splitting(pSimulator,&checkpoint,importance,B,seed);
+	splitting.setInitialization(Initialization);
+	for(int level = 2;level < B;level ++){
+		splitting.addThreshold(level,split);
+	}
+	splitting.run(trials);
+	printf("M/M/1忙期溢出概率：服务强度%g，溢出队长%d，精确值%g\n",rho,B,exact);
+	printf("重要性分裂（RESTART），每个阈值分裂为%d条轨迹：\n",split);
+	splitting.report();
+
+	//普通蒙特卡洛方法不复制仿真状态
+	Simulator * pCrude = new Simulator(seed + 1,NULL);
+	stream->getEngine()->seed(seed + 1);
+	Continuous = true;
+	CrudeCycles = crude;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	Initialization(pCrude);
+	pCrude->run();
+	double crudeTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	printf("普通蒙特卡洛%ld个忙期：概率估计：%g，溢出的忙期数量：%ld，事件数量：%llu，墙钟时间：%g秒\n",
+			Cycles,(double)Overflows / Cycles,Overflows,(unsigned long long)pCrude->getEventCount(),crudeTime);
+
+	//普通蒙特卡洛每次试验的方差为p(1-p)，加速比为相同精度下两种方法的计算量之比
+	double estimate = splitting.getEstimate();
+	double variance = splitting.getVariance();
+	double crudeVariance = exact * (1 - exact);
+	double eventsPerTrial = (double)splitting.getEventCount() / trials;
+	double crudeEventsPerTrial = (double)pCrude->getEventCount() / Cycles;
+	double secondsPerTrial = splitting.getWallTime() / trials;
+	double crudeSecondsPerTrial = crudeTime / Cycles;
+	printf("分裂估计与精确值的相对偏差：%g，精确值%s95%%置信区间内\n",(estimate - exact) / exact,
+			fabs(estimate - exact) <= splitting.getConfidence() ? "在" : "不在");
+	if(variance > 0){
+		printf("达到相同相对误差需要的普通蒙特卡洛试验次数：%g\n",crudeVariance / variance * trials);
+		printf("加速比（按事件数量）：%g，加速比（按墙钟时间）：%g\n",
+				crudeVariance * crudeEventsPerTrial / (variance * eventsPerTrial),
+				secondsPerTrial > 0 ? crudeVariance * crudeSecondsPerTrial / (variance * secondsPerTrial) : 0);
+	}
+	return 0;
+}
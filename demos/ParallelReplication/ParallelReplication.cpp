@@ -0,0 +1,346 @@
+/**
+ * @file ParallelReplication.cpp
+ * @brief 单通道排队系统并行重复仿真实验模型
+ * 与QueueReplication相同的单通道排队系统，模型状态和统计对象保存在每次重复仿真
+ * 独立的QueueModel对象中，由ReplicationRunner在多个线程中并行运行独立重复仿真，
+ * 输出顾客响应时间、平均队长和服务台利用率在重复仿真间的均值和置信区间。
+ * 指定-halfwidth或-relative时按批运行重复仿真，直到-metric指定性能指标（缺省为RESPONSE TIME）
+ * 的95%置信区间半长达到绝对或相对精度要求，-reps为最少重复次数，-max为最多重复次数。
+ * 指定-sweep时由Experiment对平均到达间隔（10~14）和平均服务时间（8~9.5）进行参数扫描，
+ * factorial为各3个水平的全因子设计，lhs为-points个设计点的拉丁超立方设计，每个设计点
+ * 重复-reps次，-out指定结果文件名前缀，输出作业结果表和设计点汇总表的CSV文件及二进制文件。
+ * 到达间隔和服务时间分别使用RandomStreams的命名子流。指定-antithetic时重复仿真组成对偶对，
+ * 输出对偶方法相对独立重复仿真的方差缩减；指定-compare时使用公共随机数比较缺省平均服务时间
+ * 与指定平均服务时间两种配置，输出配对差值及其相对独立抽样的方差缩减；-crn使参数扫描的
+ * 各设计点使用公共随机数。
+ * 指定-select时对全因子设计的9个配置使用KN方法选择-metric均值最小的配置，参数为无差别区间，
+ * -reps为第一阶段重复次数，-max为每个配置最多重复次数。
+ * 用法：ParallelReplication [-reps 重复次数] [-threads 线程数量] [-seed 种子] [-csv 文件]
+ *                           [-metric 性能指标] [-halfwidth 绝对半长 | -relative 相对半长] [-max 最多重复次数]
+ *                           [-sweep factorial|lhs] [-points 设计点数量] [-out 结果文件名前缀] [-crn]
+ *                           [-antithetic] [-compare 平均服务时间] [-select 无差别区间]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include "Queue.h"
+#include "DataCollection.h"
+#include "Simulator.h"
+#include "RandomStreams.h"
+#include "Replication.h"
+#include "Experiment.h"
+#include "Selection.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//缺省的顾客平均到达间隔、平均服务时间和服务时间标准差
+const double MeanInterArrivalTime = 10;
+const double MeanServiceTime = 9.5;
+const double SIGMA = 1.75;
+//预热时间和仿真结束时间
+const double T0 = 2000;
+const double TE = 15000;
+
+//一次重复仿真的模型状态
+struct QueueModel{
+	//平均到达间隔和平均服务时间
+	double meanInterArrivalTime = MeanInterArrivalTime;
+	double meanServiceTime = MeanServiceTime;
+	//排队顾客的到达时间
+	Queue<double> arrivals;
+	//服务台是否忙
+	bool busy = false;
+	//正在服务顾客的到达时间
+	double inService = 0;
+	//到达间隔和服务时间的随机数子流
+	Random * arrivalStream = NULL;
+	Random * serviceStream = NULL;
+	Tally responseTally{"RESPONSE TIME"};
+	Accumulate queueLengthAccum{"QUEUE LENGTH"};
+	Accumulate busyAccum{"SERVER UTILIZATION"};
+};
+
+void startService(QueueModel * model,Simulator * pSimulator);
+
+//顾客到达事件
+class ArrivalEvent:public EventNotice{
+private:
+	QueueModel * model;
+public:
+	ArrivalEvent(double time,QueueModel * model):EventNotice(time),model(model){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		double now = pSimulator->getClock();
+		model->arrivals.enqueue(now);
+		model->queueLengthAccum.update(model->arrivals.getCount(),now);
+		double interval = model->arrivalStream->nextExponential() * model->meanInterArrivalTime;
+		pSimulator->scheduleEvent(new ArrivalEvent(now + interval,model));
+		if(!model->busy){
+			startService(model,pSimulator);
+		}
+	};
+};
+
+//服务完成事件
+class DepartureEvent:public EventNotice{
+private:
+	QueueModel * model;
+public:
+	DepartureEvent(double time,QueueModel * model):EventNotice(time),model(model){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		double now = pSimulator->getClock();
+		model->responseTally.update(now - model->inService,now);
+		model->busy = false;
+		model->busyAccum.update(0,now);
+		if(model->arrivals.getCount() > 0){
+			startService(model,pSimulator);
+		}
+	};
+};
+
+//预热结束事件，重新开始统计
+class WarmupEvent:public EventNotice{
+private:
+	QueueModel * model;
+public:
+	WarmupEvent(double time,QueueModel * model):EventNotice(time),model(model){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		model->responseTally.reset(pSimulator->getClock());
+		model->queueLengthAccum.reset(pSimulator->getClock());
+		model->busyAccum.reset(pSimulator->getClock());
+	};
+};
+
+//仿真结束事件
+class EndEvent:public EventNotice{
+public:
+	EndEvent(double time):EventNotice(time){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		pSimulator->stop();
+	};
+};
+
+//队首顾客开始服务
+void startService(QueueModel * model,Simulator * pSimulator){
+	double now = pSimulator->getClock();
+	double serviceTime;
+	while((serviceTime = model->serviceStream->nextNormal(model->meanServiceTime,SIGMA)) < 0);
+	model->inService = model->arrivals.dequeue();
+	model->busy = true;
+	model->busyAccum.update(1,now);
+	model->queueLengthAccum.update(model->arrivals.getCount(),now);
+	pSimulator->scheduleEvent(new DepartureEvent(now + serviceTime,model));
+}
+
+//运行一次仿真并记录性能指标
+void runQueueModel(QueueModel & model,Replication * replication){
+	Simulator * pSimulator = new Simulator(replication->getSeed(),NULL);
+	//到达和服务使用独立的命名子流，比较不同配置时两个随机来源分别同步
+	RandomStreams streams(replication->getSeed(),replication->isAntithetic());
+	model.arrivalStream = streams.get("arrivals");
+	model.serviceStream = streams.get("service");
+	model.busyAccum.update(0,0);
+	model.queueLengthAccum.update(0,0);
+	pSimulator->scheduleEvent(new ArrivalEvent(model.arrivalStream->nextExponential() * model.meanInterArrivalTime,&model));
+	pSimulator->scheduleEvent(new WarmupEvent(T0,&model));
+	pSimulator->scheduleEvent(new EndEvent(TE));
+	pSimulator->run();
+	//结束时刻更新一次时间积分统计，计入最后一段时间
+	model.queueLengthAccum.update(model.arrivals.getCount(),pSimulator->getClock());
+	model.busyAccum.update(model.busy ? 1 : 0,pSimulator->getClock());
+	replication->record(&model.responseTally);
+	replication->record(&model.queueLengthAccum);
+	replication->record(&model.busyAccum);
+	delete pSimulator;
+}
+
+//模型工厂函数：按照缺省参数运行一次重复仿真
+void runReplication(Replication * replication){
+	QueueModel model;
+	runQueueModel(model,replication);
+}
+
+//比较配置的模型函数：按照指定的平均服务时间运行一次重复仿真
+void runServiceTime(double meanServiceTime,Replication * replication){
+	QueueModel model;
+	model.meanServiceTime = meanServiceTime;
+	runQueueModel(model,replication);
+}
+
+//实验模型函数：按照设计点的参数运行一次重复仿真
+void runDesignPoint(const DesignPoint & point,Replication * replication){
+	QueueModel model;
+	model.meanInterArrivalTime = point.get("INTERARRIVAL");
+	model.meanServiceTime = point.get("SERVICE");
+	runQueueModel(model,replication);
+}
+
+//参数扫描和排序选择的实验因子
+vector<Factor> queueFactors(){
+	vector<Factor> factors;
+	factors.push_back(Factor("INTERARRIVAL",10,14,3));
+	factors.push_back(Factor("SERVICE",8,9.5,3));
+	return factors;
+}
+
+//参数扫描实验
+void runSweep(const char * sweep,int points,int reps,unsigned threads,unsigned long seed,bool crn,const char * outPrefix){
+	vector<Factor> factors = queueFactors();
+	Design design = strcmp(sweep,"lhs") == 0 ? Design::latinHypercube(factors,points,seed)
+			: Design::fullFactorial(factors);
+	Experiment experiment(design,runDesignPoint,seed,threads);
+	experiment.setCommonRandomNumbers(crn);
+	experiment.run(reps);
+	experiment.report();
+	if(outPrefix != NULL){
+		ResultTable results, summary;
+		experiment.getResults(results);
+		experiment.getSummaryTable(summary);
+		string prefix = outPrefix;
+		results.writeCSV((prefix + ".csv").c_str());
+		results.writeBinary((prefix + ".bin").c_str());
+		summary.writeCSV((prefix + "_summary.csv").c_str());
+		summary.writeBinary((prefix + "_summary.bin").c_str());
+	}
+}
+
+//使用公共随机数比较缺省平均服务时间与指定平均服务时间两种配置
+void runCompare(double meanServiceTime,int reps,unsigned threads,unsigned long seed,bool antithetic){
+	using namespace std::placeholders;
+	ReplicationRunner a(bind(runServiceTime,MeanServiceTime,_1),seed,threads);
+	ReplicationRunner b(bind(runServiceTime,meanServiceTime,_1),seed,threads);
+	a.setAntithetic(antithetic);
+	b.setAntithetic(antithetic);
+	a.run(reps);
+	b.run(reps);
+	printf("配置A：平均服务时间%g，配置B：平均服务时间%g\n",MeanServiceTime,meanServiceTime);
+	ReplicationRunner::compare(a,b);
+}
+
+//排序与选择：从全因子设计的各配置中选择性能指标均值最小的配置
+void runSelect(double delta,const char * metric,int reps,int maxReps,unsigned threads,unsigned long seed){
+	Selection selection(Design::fullFactorial(queueFactors()),runDesignPoint,metric,seed,true,threads);
+	selection.select(delta,0.05,reps,maxReps);
+	selection.report();
+}
+
+void usage(){
+	printf("用法：ParallelReplication [-reps 重复次数] [-threads 线程数量] [-seed 种子] [-csv 文件]\n"
+			"                           [-metric 性能指标] [-halfwidth 绝对半长 | -relative 相对半长] [-max 最多重复次数]\n"
+			"                           [-sweep factorial|lhs] [-points 设计点数量] [-out 结果文件名前缀] [-crn]\n"
+			"                           [-antithetic] [-compare 平均服务时间] [-select 无差别区间]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	int reps = 20;
+	unsigned threads = 0;
+	unsigned long seed = 12345678;
+	const char * csvFileName = NULL;
+	const char * metric = "RESPONSE TIME";
+	double halfWidth = 0;
+	bool relative = false;
+	int maxReps = 1000;
+	const char * sweep = NULL;
+	int points = 10;
+	const char * outPrefix = NULL;
+	bool crn = false;
+	bool antithetic = false;
+	double compareServiceTime = 0;
+	double selectDelta = 0;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-reps") == 0 && i + 1 < argc){
+			reps = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-threads") == 0 && i + 1 < argc){
+			threads = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-seed") == 0 && i + 1 < argc){
+			seed = strtoul(argv[++ i],NULL,10);
+		}else if(strcmp(argv[i],"-csv") == 0 && i + 1 < argc){
+			csvFileName = argv[++ i];
+		}else if(strcmp(argv[i],"-metric") == 0 && i + 1 < argc){
+			metric = argv[++ i];
+		}else if(strcmp(argv[i],"-halfwidth") == 0 && i + 1 < argc){
+			halfWidth = atof(argv[++ i]);
+			relative = false;
+		}else if(strcmp(argv[i],"-relative") == 0 && i + 1 < argc){
+			halfWidth = atof(argv[++ i]);
+			relative = true;
+		}else if(strcmp(argv[i],"-max") == 0 && i + 1 < argc){
+			maxReps = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-sweep") == 0 && i + 1 < argc){
+			sweep = argv[++ i];
+		}else if(strcmp(argv[i],"-points") == 0 && i + 1 < argc){
+			points = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-out") == 0 && i + 1 < argc){
+			outPrefix = argv[++ i];
+		}else if(strcmp(argv[i],"-crn") == 0){
+			crn = true;
+		}else if(strcmp(argv[i],"-antithetic") == 0){
+			antithetic = true;
+		}else if(strcmp(argv[i],"-compare") == 0 && i + 1 < argc){
+			compareServiceTime = atof(argv[++ i]);
+			if(compareServiceTime <= 0){
+				usage();
+			}
+		}else if(strcmp(argv[i],"-select") == 0 && i + 1 < argc){
+			selectDelta = atof(argv[++ i]);
+			if(selectDelta <= 0){
+				usage();
+			}
+		}else{
+			usage();
+		}
+	}
+	if(reps < 1){
+		usage();
+	}
+	if(sweep != NULL){
+		if((strcmp(sweep,"factorial") != 0 && strcmp(sweep,"lhs") != 0) || points < 1){
+			usage();
+		}
+		runSweep(sweep,points,reps,threads,seed,crn,outPrefix);
+		return 0;
+	}
+	if(selectDelta > 0){
+		runSelect(selectDelta,metric,reps < 2 ? 2 : reps,maxReps,threads,seed);
+		return 0;
+	}
+	if(compareServiceTime > 0){
+		runCompare(compareServiceTime,reps,threads,seed,antithetic);
+		return 0;
+	}
+
+	ReplicationRunner runner(runReplication,seed,threads);
+	runner.setAntithetic(antithetic);
+	if(halfWidth > 0){
+		bool met = runner.runUntil(metric,halfWidth,relative,0.95,reps,maxReps);
+		printf("%s：%s的置信区间半长%s%g%s\n",met ? "达到精度要求" : "达到最多重复次数",metric,
+				met ? "不大于" : "仍大于",halfWidth,relative ? "（相对均值）" : "");
+	}else{
+		runner.run(reps);
+	}
+	runner.report();
+	if(antithetic){
+		runner.reportVarianceReduction();
+	}
+	if(csvFileName != NULL){
+		runner.exportCSV(csvFileName);
+	}
+	return 0;
+}
@@ -9,10 +9,13 @@
  */
 #include <vector>
 #include <stdio.h>
+#include <string.h>
 #include "Queue.h"
 #include "ProcessNotice.h"
 #include "DataCollection.h"
 #include "Simulator.h"
+#include "EventCodec.h"
+#include "Checkpoint.h"
 
 using namespace std;
 using namespace rubber_duck;
@@ -56,6 +59,14 @@ public:
 		busyAccum.reset(pSimulator->getClock());
 		responseTally.reset(pSimulator->getClock());
 	};
+
+	//检查点编码和解码，没有属性
+	void encode(string & bytes){
+	};
+
+	static EventNotice * decode(double time,const char * bytes,size_t size){
+		return new T0Event(time);
+	};
 };
 
 //TE事件
@@ -67,6 +78,13 @@ public:
 	virtual void trigger(Simulator * pSimulator){
 		pSimulator->stop();
 	};
+
+	void encode(string & bytes){
+	};
+
+	static EventNotice * decode(double time,const char * bytes,size_t size){
+		return new TEEvent(time);
+	};
 };
 
 
@@ -82,6 +100,30 @@ public:
 		sprintf(nameBuffer,"顾客%d",id);
 		setName(nameBuffer);
 	};
+	//从检查点恢复的顾客，不分配新的标识
+	Customer(double time,int id,double arrivalTime,int phase):ProcessNotice(time,phase) {
+		this->arrivalTime = arrivalTime;
+		this->id = id;
+		sprintf(nameBuffer,"顾客%d",id);
+		setName(nameBuffer);
+	};
+
+	//检查点编码：标识、到达时间和复活点
+	void encode(string & bytes){
+		EventCodec::put(bytes,id);
+		EventCodec::put(bytes,arrivalTime);
+		EventCodec::put(bytes,phase);
+	};
+
+	static EventNotice * decode(double time,const char * bytes,size_t size){
+		const char * end = bytes + size;
+		int id, phase;
+		double arrivalTime;
+		EventCodec::get(bytes,end,id);
+		EventCodec::get(bytes,end,arrivalTime);
+		EventCodec::get(bytes,end,phase);
+		return new Customer(time,id,arrivalTime,phase);
+	};
 
 	//获得当前复活点名称
 	virtual const char * getPhaseName(){
@@ -178,6 +220,46 @@ void Initialization(Simulator * pSimulator){
 	pSimulator->scheduleEvent(new TEEvent(TE));
 }
 
+//注册检查点保存的事件类型、随机变量生成器、统计对象和模型状态
+void RegisterCheckpoint(Checkpoint & checkpoint){
+	EventCodec::add<Customer>("Customer");
+	EventCodec::add<T0Event>("T0Event");
+	EventCodec::add<TEEvent>("TEEvent");
+	checkpoint.addRandom(stream);
+	checkpoint.addStatistic(&responseTally);
+	checkpoint.addStatistic(&queueLengthAccum);
+	checkpoint.addStatistic(&busyAccum);
+	checkpoint.addState([](CheckpointWriter & writer){
+		writer.put(QueueLength);
+		writer.put(NumberOfDepartures);
+		writer.put(LongService);
+		writer.put(CustomerID);
+		writer.putEvent(CustomerInService);
+		//排队的顾客都在FEL或CEL中，按照序号保存，轮转一遍后队列顺序不变
+		int count = customers.getCount();
+		writer.put(count);
+		for(int i = 0;i < count;i ++){
+			Customer * customer = customers.dequeue();
+			writer.putEvent(customer);
+			customers.enqueue(customer);
+		}
+	},[](CheckpointReader & reader){
+		reader.get(QueueLength);
+		reader.get(NumberOfDepartures);
+		reader.get(LongService);
+		reader.get(CustomerID);
+		CustomerInService = static_cast<Customer *>(reader.getEvent());
+		while(!customers.empty()){
+			customers.dequeue();
+		}
+		int count;
+		reader.get(count);
+		for(int i = 0;i < count;i ++){
+			customers.enqueue(static_cast<Customer *>(reader.getEvent()));
+		}
+	});
+}
+
 void ReportGeneration(Simulator * pSimulator) {
 	DataCollection::printHeading();
 	responseTally.report();
@@ -190,12 +272,43 @@ int main(int argc, char* argv[]){
 	int runs = 0;
 	int seed = 12345678;
 
+	//检查点文件：-save在T0时刻保存预热后的状态，-restore从保存的状态继续运行，
+	//-branch为恢复后的随机变量生成器指定新种子，从同一检查点得到不同的重复仿真
+	const char * saveFile = NULL;
+	const char * restoreFile = NULL;
+	int branch = -1;
+	//-fork预热到T0后创建指定数量的写时复制分支进程，汇总各分支的统计结果；
+	//-verify每次只运行一个分支进程，并在本进程中从T0时刻的检查点依次重新运行各分支，检查结果一致
+	int forks = 0;
+	bool verify = false;
+
 	FILE* csvFile = NULL;
 	
-	if(argc > 1){
-		runs = atoi(argv[1]);
-		seed = atoi(argv[2]);
-		T0 = atof(argv[3]);
+	int positional = 0;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-save") == 0 && i + 1 < argc){
+			saveFile = argv[++ i];
+		}else if(strcmp(argv[i],"-restore") == 0 && i + 1 < argc){
+			restoreFile = argv[++ i];
+		}else if(strcmp(argv[i],"-branch") == 0 && i + 1 < argc){
+			branch = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-fork") == 0 && i + 1 < argc){
+			forks = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-verify") == 0){
+			verify = true;
+		}else if(positional == 0){
+			runs = atoi(argv[i]);
+			positional ++;
+		}else if(positional == 1){
+			seed = atoi(argv[i]);
+			positional ++;
+		}else if(positional == 2){
+			T0 = atof(argv[i]);
+			positional ++;
+		}else{
+			printf("用法：QueueReplication [runs seed T0] [-save 文件] [-restore 文件 [-branch 分支序号]] [-fork 分支数量 [-verify]]\n");
+			exit(0);
+		}
 	}
 	sprintf(nameBuffer,"replications%f.csv",T0);
 	if(runs == 0){
@@ -216,9 +329,50 @@ int main(int argc, char* argv[]){
 	stream = new Random(seed);
 
 	Simulator * pSimulator = new Simulator(seed,"Queue_PI.txt");
-	Initialization(pSimulator);
+	Checkpoint checkpoint;
+	if(saveFile != NULL || restoreFile != NULL || verify){
+		RegisterCheckpoint(checkpoint);
+	}
+	if(restoreFile != NULL){
+		checkpoint.restore(pSimulator,restoreFile);
+		if(branch >= 0){
+			stream->getEngine()->seed(seed + branch);
+		}
+		printf("从检查点（%s，%zu字节）恢复，仿真时间：%f\n",restoreFile,checkpoint.getSize(),pSimulator->getClock());
+	}else{
+		Initialization(pSimulator);
+		if(saveFile != NULL || forks > 0){
+			//预热到T0事件之前保存或分支，恢复或分支后由T0事件重置统计
+			pSimulator->runUntil(T0);
+		}
+		if(saveFile != NULL){
+			checkpoint.save(pSimulator,saveFile);
+			printf("保存检查点（%s，%zu字节），仿真时间：%f\n",saveFile,checkpoint.getSize(),pSimulator->getClock());
+		}
+	}
 //	pSimulator->setDebug();
-	pSimulator->run();
+	string state;
+	vector<BranchResult> results;
+	if(forks > 0){
+		//分支i与-restore -branch i使用相同的种子，得到相同的结果
+		if(verify){
+			checkpoint.save(pSimulator,state);
+		}
+		vector<DataCollection *> statistics = {&responseTally,&queueLengthAccum,&busyAccum};
+		results = pSimulator->branch(forks,[seed](int index){
+			stream->getEngine()->seed(seed + index);
+		},statistics,-1,verify ? 1 : 0);
+		Tally branchLQ("BRANCH LQ");
+		for(int i = 0;i < forks;i ++){
+			if(results[i].succeeded){
+				printf("分支%d：事件数量：%llu，平均队长：%f\n",i,(unsigned long long)results[i].events,results[i].means[1]);
+				branchLQ.update(results[i].means[1],i);
+			}
+		}
+		printf("%d个分支的平均队长：%f，95%%置信区间半长：%f\n",branchLQ.getObs(),branchLQ.mean(),branchLQ.confidence());
+	}else{
+		pSimulator->run();
+	}
 
 	ReportGeneration(pSimulator);
 
@@ -227,6 +381,25 @@ int main(int argc, char* argv[]){
 		fclose(csvFile);
 	}
 
+	//分支数量超过同时运行的分支进程数量时，以后的分支也必须从T0时刻的统计开始
+	if(verify && forks > 0){
+		int mismatches = 0;
+		for(int i = 0;i < forks;i ++){
+			if(!results[i].succeeded){
+				continue;
+			}
+			checkpoint.restore(pSimulator,state.data(),state.size());
+			stream->getEngine()->seed(seed + i);
+			pSimulator->run();
+			bool same = queueLengthAccum.mean() == results[i].means[1] && pSimulator->getEventCount() == results[i].events;
+			printf("分支%d：分支进程平均队长：%f，顺序重新运行平均队长：%f，%s\n",i,results[i].means[1],
+					queueLengthAccum.mean(),same ? "一致" : "不一致");
+			mismatches += same ? 0 : 1;
+		}
+		printf("分支验证：%s\n",mismatches == 0 ? "全部一致" : "存在不一致");
+		return mismatches == 0 ? 0 : 1;
+	}
+
 	return 0;
 }
 
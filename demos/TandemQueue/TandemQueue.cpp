@@ -0,0 +1,342 @@
+/**
+ * @file TandemQueue.cpp
+ * @brief 串联排队网络的保守并行仿真模型
+ * 顾客按照泊松过程到达第一个服务台，依次经过-stations个单服务台先进先出排队服务台后离开，
+ * 服务时间为最小服务时间加指数分布时间。服务台按照序号连续划分为-lps个逻辑进程，
+ * 在-threads个线程中并行运行，-engine选择空消息保守同步（cmb，ConservativeEngine，缺省）
+ * 或时间窗口同步（window，WindowEngine）。顾客开始服务时服务时间已经确定，
+ * 因此在开始服务时就把顾客到达下一服务台的事件发送给下一服务台，跨逻辑进程通道的
+ * 前瞻量为最小服务时间。每个服务台和顾客源使用由名称确定的随机数子流，
+ * 划分方式和线程数量不影响仿真结果，-sequential在一个Simulator中顺序运行同一模型，
+ * -verify同时运行顺序仿真和并行仿真并比较各服务台的统计结果。
+ * -work指定每个事件附加的计算量（循环次数），用于观察事件粒度对并行加速比的影响。
+ * 用法：TandemQueue [-stations 服务台数量] [-lps 逻辑进程数量] [-threads 线程数量] [-end 结束时间]
+ *                   [-seed 种子] [-work 计算量] [-engine cmb|window] [-sequential | -verify]
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include "Queue.h"
+#include "DataCollection.h"
+#include "Simulator.h"
+#include "RandomStreams.h"
+#include "ConservativeEngine.h"
+#include "WindowEngine.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//顾客平均到达间隔、最小服务时间和平均服务时间
+const double MeanInterArrivalTime = 1.0;
+const double MinServiceTime = 0.2;
+const double MeanServiceTime = 0.8;
+
+//每个事件附加的计算量
+long Work = 0;
+
+//顾客：进入系统的时间和到达当前服务台的时间
+struct Customer{
+	double enter;
+	double arrive;
+};
+
+//服务台
+struct Station{
+	int index;
+	//所属逻辑进程及其序号，顺序仿真时为NULL和0
+	LogicalProcess * lp = NULL;
+	int lpIndex = 0;
+	//服务台所在的仿真引擎
+	Simulator * simulator = NULL;
+	//下一服务台，最后一个服务台为NULL
+	Station * next = NULL;
+	//服务时间随机数子流
+	Random * random = NULL;
+	Queue<Customer> queue;
+	bool busy = false;
+	long served = 0;
+	Tally waitTally{"WAIT"};
+	Tally systemTally{"SYSTEM TIME"};
+	Accumulate busyAccum{"UTILIZATION"};
+};
+
+//附加计算量，模拟较大粒度的事件处理
+void doWork(){
+	volatile double x = 0;
+	for(long i = 0;i < Work;i ++){
+		x += sqrt((double)i);
+	}
+}
+
+void startService(Station * station,double now);
+
+//顾客到达服务台事件
+class ArrivalEvent:public EventNotice{
+private:
+	Station * station;
+	Customer customer;
+public:
+	ArrivalEvent(double time,Station * station,Customer customer)
+			:EventNotice(time),station(station),customer(customer){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		doWork();
+		station->queue.enqueue(customer);
+		if(!station->busy){
+			startService(station,pSimulator->getClock());
+		}
+	};
+};
+
+//服务完成事件
+class DepartureEvent:public EventNotice{
+private:
+	Station * station;
+	Customer customer;
+public:
+	DepartureEvent(double time,Station * station,Customer customer)
+			:EventNotice(time),station(station),customer(customer){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		doWork();
+		double now = pSimulator->getClock();
+		station->served ++;
+		if(station->next == NULL){
+			station->systemTally.update(now - customer.enter,now);
+		}
+		station->busy = false;
+		station->busyAccum.update(0,now);
+		if(station->queue.getCount() > 0){
+			startService(station,now);
+		}
+	};
+};
+
+//顾客源：产生到达第一个服务台的顾客
+class SourceEvent:public EventNotice{
+private:
+	Station * station;
+	Random * random;
+public:
+	SourceEvent(double time,Station * station,Random * random)
+			:EventNotice(time),station(station),random(random){
+	};
+
+	virtual void trigger(Simulator * pSimulator){
+		double now = pSimulator->getClock();
+		pSimulator->scheduleEvent(new ArrivalEvent(now,station,Customer{now,now}));
+		pSimulator->scheduleEvent(new SourceEvent(now + random->nextExponential(MeanInterArrivalTime),station,random));
+	};
+};
+
+//队首顾客开始服务，同时确定到达下一服务台的时间
+void startService(Station * station,double now){
+	Customer customer = station->queue.dequeue();
+	double serviceTime = MinServiceTime + station->random->nextExponential(MeanServiceTime - MinServiceTime);
+	station->busy = true;
+	station->busyAccum.update(1,now);
+	station->waitTally.update(now - customer.arrive,now);
+	station->simulator->scheduleEvent(new DepartureEvent(now + serviceTime,station,customer));
+	Station * next = station->next;
+	if(next == NULL){
+		return;
+	}
+	EventNotice * pArrival = new ArrivalEvent(now + serviceTime,next,Customer{customer.enter,now + serviceTime});
+	if(next->lp == station->lp){
+		station->simulator->scheduleEvent(pArrival);
+	}else{
+		station->lp->send(next->lp,pArrival);
+	}
+}
+
+//串联排队网络模型
+struct TandemModel{
+	vector<Station *> stations;
+	RandomStreams * streams;
+
+	TandemModel(int count,unsigned long seed){
+		streams = new RandomStreams(seed);
+		char name[32];
+		for(int i = 0;i < count;i ++){
+			Station * station = new Station();
+			station->index = i;
+			snprintf(name,sizeof(name),"station %d",i);
+			station->random = streams->get(name);
+			station->busyAccum.update(0,0);
+			stations.push_back(station);
+		}
+		for(int i = 0;i + 1 < count;i ++){
+			stations[i]->next = stations[i + 1];
+		}
+	}
+
+	~TandemModel(){
+		for(size_t i = 0;i < stations.size();i ++){
+			delete stations[i];
+		}
+		delete streams;
+	}
+
+	//调度第一个顾客到达
+	void start(){
+		Random * source = streams->get("source");
+		stations[0]->simulator->scheduleEvent(new SourceEvent(source->nextExponential(MeanInterArrivalTime),stations[0],source));
+	}
+
+	//结束时刻更新时间积分统计
+	void finish(double endTime){
+		for(size_t i = 0;i < stations.size();i ++){
+			stations[i]->busyAccum.update(stations[i]->busy ? 1 : 0,endTime);
+		}
+	}
+
+	void report(){
+		string t(120,'-');
+		printf("%s\n",t.c_str());
+		printf("%-10s%-8s%-16s%-16s%-16s\n","STATION","LP","SERVED","MEAN WAIT","UTILIZATION");
+		printf("%s\n",t.c_str());
+		for(size_t i = 0;i < stations.size();i ++){
+			Station * station = stations[i];
+			printf("%-10d%-8d%-16ld%-16g%-16g\n",station->index,station->lpIndex,
+					station->served,station->waitTally.mean(),station->busyAccum.mean());
+		}
+		printf("%s\n",t.c_str());
+		Station * last = stations.back();
+		printf("离开系统的顾客数量：%ld，平均逗留时间：%g\n",last->served,last->systemTally.mean());
+	}
+};
+
+//在一个Simulator中顺序运行
+void runSequential(TandemModel & model,double endTime,unsigned long seed){
+	Simulator * pSimulator = new Simulator(seed,NULL);
+	for(size_t i = 0;i < model.stations.size();i ++){
+		model.stations[i]->simulator = pSimulator;
+	}
+	model.start();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	//与并行仿真相同，执行时间不大于结束时间的事件
+	pSimulator->runUntil(nextafter(endTime,DBL_MAX));
+	double wallTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	model.finish(endTime);
+	printf("顺序仿真：事件数量：%llu，墙钟时间：%g秒，事件处理速率：%g事件/秒\n",
+			(unsigned long long)pSimulator->getEventCount(),wallTime,pSimulator->getEventCount() / wallTime);
+	delete pSimulator;
+}
+
+//服务台按照序号连续划分为逻辑进程，并行运行
+void runParallel(TandemModel & model,ParallelEngine & engine,int lps,unsigned threads,double endTime,unsigned long seed){
+	int count = (int)model.stations.size();
+	char name[32];
+	for(int p = 0;p < lps;p ++){
+		snprintf(name,sizeof(name),"stations %d-%d",p * count / lps,(p + 1) * count / lps - 1);
+		engine.addLogicalProcess(name,seed + p);
+	}
+	for(int p = 0;p + 1 < lps;p ++){
+		engine.connect(engine.getLogicalProcess(p),engine.getLogicalProcess(p + 1),MinServiceTime);
+	}
+	for(int p = 0;p < lps;p ++){
+		LogicalProcess * lp = engine.getLogicalProcess(p);
+		for(int i = p * count / lps;i < (p + 1) * count / lps;i ++){
+			model.stations[i]->lp = lp;
+			model.stations[i]->lpIndex = p;
+			model.stations[i]->simulator = lp->getSimulator();
+		}
+	}
+	model.start();
+	engine.run(endTime,threads);
+	model.finish(endTime);
+	engine.report();
+}
+
+//比较两次仿真各服务台的统计结果
+bool sameResults(TandemModel & a,TandemModel & b){
+	for(size_t i = 0;i < a.stations.size();i ++){
+		Station * x = a.stations[i];
+		Station * y = b.stations[i];
+		if(x->served != y->served || x->waitTally.mean() != y->waitTally.mean()
+				|| x->busyAccum.mean() != y->busyAccum.mean() || x->systemTally.mean() != y->systemTally.mean()){
+			return false;
+		}
+	}
+	return true;
+}
+
+void usage(){
+	printf("用法：TandemQueue [-stations 服务台数量] [-lps 逻辑进程数量] [-threads 线程数量] [-end 结束时间]\n"
+			"                  [-seed 种子] [-work 计算量] [-engine cmb|window] [-sequential | -verify]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	int stations = 8;
+	int lps = 4;
+	unsigned threads = 0;
+	double endTime = 20000;
+	unsigned long seed = 12345678;
+	bool sequential = false;
+	bool verify = false;
+	bool window = false;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-stations") == 0 && i + 1 < argc){
+			stations = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-lps") == 0 && i + 1 < argc){
+			lps = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-threads") == 0 && i + 1 < argc){
+			threads = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-end") == 0 && i + 1 < argc){
+			endTime = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-seed") == 0 && i + 1 < argc){
+			seed = strtoul(argv[++ i],NULL,10);
+		}else if(strcmp(argv[i],"-work") == 0 && i + 1 < argc){
+			Work = atol(argv[++ i]);
+		}else if(strcmp(argv[i],"-engine") == 0 && i + 1 < argc){
+			i ++;
+			if(strcmp(argv[i],"window") == 0){
+				window = true;
+			}else if(strcmp(argv[i],"cmb") != 0){
+				usage();
+			}
+		}else if(strcmp(argv[i],"-sequential") == 0){
+			sequential = true;
+		}else if(strcmp(argv[i],"-verify") == 0){
+			verify = true;
+		}else{
+			usage();
+		}
+	}
+	if(stations < 1 || lps < 1 || lps > stations || endTime <= 0){
+		usage();
+	}
+	if(sequential){
+		TandemModel model(stations,seed);
+		runSequential(model,endTime,seed);
+		model.report();
+		return 0;
+	}
+	TandemModel model(stations,seed);
+	if(window){
+		WindowEngine engine;
+		runParallel(model,engine,lps,threads,endTime,seed);
+	}else{
+		ConservativeEngine engine;
+		runParallel(model,engine,lps,threads,endTime,seed);
+	}
+	model.report();
+	if(verify){
+		TandemModel reference(stations,seed);
+		runSequential(reference,endTime,seed);
+		printf("%s\n",sameResults(model,reference) ? "并行仿真与顺序仿真结果一致" : "错误：并行仿真与顺序仿真结果不一致");
+	}
+	return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file BinaryTrace.cpp
+ * @brief 紧凑二进制事件跟踪记录类BinaryTrace实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <atomic>
+#include "platdefs.h"
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+#include "Simulator.h"
+#include "BinaryTrace.h"
+
+using namespace rubber_duck;
+
+//初始记录容量
+#define INITIAL_RECORDS 65536
+
+//将名称表追加到buffer
+static void appendTable(std::string & buffer,const std::vector<std::string> & table){
+	uint32_t count = (uint32_t)table.size();
+	buffer.append((const char *)&count,sizeof(count));
+	for(size_t i = 0;i < table.size();i ++){
+		uint32_t len = (uint32_t)table[i].size();
+		buffer.append((const char *)&len,sizeof(len));
+		buffer.append(table[i]);
+	}
+}
+
+//跟踪对象序号，从1开始，事件对象中缓存的名称标识为0表示未缓存
+static std::atomic<uint32_t> TraceSerial(0);
+
+BinaryTrace::BinaryTrace(const char * fileName){
+	this->fileName = fileName;
+	serial = (uint64_t)(TraceSerial.fetch_add(1) + 1) << 32;
+#ifdef _WIN32
+	file = fopen(fileName,"wb+");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	TraceFileHeader header;
+	memset(&header,0,sizeof(header));
+	fwrite(&header,sizeof(header),1,file);
+	buffer.reserve(INITIAL_RECORDS);
+	recordCapacity = INITIAL_RECORDS;
+#else
+	fd = open(fileName,O_RDWR | O_CREAT | O_TRUNC,0644);
+	if(fd < 0){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	grow();
+#endif
+}
+
+BinaryTrace::~BinaryTrace(){
+	close();
+}
+
+void BinaryTrace::grow(){
+#ifdef _WIN32
+	//缓冲区满时写入文件
+	fwrite(buffer.data(),sizeof(TraceRecord),buffer.size(),file);
+	buffer.clear();
+#else
+	uint64_t capacity = recordCapacity == 0 ? INITIAL_RECORDS : recordCapacity * 2;
+	size_t size = sizeof(TraceFileHeader) + capacity * sizeof(TraceRecord);
+	if(mapped != NULL){
+		munmap(mapped,mappedSize);
+		mapped = NULL;
+	}
+	//名称表可能已经写在记录之后，文件只扩大不缩小
+	struct stat st;
+	if(fstat(fd,&st) != 0 || (size_t)st.st_size < size){
+		if(ftruncate(fd,size) != 0){
+			printf("错误：扩展跟踪文件失败（%s）\n",fileName.c_str());
+			exit(0);
+		}
+	}
+	void * p = mmap(NULL,size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+	if(p == MAP_FAILED){
+		printf("错误：映射跟踪文件失败（%s）\n",fileName.c_str());
+		exit(0);
+	}
+	mapped = (char *)p;
+	mappedSize = size;
+	recordCapacity = capacity;
+#endif
+}
+
+uint32_t BinaryTrace::internType(EventNotice * pEvent){
+	//设置了类型标识的事件按照类型标识直接索引
+	int typeId = pEvent->getTypeId();
+	if(typeId >= 0 && typeId < (int)typeIdMap.size() && typeIdMap[typeId] >= 0){
+		return (uint32_t)typeIdMap[typeId];
+	}
+	const std::type_info * type = &typeid(*pEvent);
+	uint32_t id;
+	if(type == lastType){
+		id = lastTypeId;
+	}else{
+		size_t i = 0;
+		while(i < typeCache.size() && typeCache[i].type != type){
+			i ++;
+		}
+		if(i == typeCache.size()){
+			TypeCacheEntry entry;
+			entry.type = type;
+			entry.id = (uint32_t)typeNames.size();
+			typeNames.push_back(getEventClassName(pEvent));
+			typeCache.push_back(entry);
+		}
+		id = typeCache[i].id;
+		lastType = type;
+		lastTypeId = id;
+	}
+	if(typeId >= 0){
+		if(typeId >= (int)typeIdMap.size()){
+			typeIdMap.resize(typeId + 1,-1);
+		}
+		typeIdMap[typeId] = (int32_t)id;
+	}
+	return id;
+}
+
+uint32_t BinaryTrace::internName(EventNotice * pEvent){
+	//事件对象缓存本跟踪对象的名称标识，事件对象创建或改名时清除，只在第一次记录时查找名称表
+	uint64_t cached = pEvent->getTraceName();
+	if((cached & 0xFFFFFFFF00000000ULL) == serial){
+		return (uint32_t)cached;
+	}
+	const char * name = pEvent->getName();
+	std::unordered_map<std::string,uint32_t>::iterator it = nameIds.find(name);
+	uint32_t id;
+	if(it != nameIds.end()){
+		id = it->second;
+	}else{
+		id = (uint32_t)names.size();
+		names.push_back(name);
+		nameIds[names.back()] = id;
+	}
+	pEvent->setTraceName(serial | id);
+	return id;
+}
+
+void BinaryTrace::record(Simulator * pSimulator,EventNotice * pEvent,uint32_t op){
+#ifdef _WIN32
+	if(buffer.size() == recordCapacity){
+		grow();
+	}
+	buffer.push_back(TraceRecord());
+	TraceRecord * r = &buffer.back();
+#else
+	if(recordCount == recordCapacity){
+		grow();
+	}
+	TraceRecord * r = (TraceRecord *)(mapped + sizeof(TraceFileHeader)) + recordCount;
+#endif
+	r->clock = pSimulator->getClock();
+	r->eventTime = pEvent->getTime();
+	r->objectId = (uint64_t)(uintptr_t)pEvent;
+	r->typeId = internType(pEvent);
+	r->nameId = internName(pEvent);
+	r->op = op;
+	r->reserved = 0;
+	recordCount ++;
+}
+
+void BinaryTrace::eventScheduled(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	record(pSimulator,pEvent,conditional ? TRACE_SCHEDULE_CEL : TRACE_SCHEDULE_FEL);
+}
+
+void BinaryTrace::eventCancelled(Simulator * pSimulator,EventNotice * pEvent){
+	record(pSimulator,pEvent,TRACE_CANCEL);
+}
+
+void BinaryTrace::eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	record(pSimulator,pEvent,conditional ? TRACE_TRIGGER_CEL : TRACE_TRIGGER_FEL);
+}
+
+void BinaryTrace::runFinished(Simulator * pSimulator){
+	//模型通常不删除Simulator，每次运行结束时写入名称表和文件头，保证跟踪文件完整
+	std::string tables;
+	TraceFileHeader header;
+	uint64_t offset = sizeof(TraceFileHeader) + recordCount * sizeof(TraceRecord);
+	appendTable(tables,typeNames);
+	uint64_t nameOffset = offset + tables.size();
+	appendTable(tables,names);
+	tablesSize = tables.size();
+
+	memcpy(header.magic,TRACE_MAGIC,8);
+	header.version = 1;
+	header.recordSize = sizeof(TraceRecord);
+	header.recordCount = recordCount;
+	header.typeTableOffset = offset;
+	header.nameTableOffset = nameOffset;
+#ifdef _WIN32
+	if(file == NULL){
+		return;
+	}
+	fwrite(buffer.data(),sizeof(TraceRecord),buffer.size(),file);
+	buffer.clear();
+	fwrite(tables.data(),1,tables.size(),file);
+	fseek(file,0,SEEK_SET);
+	fwrite(&header,sizeof(header),1,file);
+	fflush(file);
+	//后续记录覆盖名称表
+	fseek(file,(long)offset,SEEK_SET);
+#else
+	if(fd < 0){
+		return;
+	}
+	if(pwrite(fd,tables.data(),tables.size(),(off_t)offset) != (ssize_t)tables.size()){
+		printf("错误：写入跟踪文件失败（%s）\n",fileName.c_str());
+	}
+	memcpy(mapped,&header,sizeof(header));
+#endif
+}
+
+void BinaryTrace::close(){
+#ifdef _WIN32
+	if(file == NULL){
+		return;
+	}
+	runFinished(NULL);
+	fclose(file);
+	file = NULL;
+#else
+	if(fd < 0){
+		return;
+	}
+	runFinished(NULL);
+	munmap(mapped,mappedSize);
+	mapped = NULL;
+	//删除映射区域中未使用的部分
+	uint64_t size = sizeof(TraceFileHeader) + recordCount * sizeof(TraceRecord) + tablesSize;
+	if(ftruncate(fd,size) != 0){
+		printf("错误：截断跟踪文件失败（%s）\n",fileName.c_str());
+	}
+	::close(fd);
+	fd = -1;
+#endif
+}
@@ -0,0 +1,182 @@
+/**
+ * @file BinaryTrace.h
+ * @brief 紧凑二进制事件跟踪记录类BinaryTrace
+ * 每次事件调度、执行和取消记录一条定长记录（仿真时间、事件时间、事件类型标识、
+ * 事件名称标识、FEL/CEL操作和事件对象标识），Linux下记录直接写入内存映射文件。
+ * 事件类名称和事件名称在记录时转换为整数标识，名称表在跟踪结束时写入文件末尾。
+ * 跟踪文件由tools/TraceDecoder转换为文本或CSV格式。
+ * 文件格式：TraceFileHeader + recordCount条TraceRecord + 类型名称表 + 事件名称表，
+ * 名称表由名称数量（uint32）和每个名称的长度（uint32）及内容组成。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef BINARY_TRACE_H_
+#define BINARY_TRACE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <unordered_map>
+#include "Monitor.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 跟踪记录的操作类型
+ */
+#define TRACE_SCHEDULE_FEL   1	//在FEL中添加未来事件
+#define TRACE_SCHEDULE_CEL   2	//在CEL中添加条件事件
+#define TRACE_TRIGGER_FEL    3	//执行未来事件
+#define TRACE_TRIGGER_CEL    4	//执行条件事件
+#define TRACE_CANCEL         5	//取消事件调度
+
+/**
+ * @brief 跟踪文件标识
+ */
+#define TRACE_MAGIC "RDTRACE1"
+
+/**
+ * @brief 跟踪文件头
+ */
+struct TraceFileHeader{
+	char magic[8];
+	uint32_t version;
+	uint32_t recordSize;
+	uint64_t recordCount;
+	uint64_t typeTableOffset;
+	uint64_t nameTableOffset;
+};
+
+/**
+ * @brief 定长跟踪记录
+ */
+struct TraceRecord{
+	/**
+	 * @brief 记录时的仿真时间
+	 */
+	double clock;
+	/**
+	 * @brief 事件发生时间
+	 */
+	double eventTime;
+	/**
+	 * @brief 事件对象标识，为事件对象的地址
+	 */
+	uint64_t objectId;
+	/**
+	 * @brief 事件类型标识，为类型名称表中的序号
+	 */
+	uint32_t typeId;
+	/**
+	 * @brief 事件名称标识，为事件名称表中的序号
+	 */
+	uint32_t nameId;
+	/**
+	 * @brief 操作类型，TRACE_SCHEDULE_FEL等
+	 */
+	uint32_t op;
+	uint32_t reserved;
+};
+
+/**
+ * @brief 紧凑二进制事件跟踪记录类，作为监视器注册到Simulator
+ */
+class BinaryTrace:public Monitor{
+private:
+	/**
+	 * @brief 事件类型缓存项
+	 */
+	struct TypeCacheEntry{
+		const std::type_info * type;
+		uint32_t id;
+	};
+	std::string fileName;
+	/**
+	 * @brief 跟踪文件描述符或文件句柄
+	 */
+#ifdef _WIN32
+	FILE * file = NULL;
+	std::vector<TraceRecord> buffer;
+#else
+	int fd = -1;
+	char * mapped = NULL;
+	size_t mappedSize = 0;
+#endif
+	/**
+	 * @brief 当前映射或缓冲区中可以容纳的记录数量
+	 */
+	uint64_t recordCapacity = 0;
+	/**
+	 * @brief 已记录的记录数量
+	 */
+	uint64_t recordCount = 0;
+	/**
+	 * @brief 最近一次写入的名称表字节数
+	 */
+	uint64_t tablesSize = 0;
+	/**
+	 * @brief 事件类型名称表
+	 */
+	std::vector<std::string> typeNames;
+	std::vector<TypeCacheEntry> typeCache;
+	/**
+	 * @brief 按照EventNotice::getTypeId索引的类型名称表序号，-1表示尚未记录
+	 */
+	std::vector<int32_t> typeIdMap;
+	/**
+	 * @brief 最近一次记录的未设置类型标识的事件类型
+	 */
+	const std::type_info * lastType = NULL;
+	uint32_t lastTypeId = 0;
+	/**
+	 * @brief 事件名称表
+	 */
+	std::vector<std::string> names;
+	std::unordered_map<std::string,uint32_t> nameIds;
+	/**
+	 * @brief 本跟踪对象的序号，作为事件对象中缓存的名称标识的高32位，区分不同的跟踪对象
+	 */
+	uint64_t serial;
+
+	uint32_t internType(EventNotice * pEvent);
+	uint32_t internName(EventNotice * pEvent);
+	void record(Simulator * pSimulator,EventNotice * pEvent,uint32_t op);
+	/**
+	 * @brief 扩大跟踪文件映射区域
+	 */
+	void grow();
+public:
+	/**
+	 * @brief 创建BinaryTrace对象并打开跟踪文件
+	 * @param  fileName   跟踪文件名称
+	 */
+	BinaryTrace(const char * fileName);
+	/**
+	 * @brief 关闭跟踪文件并删除BinaryTrace对象
+	 */
+	virtual ~BinaryTrace();
+	/**
+	 * @brief 写入名称表和文件头，关闭跟踪文件
+	 */
+	void close();
+	/**
+	 * @brief 获得已记录的记录数量
+	 * @return uint64_t 记录数量
+	 */
+	uint64_t getRecordCount(){	return recordCount;	};
+
+	virtual void runFinished(Simulator * pSimulator);
+	virtual void eventScheduled(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+	virtual void eventCancelled(Simulator * pSimulator,EventNotice * pEvent);
+	virtual void eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+};
+
+}
+
+#endif /* BINARY_TRACE_H_ */
@@ -12,7 +12,7 @@
 
 namespace rubber_duck{
 
-Simulator * CProcess::simulator = NULL;
+thread_local Simulator * CProcess::simulator = NULL;
 
 void process(void * param){
 	CProcess * pProcess = (CProcess *)param;
@@ -34,9 +34,9 @@ private:
 	 */
 	Coroutine * coroutine;
 	/**
-	 * @brief 仿真引擎对象指针
+	 * @brief 仿真引擎对象指针，每个线程独立，使不同线程中的仿真引擎可以并行运行
 	 */
-	static Simulator * simulator;
+	static thread_local Simulator * simulator;
 public:
 	/**
 	 * @brief 创建CProcess对象，进程缺省堆栈为12800
@@ -64,6 +64,8 @@ public:
 	}
 	/**
 	 * @brief 初始化进程仿真引擎对象和Linux进程堆栈
+	 * 仿真引擎对象和协作例程状态都是线程局部的，每个运行进程仿真的线程都需要调用一次，
+	 * Linux下线程堆栈必须大于总堆栈大小
 	 * @param  pSimulator    进程仿真引擎对象指针
 	 * @param  totalStack    总堆栈大小
 	 * @param  mainStack     主堆栈大小，注意主堆栈不能大于等于总堆栈
@@ -103,7 +105,14 @@ public:
 	 * @param  pSimulator    仿真引擎对象指针
 	 */
 	virtual void trigger(Simulator * pSimulator){
+		const std::vector<Monitor *> & monitors = pSimulator->getMonitors();
+		for(size_t m = 0;m < monitors.size();m ++){
+			monitors[m]->processResumed(pSimulator,this);
+		}
 		Coroutine::switchTo(coroutine);
+		for(size_t m = 0;m < monitors.size();m ++){
+			monitors[m]->processSuspended(pSimulator,this);
+		}
 	}
 	/**
 	 * @brief 进程进入无条件延迟
@@ -294,6 +303,10 @@ public:
 			WaitProcess * w = new WaitProcess(p,n);
 			waitingLine.enqueue(w);
 			waitingAccumulate->update((double)waitingLine.size(), CProcess::getSimulator()->getClock());
+			const std::vector<Monitor *> & monitors = CProcess::getSimulator()->getMonitors();
+			for(size_t m = 0;m < monitors.size();m ++){
+				monitors[m]->resourceWaitStarted(CProcess::getSimulator(),this,p);
+			}
 			return false;
 		}
 	}
@@ -317,6 +330,10 @@ public:
 					currentUnits -= w->requestUnits;
 					waitingLine.dequeue();
 					servedLine.push_back(w->p);
+					const std::vector<Monitor *> & monitors = CProcess::getSimulator()->getMonitors();
+					for(size_t m = 0;m < monitors.size();m ++){
+						monitors[m]->resourceWaitFinished(CProcess::getSimulator(),this,w->p);
+					}
 					CProcess::activateNow(w->p);
 					delete w;
 					waitingAccumulate->update((double)waitingLine.size(),
@@ -337,6 +354,7 @@ public:
 		}
 	}
 
+	const char * getName(){	return name.c_str(); };
 	int getCapacity(){	return capacity; };
 	Accumulate * getWaitingAccumulate(){	return waitingAccumulate;	};
 	Accumulate * getWorkingAccumulate(){	return workingAccumulate;	};
@@ -0,0 +1,229 @@
+/**
+ * @file Checkpoint.cpp
+ * @brief 仿真检查点Checkpoint的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sstream>
+#include "EventCodec.h"
+#include "Random.h"
+#include "DataCollection.h"
+#include "Simulator.h"
+#include "Checkpoint.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+//检查点文件标识和格式版本
+static const char CheckpointMagic[8] = {'R','D','C','K','P','T','0','2'};
+
+void CheckpointWriter::putEventRecord(EventNotice * pEvent){
+	string record;
+	EventCodec::encode(pEvent,record);
+	putString(record);
+	int32_t index = (int32_t)indices.size();
+	indices[pEvent] = index;
+}
+
+void CheckpointWriter::putEvent(EventNotice * pEvent){
+	if(pEvent == NULL){
+		put((int32_t)-1);
+		return;
+	}
+	unordered_map<EventNotice *,int32_t>::iterator it = indices.find(pEvent);
+	if(it == indices.end()){
+		printf("错误：模型状态引用的事件（%s）不在FEL和CEL中，不能保存到检查点\n",pEvent->getName());
+		exit(0);
+	}
+	put(it->second);
+}
+
+void CheckpointReader::require(size_t size){
+	if((size_t)(end - cursor) < size){
+		printf("错误：检查点数据不完整\n");
+		exit(0);
+	}
+}
+
+void CheckpointReader::getString(string & value){
+	uint32_t length;
+	get(length);
+	require(length);
+	value.assign(cursor,length);
+	cursor += length;
+}
+
+EventNotice * CheckpointReader::getEventRecord(){
+	uint32_t length;
+	get(length);
+	require(length);
+	EventNotice * pEvent = EventCodec::decode(cursor,length);
+	cursor += length;
+	events.push_back(pEvent);
+	return pEvent;
+}
+
+EventNotice * CheckpointReader::getEvent(){
+	int32_t index;
+	get(index);
+	if(index < -1 || index >= (int32_t)events.size()){
+		printf("错误：检查点中的事件序号（%d）无效\n",(int)index);
+		exit(0);
+	}
+	return index < 0 ? NULL : events[index];
+}
+
+//随机变量生成器的状态：生成引擎和对偶模式，生成引擎按照标准库规定的文本格式保存，不依赖其内存布局
+static void putRandom(CheckpointWriter & writer,Random * pRandom){
+	ostringstream text;
+	text << *pRandom->getEngine();
+	writer.putString(text.str());
+	writer.put(pRandom->isAntithetic());
+}
+
+static void getRandom(CheckpointReader & reader,Random * pRandom){
+	string state;
+	bool antithetic;
+	reader.getString(state);
+	istringstream text(state);
+	text >> *pRandom->getEngine();
+	if(text.fail()){
+		printf("错误：检查点中的随机变量生成器状态无效\n");
+		exit(0);
+	}
+	reader.get(antithetic);
+	pRandom->setAntithetic(antithetic);
+}
+
+//读取数量并检查与注册的数量一致
+static void checkCount(CheckpointReader & reader,size_t expected,const char * what){
+	uint32_t count;
+	reader.get(count);
+	if(count != expected){
+		printf("错误：检查点中的%s数量（%u）与注册的数量（%zu）不一致\n",what,count,expected);
+		exit(0);
+	}
+}
+
+void Checkpoint::save(Simulator * pSimulator,string & data){
+	CheckpointWriter writer;
+	writer.put(CheckpointMagic);
+	writer.put((uint32_t)EventCodec::getCount());
+	for(int code = 0;code < EventCodec::getCount();code ++){
+		writer.putString(EventCodec::getName(code));
+	}
+	pSimulator->saveCheckpoint(writer);
+	putRandom(writer,pSimulator->getRandom());
+	writer.put((uint32_t)randoms.size());
+	for(size_t i = 0;i < randoms.size();i ++){
+		putRandom(writer,randoms[i]);
+	}
+	writer.put((uint32_t)statistics.size());
+	string bytes;
+	for(size_t i = 0;i < statistics.size();i ++){
+		bytes.clear();
+		statistics[i]->saveState(bytes);
+		writer.putString(bytes);
+	}
+	writer.put((uint32_t)states.size());
+	for(size_t i = 0;i < states.size();i ++){
+		states[i].first(writer);
+	}
+	data = writer.getBytes();
+	size = data.size();
+}
+
+void Checkpoint::save(Simulator * pSimulator,const char * fileName){
+	string data;
+	save(pSimulator,data);
+	FILE * file = fopen(fileName,"wb");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	if(fwrite(data.data(),1,data.size(),file) != data.size()){
+		printf("错误：写入检查点文件（%s）失败\n",fileName);
+		exit(0);
+	}
+	fclose(file);
+}
+
+void Checkpoint::restore(Simulator * pSimulator,const char * fileName){
+	FILE * file = fopen(fileName,"rb");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	string data;
+	char buffer[65536];
+	size_t count;
+	while((count = fread(buffer,1,sizeof(buffer),file)) > 0){
+		data.append(buffer,count);
+	}
+	fclose(file);
+	if(data.size() < sizeof(CheckpointMagic) || memcmp(data.data(),CheckpointMagic,sizeof(CheckpointMagic)) != 0){
+		printf("错误：文件（%s）不是检查点文件或格式版本不同\n",fileName);
+		exit(0);
+	}
+	restore(pSimulator,data.data(),data.size());
+}
+
+void Checkpoint::restore(Simulator * pSimulator,const char * data,size_t size){
+	CheckpointReader reader(data,size);
+	char magic[sizeof(CheckpointMagic)];
+	reader.get(magic);
+	if(memcmp(magic,CheckpointMagic,sizeof(magic)) != 0){
+		printf("错误：检查点数据的标识或格式版本不同\n");
+		exit(0);
+	}
+	//事件类型编号为注册顺序，必须与保存检查点的程序一致
+	checkCount(reader,(size_t)EventCodec::getCount(),"事件类型");
+	string name;
+	for(int code = 0;code < EventCodec::getCount();code ++){
+		reader.getString(name);
+		if(name != EventCodec::getName(code)){
+			printf("错误：检查点中的第%d个事件类型（%s）与注册的事件类型（%s）不一致\n",code,name.c_str(),
+					EventCodec::getName(code));
+			exit(0);
+		}
+	}
+	pSimulator->restoreCheckpoint(reader);
+	getRandom(reader,pSimulator->getRandom());
+	checkCount(reader,randoms.size(),"随机变量生成器");
+	for(size_t i = 0;i < randoms.size();i ++){
+		getRandom(reader,randoms[i]);
+	}
+	checkCount(reader,statistics.size(),"统计对象");
+	string bytes;
+	for(size_t i = 0;i < statistics.size();i ++){
+		reader.getString(bytes);
+		const char * cursor = bytes.data();
+		statistics[i]->restoreState(cursor);
+	}
+	checkCount(reader,states.size(),"模型状态");
+	for(size_t i = 0;i < states.size();i ++){
+		states[i].second(reader);
+	}
+	if(!reader.atEnd()){
+		printf("错误：检查点中有未读取的数据，模型状态的保存函数和恢复函数不一致\n");
+		exit(0);
+	}
+	this->size = size;
+}
+
+void Checkpoint::reseed(Simulator * pSimulator,uint64_t seed){
+	mt19937_64 source(seed);
+	pSimulator->getRandom()->getEngine()->seed(source());
+	for(size_t i = 0;i < randoms.size();i ++){
+		randoms[i]->getEngine()->seed(source());
+	}
+}
+
+}
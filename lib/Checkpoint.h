@@ -0,0 +1,244 @@
+/**
+ * @file Checkpoint.h
+ * @brief 仿真检查点Checkpoint，将仿真状态保存为二进制文件并从文件恢复
+ * 检查点包括仿真时钟、已执行的事件数量、缺省随机变量生成器，FEL和CEL中的事件，
+ * 以及注册的随机变量生成器、统计对象（DataCollection）和模型状态。事件按照EventCodec注册的类型编码，
+ * 检查点文件记录注册的类型名称，恢复时检查类型注册顺序是否一致。模型状态由保存函数和恢复函数成对注册，
+ * 引用事件对象的状态（例如排队中的顾客进程）通过putEvent和getEvent按照事件在检查点中的序号保存和恢复。
+ * 典型用法是预热一次后保存检查点，多次恢复后运行不同的重复仿真或假设分析分支：
+ *       Checkpoint checkpoint;
+ *       checkpoint.addRandom(stream);
+ *       checkpoint.addStatistic(&responseTally);
+ *       checkpoint.addState([](CheckpointWriter & w){ w.put(QueueLength); },
+ *                           [](CheckpointReader & r){ r.get(QueueLength); });
+ *       pSimulator->runUntil(T0);
+ *       checkpoint.save(pSimulator,"warmup.ckpt");
+ *       ...
+ *       checkpoint.restore(pSimulator,"warmup.ckpt");
+ *       pSimulator->run();
+ * 检查点也可以保存在内存中，用于重要性分裂等需要反复复制仿真状态的算法，恢复后通过reseed使各副本使用不同的随机数。
+ * 应在事件处理函数之外保存检查点，例如runUntil返回之后；run调度的结束事件不保存，恢复后由run重新指定。
+ * 协作例程进程（CProcess）的执行栈不能保存，只支持状态保存在成员变量中的EventNotice和ProcessNotice。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include "EventNotice.h"
+
+namespace rubber_duck{
+
+class Simulator;
+class Random;
+class DataCollection;
+
+/**
+ * @brief 检查点写入器，按照写入顺序追加二进制数据
+ */
+class CheckpointWriter{
+private:
+	/**
+	 * @brief 写入的数据
+	 */
+	std::string bytes;
+	/**
+	 * @brief 已写入的事件及其序号
+	 */
+	std::unordered_map<EventNotice *,int32_t> indices;
+public:
+	/**
+	 * @brief 写入可以按字节复制的值
+	 * @param  value    值
+	 */
+	template<class T>
+	void put(const T & value){
+		bytes.append((const char *)&value,sizeof(T));
+	}
+	/**
+	 * @brief 写入字符串或字节序列，先写入长度
+	 * @param  value    字符串
+	 */
+	void putString(const std::string & value){
+		put((uint32_t)value.size());
+		bytes.append(value);
+	}
+	/**
+	 * @brief 写入事件：编码事件并为事件分配序号
+	 * @param  pEvent   事件
+	 */
+	void putEventRecord(EventNotice * pEvent);
+	/**
+	 * @brief 写入对已写入事件的引用，事件不在检查点中时报错退出
+	 * @param  pEvent   事件，可以为NULL
+	 */
+	void putEvent(EventNotice * pEvent);
+	/**
+	 * @brief 获取写入的数据
+	 * @return const std::string& 数据
+	 */
+	const std::string & getBytes(){
+		return bytes;
+	}
+};
+
+/**
+ * @brief 检查点读取器，按照写入顺序读取二进制数据，数据不完整时报错退出
+ */
+class CheckpointReader{
+private:
+	/**
+	 * @brief 读取位置和数据结束位置
+	 */
+	const char * cursor, * end;
+	/**
+	 * @brief 已读取的事件，下标为序号
+	 */
+	std::vector<EventNotice *> events;
+	/**
+	 * @brief 检查剩余数据是否不少于size字节
+	 */
+	void require(size_t size);
+public:
+	/**
+	 * @brief 创建读取器
+	 * @param  bytes    数据
+	 * @param  size     字节数
+	 */
+	CheckpointReader(const char * bytes,size_t size):cursor(bytes),end(bytes + size){
+	}
+	/**
+	 * @brief 读取可以按字节复制的值
+	 * @param  value    值
+	 */
+	template<class T>
+	void get(T & value){
+		require(sizeof(T));
+		memcpy(&value,cursor,sizeof(T));
+		cursor += sizeof(T);
+	}
+	/**
+	 * @brief 读取字符串或字节序列
+	 * @param  value    字符串
+	 */
+	void getString(std::string & value);
+	/**
+	 * @brief 读取并创建事件，为事件分配序号
+	 * @return EventNotice* 事件
+	 */
+	EventNotice * getEventRecord();
+	/**
+	 * @brief 读取对已读取事件的引用
+	 * @return EventNotice* 事件，可以为NULL
+	 */
+	EventNotice * getEvent();
+	/**
+	 * @brief 是否已读取全部数据
+	 * @return bool 是否读取完毕
+	 */
+	bool atEnd(){
+		return cursor == end;
+	}
+};
+
+/**
+ * @brief 仿真检查点
+ */
+class Checkpoint{
+public:
+	/**
+	 * @brief 模型状态保存函数和恢复函数，两者读写的数据必须一致
+	 */
+	typedef std::function<void(CheckpointWriter & writer)> Saver;
+	typedef std::function<void(CheckpointReader & reader)> Loader;
+private:
+	/**
+	 * @brief 注册的随机变量生成器、统计对象和模型状态
+	 */
+	std::vector<Random *> randoms;
+	std::vector<DataCollection *> statistics;
+	std::vector<std::pair<Saver,Loader> > states;
+	/**
+	 * @brief 最近一次保存或恢复的检查点字节数
+	 */
+	size_t size;
+public:
+	Checkpoint():size(0){
+	}
+	/**
+	 * @brief 注册需要保存的随机变量生成器，仿真引擎的缺省随机变量生成器总是保存
+	 * @param  pRandom  随机变量生成器
+	 */
+	void addRandom(Random * pRandom){
+		randoms.push_back(pRandom);
+	}
+	/**
+	 * @brief 注册需要保存的统计对象
+	 * @param  pStatistic   统计对象
+	 */
+	void addStatistic(DataCollection * pStatistic){
+		statistics.push_back(pStatistic);
+	}
+	/**
+	 * @brief 注册模型状态的保存函数和恢复函数，在事件之后按照注册顺序调用
+	 * @param  saver    保存函数
+	 * @param  loader   恢复函数
+	 */
+	void addState(Saver saver,Loader loader){
+		states.push_back(std::make_pair(saver,loader));
+	}
+	/**
+	 * @brief 将检查点保存到内存
+	 * @param  pSimulator   仿真引擎
+	 * @param  data         检查点数据
+	 */
+	void save(Simulator * pSimulator,std::string & data);
+	/**
+	 * @brief 保存检查点文件，失败时报错退出
+	 * @param  pSimulator   仿真引擎
+	 * @param  fileName     检查点文件名称
+	 */
+	void save(Simulator * pSimulator,const char * fileName);
+	/**
+	 * @brief 从检查点文件恢复仿真引擎、注册的随机变量生成器、统计对象和模型状态，
+	 * 仿真引擎原有的事件被删除，文件不存在或与注册的内容不一致时报错退出
+	 * @param  pSimulator   仿真引擎
+	 * @param  fileName     检查点文件名称
+	 */
+	void restore(Simulator * pSimulator,const char * fileName);
+	/**
+	 * @brief 从内存中的检查点数据恢复，数据与注册的内容不一致时报错退出
+	 * @param  pSimulator   仿真引擎
+	 * @param  data         检查点数据
+	 * @param  size         字节数
+	 */
+	void restore(Simulator * pSimulator,const char * data,size_t size);
+	/**
+	 * @brief 由种子导出新种子，重新设置仿真引擎的缺省随机变量生成器和注册的随机变量生成器
+	 * @param  pSimulator   仿真引擎
+	 * @param  seed         种子
+	 */
+	void reseed(Simulator * pSimulator,uint64_t seed);
+	/**
+	 * @brief 获取最近一次保存或恢复的检查点字节数
+	 * @return size_t 字节数
+	 */
+	size_t getSize(){
+		return size;
+	}
+};
+
+}
+
+#endif /* CHECKPOINT_H_ */
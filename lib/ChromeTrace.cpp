@@ -0,0 +1,136 @@
+/**
+ * @file ChromeTrace.cpp
+ * @brief Chrome trace-event格式的仿真活动跟踪类ChromeTrace实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "CProcess.h"
+#include "ChromeTrace.h"
+
+using namespace rubber_duck;
+
+//跟踪文件的输出缓冲区大小
+#define TRACE_BUFFER_SIZE (1 << 20)
+
+ChromeTrace::ChromeTrace(const char * fileName){
+	file = fopen(fileName,"w");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	setvbuf(file,NULL,_IOFBF,TRACE_BUFFER_SIZE);
+	start = std::chrono::steady_clock::now();
+	fputs("[\n",file);
+	fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"RubberDuck\"}}",file);
+	first = false;
+}
+
+ChromeTrace::~ChromeTrace(){
+	close();
+}
+
+//跟踪文件结束符
+#define TRACE_TERMINATOR "\n]\n"
+
+void ChromeTrace::close(){
+	if(file != NULL){
+		if(!terminated){
+			fputs(TRACE_TERMINATOR,file);
+		}
+		fclose(file);
+		file = NULL;
+	}
+}
+
+double ChromeTrace::now(){
+	return std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ChromeTrace::separator(){
+	if(terminated){
+		//覆盖上次仿真运行结束时写入的结束符
+		fseek(file,-(long)strlen(TRACE_TERMINATOR),SEEK_END);
+		terminated = false;
+	}
+	if(!first){
+		fputs(",\n",file);
+	}
+	first = false;
+}
+
+void ChromeTrace::complete(const char * name,const char * category,double ts,double dur,double clock,const char * detail){
+	if(file == NULL){
+		return;
+	}
+	separator();
+	fprintf(file,"{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1,"
+			"\"args\":{\"clock\":%.6f,\"detail\":\"%s\"}}",
+			jsonEscape(name).c_str(),category,ts,dur,clock,jsonEscape(detail).c_str());
+}
+
+void ChromeTrace::async(const char * name,const char * phase,const void * id,double clock,const char * detail){
+	if(file == NULL){
+		return;
+	}
+	separator();
+	fprintf(file,"{\"name\":\"%s\",\"cat\":\"resource\",\"ph\":\"%s\",\"id\":\"%p\",\"ts\":%.3f,\"pid\":1,\"tid\":1,"
+			"\"args\":{\"clock\":%.6f,\"process\":\"%s\"}}",
+			jsonEscape(name).c_str(),phase,id,now(),clock,jsonEscape(detail).c_str());
+}
+
+void ChromeTrace::runFinished(Simulator * pSimulator){
+	if(file != NULL && !terminated){
+		fputs(TRACE_TERMINATOR,file);
+		fflush(file);
+		terminated = true;
+	}
+}
+
+void ChromeTrace::eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	eventStarts.push_back(now());
+}
+
+void ChromeTrace::eventTriggered(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	if(eventStarts.empty()){
+		return;
+	}
+	double ts = eventStarts.back();
+	eventStarts.pop_back();
+	complete(getEventClassName(pEvent).c_str(),conditional ? "conditional" : "event",
+			ts,now() - ts,pSimulator->getClock(),pEvent->getName());
+}
+
+void ChromeTrace::conditionalScanStarted(Simulator * pSimulator){
+	scanStart = now();
+}
+
+void ChromeTrace::conditionalScanFinished(Simulator * pSimulator){
+	complete("CEL扫描","scan",scanStart,now() - scanStart,pSimulator->getClock(),"");
+}
+
+void ChromeTrace::processResumed(Simulator * pSimulator,EventNotice * pProcess){
+	processStarts.push_back(now());
+}
+
+void ChromeTrace::processSuspended(Simulator * pSimulator,EventNotice * pProcess){
+	if(processStarts.empty()){
+		return;
+	}
+	double ts = processStarts.back();
+	processStarts.pop_back();
+	complete(pProcess->getName(),"coroutine",ts,now() - ts,pSimulator->getClock(),getEventClassName(pProcess).c_str());
+}
+
+void ChromeTrace::resourceWaitStarted(Simulator * pSimulator,Resource * pResource,EventNotice * pProcess){
+	async(pResource->getName(),"b",pProcess,pSimulator->getClock(),pProcess->getName());
+}
+
+void ChromeTrace::resourceWaitFinished(Simulator * pSimulator,Resource * pResource,EventNotice * pProcess){
+	async(pResource->getName(),"e",pProcess,pSimulator->getClock(),pProcess->getName());
+}
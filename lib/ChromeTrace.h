@@ -0,0 +1,104 @@
+/**
+ * @file ChromeTrace.h
+ * @brief Chrome trace-event格式的仿真活动跟踪类ChromeTrace
+ * 将事件执行、条件事件表扫描、CProcess协程切换和资源等待按照墙钟时间
+ * 流式写入JSON数组格式的跟踪文件，可以在Perfetto（ui.perfetto.dev）或
+ * chrome://tracing中以时间线查看。每次仿真运行结束时写入结束符，
+ * 继续记录时覆盖结束符，因此程序未删除仿真引擎对象时跟踪文件也是完整的。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef CHROME_TRACE_H_
+#define CHROME_TRACE_H_
+
+#include <stdio.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Monitor.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief Chrome trace-event格式的仿真活动跟踪类，作为监视器注册到Simulator
+ */
+class ChromeTrace:public Monitor{
+private:
+	/**
+	 * @brief 跟踪文件句柄
+	 */
+	FILE * file = NULL;
+	/**
+	 * @brief 是否已经写入第一条跟踪事件
+	 */
+	bool first = true;
+	/**
+	 * @brief 是否已经写入结束符，每次仿真运行结束时写入结束符，使跟踪文件保持完整
+	 */
+	bool terminated = false;
+	/**
+	 * @brief 跟踪开始的墙钟时间
+	 */
+	std::chrono::steady_clock::time_point start;
+	/**
+	 * @brief 正在执行的事件开始时间栈
+	 */
+	std::vector<double> eventStarts;
+	/**
+	 * @brief 条件事件表扫描开始时间
+	 */
+	double scanStart = 0;
+	/**
+	 * @brief 正在执行的协程开始时间栈
+	 */
+	std::vector<double> processStarts;
+	/**
+	 * @brief 获得跟踪开始后的墙钟时间
+	 * @return double 微秒数
+	 */
+	double now();
+	/**
+	 * @brief 写入一条持续时间事件（ph为X）
+	 */
+	void complete(const char * name,const char * category,double ts,double dur,double clock,const char * detail);
+	/**
+	 * @brief 写入一条异步事件（ph为b或e）
+	 */
+	void async(const char * name,const char * phase,const void * id,double clock,const char * detail);
+	/**
+	 * @brief 写入跟踪事件分隔符
+	 */
+	void separator();
+public:
+	/**
+	 * @brief 创建ChromeTrace对象并打开跟踪文件
+	 * @param  fileName   跟踪文件名称
+	 */
+	ChromeTrace(const char * fileName);
+	/**
+	 * @brief 关闭跟踪文件并删除ChromeTrace对象
+	 */
+	virtual ~ChromeTrace();
+	/**
+	 * @brief 写入结束符并关闭跟踪文件
+	 */
+	void close();
+
+	virtual void runFinished(Simulator * pSimulator);
+	virtual void eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+	virtual void eventTriggered(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+	virtual void conditionalScanStarted(Simulator * pSimulator);
+	virtual void conditionalScanFinished(Simulator * pSimulator);
+	virtual void processResumed(Simulator * pSimulator,EventNotice * pProcess);
+	virtual void processSuspended(Simulator * pSimulator,EventNotice * pProcess);
+	virtual void resourceWaitStarted(Simulator * pSimulator,Resource * pResource,EventNotice * pProcess);
+	virtual void resourceWaitFinished(Simulator * pSimulator,Resource * pResource,EventNotice * pProcess);
+};
+
+}
+
+#endif /* CHROME_TRACE_H_ */
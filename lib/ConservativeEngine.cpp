@@ -0,0 +1,38 @@
+/**
+ * @file ConservativeEngine.cpp
+ * @brief Chandy-Misra-Bryant保守同步并行仿真引擎ConservativeEngine的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <float.h>
+#include <cmath>
+#include "ConservativeEngine.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+bool ConservativeEngine::advance(LogicalProcess * lp){
+	Simulator * pSimulator = lp->getSimulator();
+	bool progress = lp->receive();
+	double safe = lp->getSafeTime();
+	//执行时间戳小于安全时间且不大于结束时间的事件
+	double limit = nextafter(endTime,DBL_MAX);
+	uint64_t before = pSimulator->getEventCount();
+	pSimulator->runUntil(safe < limit ? safe : limit);
+	progress |= pSimulator->getEventCount() != before;
+	//以后执行的事件时间不小于bound，由此得到输出通道上的时间戳下界
+	double next = pSimulator->getNextEventTime();
+	double bound = safe < next ? safe : next;
+	progress |= lp->sendNullMessages(bound);
+	if(bound > endTime){
+		lp->setFinished(true);
+	}
+	return progress;
+}
+
+}
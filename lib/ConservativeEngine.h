@@ -0,0 +1,46 @@
+/**
+ * @file ConservativeEngine.h
+ * @brief Chandy-Misra-Bryant保守同步并行仿真引擎ConservativeEngine
+ * 逻辑进程只执行时间戳小于安全时间（全部输入通道时钟的最小值）的事件，保证不会收到
+ * 时间戳更小的消息。每次推进后，逻辑进程以后执行的事件时间不小于
+ * min(安全时间,下一个本地事件时间)，因此在每条输出通道上发送时间戳为该下界加前瞻量的空消息，
+ * 使下游逻辑进程的安全时间前进。全部通道的前瞻量大于0，包括环路在内都不会死锁。
+ * 同一逻辑进程内时间相同的本地事件和接收的事件按照加入未来事件表的先后执行。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef CONSERVATIVE_ENGINE_H_
+#define CONSERVATIVE_ENGINE_H_
+
+#include "ParallelEngine.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 空消息保守同步并行仿真引擎
+ */
+class ConservativeEngine:public ParallelEngine{
+protected:
+	/**
+	 * @brief 接收消息，执行安全事件，发送空消息
+	 * @param  lp   逻辑进程
+	 * @return bool 是否有进展
+	 */
+	virtual bool advance(LogicalProcess * lp);
+public:
+	/**
+	 * @brief 获取同步协议名称
+	 * @return const char* 协议名称
+	 */
+	virtual const char * getProtocol(){
+		return "CMB NULL MESSAGE";
+	}
+};
+
+}
+
+#endif /* CONSERVATIVE_ENGINE_H_ */
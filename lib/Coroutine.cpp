@@ -14,7 +14,7 @@ namespace rubber_duck {
 
 #ifdef _WIN32
 
-LPVOID Coroutine::lpMainFiber;
+thread_local LPVOID Coroutine::lpMainFiber;
 
 void Coroutine::init(unsigned totalStack, unsigned mainStack)
 {
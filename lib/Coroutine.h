@@ -56,7 +56,7 @@ class Coroutine
   protected:
 #ifdef _WIN32
     LPVOID lpFiber;
-    static LPVOID lpMainFiber;
+    static thread_local LPVOID lpMainFiber;
     unsigned stackSize;
 #else
     _Task *task;
@@ -67,7 +67,9 @@ class Coroutine
 
     /**
      * Initializes the coroutine library. This function has to be called
-     * exactly once in a program, possibly at the top of main().
+     * exactly once in every thread that runs coroutines, before the first
+     * coroutine is set up. The coroutine state is thread-local; with the
+     * portable coroutines the thread stack must be larger than totalStack.
      */
     static void init(unsigned totalStack, unsigned mainStack);
 
@@ -8,6 +8,7 @@
  * @copyright Copyright(C) 2020 liqun
  * 
  */
+#include <string.h>
 #include "Error.h"
 #include "DataCollection.h"
 
@@ -78,6 +79,73 @@ double DataCollection::tValue(double p, int df) {
     return abs(t);
 } 
 
+//按字节追加和读取统计状态
+template<class T>
+static void putValue(string & bytes,const T & value) {
+    bytes.append((const char *)&value,sizeof(T));
+}
+
+template<class T>
+static void getValue(const char * & bytes,T & value) {
+    memcpy(&value,bytes,sizeof(T));
+    bytes += sizeof(T);
+}
+
+void DataCollection::saveState(string & bytes) {
+    putValue(bytes,obs);
+    putValue(bytes,resetAt);
+}
+
+void DataCollection::restoreState(const char * & bytes) {
+    getValue(bytes,obs);
+    getValue(bytes,resetAt);
+}
+
+void DataCollection::mergeState(const char * & bytes) {
+    int count;
+    double time;
+    getValue(bytes,count);
+    getValue(bytes,time);
+    obs += count;
+}
+
+void Tally::saveState(string & bytes) {
+    DataCollection::saveState(bytes);
+    putValue(bytes,sum);
+    putValue(bytes,sumsq);
+    putValue(bytes,m_min);
+    putValue(bytes,m_max);
+}
+
+void Tally::restoreState(const char * & bytes) {
+    DataCollection::restoreState(bytes);
+    getValue(bytes,sum);
+    getValue(bytes,sumsq);
+    getValue(bytes,m_min);
+    getValue(bytes,m_max);
+}
+
+void Tally::mergeState(const char * & bytes) {
+    int previous = obs;
+    DataCollection::mergeState(bytes);
+    double otherSum, otherSumsq, otherMin, otherMax;
+    getValue(bytes,otherSum);
+    getValue(bytes,otherSumsq);
+    getValue(bytes,otherMin);
+    getValue(bytes,otherMax);
+    sum += otherSum;
+    sumsq += otherSumsq;
+    if (obs == previous)
+        return;
+    if (previous == 0) {
+        m_min = otherMin;
+        m_max = otherMax;
+    } else {
+        m_min = otherMin < m_min ? otherMin : m_min;
+        m_max = otherMax > m_max ? otherMax : m_max;
+    }
+}
+
 void Tally::reset(double time) {
     obs = 0;
     sum = sumsq = m_min = m_max = 0;
@@ -128,6 +196,55 @@ void Accumulate::update(double v,double time) {
         m_max = v;
 }
     
+void Accumulate::saveState(string & bytes) {
+    DataCollection::saveState(bytes);
+    putValue(bytes,sum);
+    putValue(bytes,sumsq);
+    putValue(bytes,m_min);
+    putValue(bytes,m_max);
+    putValue(bytes,lastTime);
+    putValue(bytes,lastV);
+}
+
+void Accumulate::restoreState(const char * & bytes) {
+    DataCollection::restoreState(bytes);
+    getValue(bytes,sum);
+    getValue(bytes,sumsq);
+    getValue(bytes,m_min);
+    getValue(bytes,m_max);
+    getValue(bytes,lastTime);
+    getValue(bytes,lastV);
+}
+
+//各分支的累积时间首尾相接，合并后的时间平均为全部分支的面积之和除以时间长度之和
+void Accumulate::mergeState(const char * & bytes) {
+    int previous = obs;
+    int count;
+    double otherResetAt, otherSum, otherSumsq, otherMin, otherMax, otherLastTime, otherLastV;
+    getValue(bytes,count);
+    getValue(bytes,otherResetAt);
+    getValue(bytes,otherSum);
+    getValue(bytes,otherSumsq);
+    getValue(bytes,otherMin);
+    getValue(bytes,otherMax);
+    getValue(bytes,otherLastTime);
+    getValue(bytes,otherLastV);
+    obs += count;
+    sum += otherSum;
+    sumsq += otherSumsq;
+    lastTime += otherLastTime - otherResetAt;
+    lastV = otherLastV;
+    if (count == 0)
+        return;
+    if (previous == 0) {
+        m_min = otherMin;
+        m_max = otherMax;
+    } else {
+        m_min = otherMin < m_min ? otherMin : m_min;
+        m_max = otherMax > m_max ? otherMax : m_max;
+    }
+}
+
 double Accumulate::mean() {
     double span = lastTime - resetAt;
     if (span == 0)
@@ -179,6 +296,26 @@ void Histogram::update(double v,double time) {
     table[cell]++;
 }
     
+void Histogram::saveState(string & bytes) {
+    Tally::saveState(bytes);
+    bytes.append((const char *)table,sizeof(int) * (limit + 1));
+}
+
+void Histogram::restoreState(const char * & bytes) {
+    Tally::restoreState(bytes);
+    memcpy(table,bytes,sizeof(int) * (limit + 1));
+    bytes += sizeof(int) * (limit + 1);
+}
+
+void Histogram::mergeState(const char * & bytes) {
+    Tally::mergeState(bytes);
+    int count;
+    for (int cell = 0; cell <= limit; cell++) {
+        getValue(bytes,count);
+        table[cell] += count;
+    }
+}
+
 void Histogram::report() {
     Tally::report();
     printEnding();
@@ -51,6 +51,8 @@ public:
      */
     DataCollection(const char * title) {
         this->title = title;
+        obs = 0;
+        resetAt = 0;
     }
 
     virtual ~DataCollection() {}
@@ -97,6 +99,21 @@ public:
      * @brief 抽象方法，打印当前指标的统计结果报告
      */
     virtual void report();
+    /**
+     * @brief 将统计状态追加到bytes，用于保存检查点
+     * @param  bytes            字节序列
+     */
+    virtual void saveState(std::string & bytes);
+    /**
+     * @brief 从bytes读取saveState保存的统计状态，并将读取位置后移
+     * @param  bytes            读取位置
+     */
+    virtual void restoreState(const char * & bytes);
+    /**
+     * @brief 读取同类统计对象saveState保存的统计状态并合并到当前统计，用于汇总独立仿真分支的样本
+     * @param  bytes            读取位置
+     */
+    virtual void mergeState(const char * & bytes);
     /**
      * @brief 抽象方法，获取样本最小值
      * @return double 样本最小值
@@ -190,6 +207,7 @@ public:
      * @param  title  性能指标名称，不能超过20个字符
      */
     Tally(const char * title):DataCollection(title) {
+        sum = sumsq = m_min = m_max = 0;
     }
 
     virtual ~Tally() {}
@@ -204,6 +222,21 @@ public:
      * @param  time             时间
      */
     virtual void update(double v,double time);
+    /**
+     * @brief 保存统计状态
+     * @param  bytes            字节序列
+     */
+    virtual void saveState(std::string & bytes);
+    /**
+     * @brief 恢复统计状态
+     * @param  bytes            读取位置
+     */
+    virtual void restoreState(const char * & bytes);
+    /**
+     * @brief 合并统计状态
+     * @param  bytes            读取位置
+     */
+    virtual void mergeState(const char * & bytes);
     /**
      * @brief 获取样本方差
      * @return double 样本方差
@@ -276,9 +309,11 @@ public:
      * @param  title  性能指标名称，不能超过20个字符
      */
      Accumulate(const char * title): DataCollection(title){
+        sum = sumsq = m_min = m_max = lastTime = lastV = 0;
     }
 
     Accumulate(): DataCollection("Accumulate"){
+        sum = sumsq = m_min = m_max = lastTime = lastV = 0;
     }
 
     virtual ~Accumulate() {}
@@ -293,6 +328,21 @@ public:
      * @param  time             时间
      */
     virtual void update(double v,double time);
+    /**
+     * @brief 保存统计状态
+     * @param  bytes            字节序列
+     */
+    virtual void saveState(std::string & bytes);
+    /**
+     * @brief 恢复统计状态
+     * @param  bytes            读取位置
+     */
+    virtual void restoreState(const char * & bytes);
+    /**
+     * @brief 合并统计状态
+     * @param  bytes            读取位置
+     */
+    virtual void mergeState(const char * & bytes);
     /**
      * @brief 获取样本最小值
      * @return double 样本最小值
@@ -398,6 +448,21 @@ public:
      * @param  time             时间
      */
     virtual void update(double v,double time);
+    /**
+     * @brief 保存统计状态
+     * @param  bytes            字节序列
+     */
+    virtual void saveState(std::string & bytes);
+    /**
+     * @brief 恢复统计状态
+     * @param  bytes            读取位置
+     */
+    virtual void restoreState(const char * & bytes);
+    /**
+     * @brief 合并统计状态
+     * @param  bytes            读取位置
+     */
+    virtual void mergeState(const char * & bytes);
     /**
      * @brief 抽象方法，打印当前指标的统计结果报告
      */
@@ -0,0 +1,108 @@
+/**
+ * @file EventCodec.cpp
+ * @brief 事件编码注册表EventCodec的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include <typeindex>
+#include <unordered_map>
+#include "EventCodec.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+//注册的事件类型
+struct EventType{
+	string name;
+	EventCodec::Encoder encoder;
+	EventCodec::Decoder decoder;
+};
+
+//注册表放在函数内，避免其他编译单元的静态初始化先于注册表构造
+static vector<EventType> & registeredTypes(){
+	static vector<EventType> types;
+	return types;
+}
+
+static unordered_map<type_index,int> & registeredCodes(){
+	static unordered_map<type_index,int> codes;
+	return codes;
+}
+
+int EventCodec::add(const type_info & type,const char * name,Encoder encoder,Decoder decoder){
+	unordered_map<type_index,int> & codes = registeredCodes();
+	unordered_map<type_index,int>::iterator it = codes.find(type_index(type));
+	if(it != codes.end()){
+		return it->second;
+	}
+	vector<EventType> & types = registeredTypes();
+	int code = (int)types.size();
+	types.push_back(EventType{name,encoder,decoder});
+	codes[type_index(type)] = code;
+	return code;
+}
+
+int EventCodec::find(EventNotice * pEvent){
+	unordered_map<type_index,int> & codes = registeredCodes();
+	unordered_map<type_index,int>::iterator it = codes.find(type_index(typeid(*pEvent)));
+	return it != codes.end() ? it->second : -1;
+}
+
+const char * EventCodec::getName(int code){
+	return registeredTypes()[code].name.c_str();
+}
+
+int EventCodec::getCount(){
+	return (int)registeredTypes().size();
+}
+
+void EventCodec::encode(EventNotice * pEvent,string & record){
+	int code = find(pEvent);
+	if(code < 0){
+		printf("错误：事件（%s）的类型%s没有注册编码函数\n",pEvent->getName(),typeid(*pEvent).name());
+		exit(0);
+	}
+	put(record,(int32_t)code);
+	put(record,pEvent->getTime());
+	put(record,(int32_t)pEvent->getPriority());
+	put(record,(int32_t)pEvent->getConflictKey());
+	put(record,(uint8_t)(pEvent->isReserved() ? 1 : 0));
+	registeredTypes()[code].encoder(pEvent,record);
+}
+
+void EventCodec::truncated(){
+	printf("错误：事件记录数据不完整\n");
+	exit(0);
+}
+
+EventNotice * EventCodec::decode(const char * record,size_t size){
+	const char * end = record + size;
+	int32_t code, priority, conflictKey;
+	double time;
+	uint8_t reserved;
+	get(record,end,code);
+	get(record,end,time);
+	get(record,end,priority);
+	get(record,end,conflictKey);
+	get(record,end,reserved);
+	if(code < 0 || code >= getCount()){
+		printf("错误：事件记录的类型编号（%d）无效\n",(int)code);
+		exit(0);
+	}
+	EventNotice * pEvent = registeredTypes()[code].decoder(time,record,end - record);
+	pEvent->setPriority(priority);
+	pEvent->setConflictKey(conflictKey);
+	pEvent->setReserved(reserved != 0);
+	return pEvent;
+}
+
+}
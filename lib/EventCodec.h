@@ -0,0 +1,138 @@
+/**
+ * @file EventCodec.h
+ * @brief 事件编码注册表EventCodec
+ * 事件对象需要离开所在的进程（例如发送到其他操作系统进程中的逻辑进程）时，按照注册的事件类型
+ * 编码为字节序列，在目的地重新创建事件对象。事件记录的格式为：类型编号、事件时间、优先级、冲突键、
+ * 是否保留、事件数据，解码函数创建事件对象后由EventCodec恢复优先级、冲突键和是否保留。
+ * 类型编号为注册顺序，编码和解码的程序必须按照相同的顺序注册事件类型，通常在main开始时注册。
+ * 事件类可以提供编码成员函数和解码静态函数，用模板add注册：
+ *       class Arrival:public EventNotice{
+ *           int customer;
+ *       public:
+ *           void encode(std::string & bytes){  EventCodec::put(bytes,customer);  }
+ *           static EventNotice * decode(double time,const char * bytes,size_t size){
+ *               const char * end = bytes + size;
+ *               int customer;
+ *               EventCodec::get(bytes,end,customer);
+ *               return new Arrival(time,customer);
+ *           }
+ *       };
+ *       EventCodec::add<Arrival>("Arrival");
+ * 注册表不加锁，应在创建工作线程或子进程之前完成注册。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef EVENT_CODEC_H_
+#define EVENT_CODEC_H_
+
+#include <stddef.h>
+#include <string.h>
+#include <string>
+#include <typeinfo>
+#include "EventNotice.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 事件编码注册表
+ */
+class EventCodec{
+public:
+	/**
+	 * @brief 事件数据编码函数，将事件数据（不包括事件时间）追加到bytes
+	 */
+	typedef void (*Encoder)(EventNotice * pEvent,std::string & bytes);
+	/**
+	 * @brief 事件解码函数，由事件时间和事件数据创建事件对象
+	 */
+	typedef EventNotice * (*Decoder)(double time,const char * bytes,size_t size);
+	/**
+	 * @brief 注册事件类型，同一类型重复注册时只保留第一次注册
+	 * @param  type     事件类型
+	 * @param  name     类型名称
+	 * @param  encoder  编码函数
+	 * @param  decoder  解码函数
+	 * @return int 类型编号
+	 */
+	static int add(const std::type_info & type,const char * name,Encoder encoder,Decoder decoder);
+	/**
+	 * @brief 注册提供encode成员函数和decode静态函数的事件类型
+	 * @tparam T 事件类型
+	 * @param  name     类型名称
+	 * @return int 类型编号
+	 */
+	template<class T>
+	static int add(const char * name){
+		return add(typeid(T),name,&encodeAs<T>,&T::decode);
+	}
+	/**
+	 * @brief 获取事件类型的编号
+	 * @param  pEvent   事件
+	 * @return int 类型编号，未注册时为-1
+	 */
+	static int find(EventNotice * pEvent);
+	/**
+	 * @brief 获取类型名称
+	 * @param  code     类型编号
+	 * @return const char* 类型名称
+	 */
+	static const char * getName(int code);
+	/**
+	 * @brief 获取已注册的类型数量
+	 * @return int 类型数量
+	 */
+	static int getCount();
+	/**
+	 * @brief 将事件编码为事件记录并追加到record，事件类型未注册时报错退出
+	 * @param  pEvent   事件
+	 * @param  record   事件记录
+	 */
+	static void encode(EventNotice * pEvent,std::string & record);
+	/**
+	 * @brief 由事件记录创建事件对象，记录不完整或类型编号无效时报错退出
+	 * @param  record   事件记录
+	 * @param  size     事件记录字节数
+	 * @return EventNotice* 事件对象
+	 */
+	static EventNotice * decode(const char * record,size_t size);
+	/**
+	 * @brief 追加可以按字节复制的值
+	 * @param  bytes    字节序列
+	 * @param  value    值
+	 */
+	template<class T>
+	static void put(std::string & bytes,const T & value){
+		bytes.append((const char *)&value,sizeof(T));
+	}
+	/**
+	 * @brief 读取可以按字节复制的值，并将读取位置后移，剩余数据不足时报错退出
+	 * @param  bytes    读取位置
+	 * @param  end      数据结束位置
+	 * @param  value    值
+	 */
+	template<class T>
+	static void get(const char * & bytes,const char * end,T & value){
+		if(end < bytes || (size_t)(end - bytes) < sizeof(T)){
+			truncated();
+		}
+		memcpy(&value,bytes,sizeof(T));
+		bytes += sizeof(T);
+	}
+private:
+	/**
+	 * @brief 报告事件记录数据不完整并退出
+	 */
+	static void truncated();
+	template<class T>
+	static void encodeAs(EventNotice * pEvent,std::string & bytes){
+		static_cast<T *>(pEvent)->encode(bytes);
+	}
+};
+
+}
+
+#endif /* EVENT_CODEC_H_ */
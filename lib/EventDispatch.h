@@ -0,0 +1,204 @@
+/**
+ * @file EventDispatch.h
+ * @brief 基于事件类型标识的静态事件分派模板EventDispatcher
+ * 对于事件类型在编译时已知的封闭模型，Simulator可以按照紧凑的事件类型标识
+ * 直接调用事件处理函数，避免canTrigger、trigger以及进程推进函数的虚函数调用，
+ * 使编译器能够内联事件处理函数。使用方法如下：
+ *       class Arrival;
+ *       class Departure;
+ *       typedef EventDispatcher<Arrival,Departure> QueueDispatcher;
+ *       //在事件构造函数中设置类型标识
+ *       setTypeId(QueueDispatcher::typeIdOf<Arrival>());
+ *       //按照分派模板运行，事件分派内联到事件循环中
+ *       pSimulator->runDispatched<QueueDispatcher>();
+ * 未设置类型标识或不在类型列表中的事件仍然按照虚函数分派。
+ * 类型列表中的事件按照列出的类型非虚调用E::trigger和E::canTrigger，其派生类会继承基类构造函数中
+ * 设置的类型标识，派生类重载的函数将被跳过，因此列出的事件类型不能再被继承，或者派生类必须
+ * 设置自己的类型标识（列入类型列表或设为-1）。调试版本中检查事件的实际类型与类型标识一致。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef EVENT_DISPATCH_H_
+#define EVENT_DISPATCH_H_
+
+#include <assert.h>
+#include <type_traits>
+#include <typeinfo>
+#include "EventNotice.h"
+#include "ProcessNotice.h"
+#include "Simulator.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 进程推进函数的直接调用，P为ProcessNotice时按照虚函数调用
+ */
+template<class P>
+struct ProcessCalls{
+	static double runToBlocked(P * p,Simulator * pSimulator){
+		return p->P::runToBlocked(pSimulator);
+	}
+	static bool isConditionalBlocking(P * p,Simulator * pSimulator){
+		return p->P::isConditionalBlocking(pSimulator);
+	}
+	static const char * getPhaseName(P * p){
+		return p->P::getPhaseName();
+	}
+};
+
+template<>
+struct ProcessCalls<ProcessNotice>{
+	static double runToBlocked(ProcessNotice * p,Simulator * pSimulator){
+		return p->runToBlocked(pSimulator);
+	}
+	static bool isConditionalBlocking(ProcessNotice * p,Simulator * pSimulator){
+		return p->isConditionalBlocking(pSimulator);
+	}
+	static const char * getPhaseName(ProcessNotice * p){
+		return p->getPhaseName();
+	}
+};
+
+template<class P>
+void ProcessNotice::triggerAs(Simulator * pSimulator){
+	P * self = static_cast<P *>(this);
+	SIM_TRACE(pSimulator,"仿真时间=%f 进程[%s]从复活点[%s]推进进程。 \n",pSimulator->getClock(),getName(),ProcessCalls<P>::getPhaseName(self));
+	//推进进程，直到被锁住
+	activateTime = ProcessCalls<P>::runToBlocked(self,pSimulator);
+	//如果进程进入无条件延迟
+	if(activateTime >= 0){
+		time = activateTime;
+		SIM_TRACE(pSimulator,"仿真时间=%f 进程[%s]进入无条件延迟，复活点[%s]。\n",pSimulator->getClock(),getName(),ProcessCalls<P>::getPhaseName(self));
+		//调度无条件延迟进程对象
+		pSimulator->scheduleEvent(this);
+	}else{//进程进入条件延迟
+		//如果进程结束，则设置reserved为false，由SImulator删除进程对象
+		if(terminated){
+			SIM_TRACE(pSimulator,"仿真时间=%f 进程[%s]运行结束！ \n",pSimulator->getClock(),getName());
+			reserved = false;
+		}else{//如果进程为条件延迟
+			SIM_TRACE(pSimulator,"仿真时间=%f 进程[%s]进入条件延迟，复活点[%s]。\n",pSimulator->getClock(),getName(),ProcessCalls<P>::getPhaseName(self));
+			//将进程对象添加到条件事件列表
+			pSimulator->scheduleConditionalEvent(this);
+		}
+	}
+}
+
+/**
+ * @brief 单个事件类型E的直接调用，未重载的trigger和canTrigger按照ProcessNotice的实现展开
+ */
+template<class E>
+struct EventCalls{
+	typedef std::integral_constant<bool,
+		std::is_base_of<ProcessNotice,E>::value &&
+		std::is_same<decltype(&E::trigger),void (ProcessNotice::*)(Simulator *)>::value> InheritsProcessTrigger;
+	typedef std::integral_constant<bool,
+		std::is_base_of<ProcessNotice,E>::value &&
+		std::is_same<decltype(&E::canTrigger),bool (ProcessNotice::*)(Simulator *)>::value> InheritsProcessCondition;
+
+	static void trigger(E * p,Simulator * pSimulator){
+		trigger(p,pSimulator,InheritsProcessTrigger());
+	}
+	static bool canTrigger(E * p,Simulator * pSimulator){
+		return canTrigger(p,pSimulator,InheritsProcessCondition());
+	}
+private:
+	static void trigger(E * p,Simulator * pSimulator,std::true_type){
+		p->template triggerAs<E>(pSimulator);
+	}
+	static void trigger(E * p,Simulator * pSimulator,std::false_type){
+		p->E::trigger(pSimulator);
+	}
+	static bool canTrigger(E * p,Simulator * pSimulator,std::true_type){
+		return !ProcessCalls<E>::isConditionalBlocking(p,pSimulator);
+	}
+	static bool canTrigger(E * p,Simulator * pSimulator,std::false_type){
+		return p->E::canTrigger(pSimulator);
+	}
+};
+
+/**
+ * @brief 类型列表的分派表，第I个事件类型的类型标识为I
+ */
+template<int I,class... Events>
+struct DispatchTable;
+
+template<int I>
+struct DispatchTable<I>{
+	static void trigger(int typeId,EventNotice * pEvent,Simulator * pSimulator){
+		pEvent->trigger(pSimulator);
+	}
+	static bool canTrigger(int typeId,EventNotice * pEvent,Simulator * pSimulator){
+		return pEvent->canTrigger(pSimulator);
+	}
+	template<class T>
+	static constexpr int indexOf(){
+		return -1;
+	}
+};
+
+//类型标识只读取一次，内联后为同一变量的连续比较，编译器可以转换为跳转表
+template<int I,class E,class... Rest>
+struct DispatchTable<I,E,Rest...>{
+	static void trigger(int typeId,EventNotice * pEvent,Simulator * pSimulator){
+		if(typeId == I){
+			assert(typeid(*pEvent) == typeid(E));
+			EventCalls<E>::trigger(static_cast<E *>(pEvent),pSimulator);
+		}else{
+			DispatchTable<I + 1,Rest...>::trigger(typeId,pEvent,pSimulator);
+		}
+	}
+	static bool canTrigger(int typeId,EventNotice * pEvent,Simulator * pSimulator){
+		if(typeId == I){
+			assert(typeid(*pEvent) == typeid(E));
+			return EventCalls<E>::canTrigger(static_cast<E *>(pEvent),pSimulator);
+		}
+		return DispatchTable<I + 1,Rest...>::canTrigger(typeId,pEvent,pSimulator);
+	}
+	template<class T>
+	static constexpr int indexOf(){
+		return std::is_same<T,E>::value ? I : DispatchTable<I + 1,Rest...>::template indexOf<T>();
+	}
+};
+
+/**
+ * @brief 静态事件分派模板，Events为模型中所有需要直接分派的事件类型
+ */
+template<class... Events>
+class EventDispatcher{
+public:
+	/**
+	 * @brief 获得事件类型E的类型标识，E可以是不完整类型
+	 * @return int 事件类型标识，E不在类型列表中时返回-1
+	 */
+	template<class E>
+	static constexpr int typeIdOf(){
+		return DispatchTable<0,Events...>::template indexOf<E>();
+	}
+	/**
+	 * @brief 按照事件类型标识执行事件处理函数
+	 * @param  pEvent       事件对象指针
+	 * @param  pSimulator   仿真引擎对象指针
+	 */
+	static void trigger(EventNotice * pEvent,Simulator * pSimulator){
+		DispatchTable<0,Events...>::trigger(pEvent->getTypeId(),pEvent,pSimulator);
+	}
+	/**
+	 * @brief 按照事件类型标识判断事件是否满足发生条件
+	 * @param  pEvent       事件对象指针
+	 * @param  pSimulator   仿真引擎对象指针
+	 * @return true 	满足事件发生条件
+	 * @return false 	不满足事件发生条件
+	 */
+	static bool canTrigger(EventNotice * pEvent,Simulator * pSimulator){
+		return DispatchTable<0,Events...>::canTrigger(pEvent->getTypeId(),pEvent,pSimulator);
+	}
+};
+
+}
+
+#endif /* EVENT_DISPATCH_H_ */
@@ -46,6 +46,13 @@ public:
 	int getPriority() const {
 		return priority;
 	}
+	/**
+	 * @brief 设置事件优先级，应在调度事件之前设置
+	 * @param  p        事件优先级
+	 */
+	void setPriority(int p) {
+		priority = p;
+	}
 	/**
 	 * @brief 查询事件发生时间
 	 * @return double 事件发生时间
@@ -65,6 +72,13 @@ public:
 	bool isReserved(){
 		return reserved;
 	}
+	/**
+	 * @brief 设置事件在触发后是否需要保留
+	 * @param  r        true表示事件在触发后不会由仿真引擎删除
+	 */
+	void setReserved(bool r){
+		reserved = r;
+	}
 	/**
 	 * @brief 获得事件所属对象
 	 * @return void* 事件所属对象指针
@@ -92,6 +106,49 @@ public:
 	 */
 	void setName(const char * n){
 		name = n;
+		traceName = 0;
+	}
+	/**
+	 * @brief 获得BinaryTrace缓存的事件名称标识
+	 * @return uint64_t 高32位为跟踪对象序号，低32位为名称表序号，0表示未缓存
+	 */
+	uint64_t getTraceName() const {
+		return traceName;
+	}
+	/**
+	 * @brief 缓存BinaryTrace的事件名称标识，设置事件名称时清除
+	 * @param  id   高32位为跟踪对象序号，低32位为名称表序号
+	 */
+	void setTraceName(uint64_t id){
+		traceName = id;
+	}
+	/**
+	 * @brief 获得事件类型标识，用于EventDispatcher的静态分派
+	 * @return int 事件类型标识，-1表示未设置，按照虚函数分派
+	 */
+	int getTypeId() const {
+		return typeId;
+	}
+	/**
+	 * @brief 设置事件类型标识，通常由EventDispatcher::typeIdOf获得
+	 * @param  id   事件类型标识
+	 */
+	void setTypeId(int id){
+		typeId = id;
+	}
+	/**
+	 * @brief 获得冲突键，冲突键不同的同时事件修改互不相交的模型状态，可以并行执行
+	 * @return int 冲突键，-1表示未声明，可能与任何事件冲突
+	 */
+	int getConflictKey() const {
+		return conflictKey;
+	}
+	/**
+	 * @brief 设置冲突键，例如事件所属实体的序号，参见Simulator::setSimultaneousThreads
+	 * @param  key  冲突键，不小于0；-1表示可能与任何事件冲突
+	 */
+	void setConflictKey(int key){
+		conflictKey = key;
 	}
 	/**
 	 * @brief 当前系统状态是否满足事件发生条件
@@ -125,6 +182,18 @@ protected:
 	 * @brief 事件名称
 	 */
 	std::string name;
+	/**
+	 * @brief 事件类型标识，-1表示按照虚函数分派
+	 */
+	int typeId = -1;
+	/**
+	 * @brief 冲突键，-1表示可能与任何事件冲突
+	 */
+	int conflictKey = -1;
+	/**
+	 * @brief BinaryTrace缓存的事件名称标识，0表示未缓存
+	 */
+	uint64_t traceName = 0;
 };
 
 }
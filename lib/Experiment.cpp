@@ -0,0 +1,328 @@
+/**
+ * @file Experiment.cpp
+ * @brief 并行参数扫描与仿真实验设计类Factor、Design和Experiment的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Random.h"
+#include "Experiment.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+Factor::Factor(const char * name,double lower,double upper,int levels)
+		:name(name),lower(lower),upper(upper),discrete(false){
+	levels = levels < 1 ? 1 : levels;
+	for(int i = 0;i < levels;i ++){
+		values.push_back(levels == 1 ? lower : lower + i * (upper - lower) / (levels - 1));
+	}
+}
+
+Factor::Factor(const char * name,const vector<double> & values)
+		:name(name),values(values),discrete(true){
+	if(values.empty()){
+		printf("错误：实验因子（%s）没有取值\n",name);
+		exit(0);
+	}
+	lower = values.front();
+	upper = values.back();
+}
+
+double Factor::quantile(double u) const{
+	if(discrete){
+		int level = (int)(u * values.size());
+		return values[level < (int)values.size() ? level : values.size() - 1];
+	}
+	return lower + u * (upper - lower);
+}
+
+void Design::addPoint(const vector<double> & values){
+	if(values.size() != names.size()){
+		printf("错误：设计点的因子取值数量（%d）与因子数量（%d）不一致\n",(int)values.size(),(int)names.size());
+		exit(0);
+	}
+	points.push_back(values);
+}
+
+static vector<string> factorNames(const vector<Factor> & factors){
+	vector<string> names;
+	for(size_t f = 0;f < factors.size();f ++){
+		names.push_back(factors[f].getName());
+	}
+	return names;
+}
+
+Design Design::fullFactorial(const vector<Factor> & factors){
+	Design design(factorNames(factors));
+	if(factors.empty()){
+		return design;
+	}
+	//各因子的水平序号组成的计数器，最后一个因子变化最快
+	vector<int> levels(factors.size(),0);
+	vector<double> values(factors.size());
+	while(true){
+		for(size_t f = 0;f < factors.size();f ++){
+			values[f] = factors[f].getLevel(levels[f]);
+		}
+		design.addPoint(values);
+		int f = (int)factors.size() - 1;
+		while(f >= 0 && ++ levels[f] == factors[f].getLevelCount()){
+			levels[f] = 0;
+			f --;
+		}
+		if(f < 0){
+			break;
+		}
+	}
+	return design;
+}
+
+Design Design::latinHypercube(const vector<Factor> & factors,int samples,unsigned long seed){
+	Design design(factorNames(factors));
+	Random random(seed);
+	vector<vector<double>> columns(factors.size());
+	vector<int> strata(samples);
+	for(size_t f = 0;f < factors.size();f ++){
+		//每个因子独立随机排列各层，在层内均匀取分位点
+		for(int i = 0;i < samples;i ++){
+			strata[i] = i;
+		}
+		for(int i = samples - 1;i > 0;i --){
+			int j = random.nextInteger(0,i + 1);
+			int t = strata[i];
+			strata[i] = strata[j];
+			strata[j] = t;
+		}
+		for(int i = 0;i < samples;i ++){
+			columns[f].push_back(factors[f].quantile((strata[i] + random.nextDouble()) / samples));
+		}
+	}
+	vector<double> values(factors.size());
+	for(int i = 0;i < samples;i ++){
+		for(size_t f = 0;f < factors.size();f ++){
+			values[f] = columns[f][i];
+		}
+		design.addPoint(values);
+	}
+	return design;
+}
+
+double DesignPoint::get(const char * name) const{
+	const vector<string> & names = design->getNames();
+	for(size_t f = 0;f < names.size();f ++){
+		if(names[f] == name){
+			return design->getPoint(index)[f];
+		}
+	}
+	printf("错误：实验设计中没有因子（%s）\n",name);
+	exit(0);
+}
+
+Experiment::Experiment(const Design & design,ExperimentModel model,unsigned long seed,unsigned threads)
+		:design(design),model(model),seed(seed){
+	replications = 0;
+	commonRandomNumbers = false;
+	pool = new ThreadPool(threads);
+}
+
+Experiment::~Experiment(){
+	delete pool;
+	clear();
+}
+
+void Experiment::clear(){
+	for(size_t i = 0;i < jobs.size();i ++){
+		delete jobs[i];
+	}
+	for(size_t i = 0;i < summaries.size();i ++){
+		delete summaries[i];
+	}
+	jobs.clear();
+	summaries.clear();
+	metrics.clear();
+}
+
+unsigned long Experiment::jobSeed(int point,int replication){
+	if(commonRandomNumbers){
+		return ReplicationRunner::replicationSeed(seed,replication);
+	}
+	return ReplicationRunner::replicationSeed(ReplicationRunner::replicationSeed(seed,point),replication);
+}
+
+void Experiment::run(int replications){
+	clear();
+	this->replications = replications;
+	int points = design.getPointCount();
+	for(int p = 0;p < points;p ++){
+		for(int r = 0;r < replications;r ++){
+			jobs.push_back(new Replication(r,jobSeed(p,r)));
+		}
+	}
+	for(int p = 0;p < points;p ++){
+		for(int r = 0;r < replications;r ++){
+			Replication * job = jobs[p * replications + r];
+			pool->submit([this,p,job]{ model(DesignPoint(p,&design),job); });
+		}
+	}
+	pool->wait();
+
+	//按照作业顺序收集性能指标名称并汇总每个设计点的统计结果
+	for(size_t j = 0;j < jobs.size();j ++){
+		const vector<pair<string,double>> & values = jobs[j]->getValues();
+		for(size_t i = 0;i < values.size();i ++){
+			bool found = false;
+			for(size_t m = 0;m < metrics.size() && !found;m ++){
+				found = metrics[m] == values[i].first;
+			}
+			if(!found){
+				metrics.push_back(values[i].first);
+			}
+		}
+	}
+	for(int p = 0;p < points;p ++){
+		for(size_t m = 0;m < metrics.size();m ++){
+			Tally * summary = new Tally(metrics[m].c_str());
+			summary->reset(0);
+			for(int r = 0;r < replications;r ++){
+				double value;
+				if(jobs[p * replications + r]->getValue(metrics[m].c_str(),value)){
+					summary->update(value,r);
+				}
+			}
+			summaries.push_back(summary);
+		}
+	}
+}
+
+Tally * Experiment::getSummary(int point,const char * metric){
+	for(size_t m = 0;m < metrics.size();m ++){
+		if(metrics[m] == metric){
+			return summaries[point * metrics.size() + m];
+		}
+	}
+	return NULL;
+}
+
+void Experiment::getResults(ResultTable & table){
+	table.clear();
+	const vector<string> & names = design.getNames();
+	table.addColumn("point");
+	table.addColumn("replication");
+	table.addColumn("seed");
+	for(size_t f = 0;f < names.size();f ++){
+		table.addColumn(names[f].c_str());
+	}
+	int first = table.getColumnCount();
+	for(size_t m = 0;m < metrics.size();m ++){
+		table.addColumn(metrics[m].c_str());
+	}
+	for(size_t j = 0;j < jobs.size();j ++){
+		int p = (int)j / replications;
+		size_t row = table.addRow();
+		table.set(row,0,p);
+		table.set(row,1,jobs[j]->getIndex());
+		table.set(row,2,(double)jobs[j]->getSeed());
+		for(size_t f = 0;f < names.size();f ++){
+			table.set(row,3 + (int)f,design.getPoint(p)[f]);
+		}
+		for(size_t m = 0;m < metrics.size();m ++){
+			double value;
+			if(jobs[j]->getValue(metrics[m].c_str(),value)){
+				table.set(row,first + (int)m,value);
+			}
+		}
+	}
+}
+
+void Experiment::getSummaryTable(ResultTable & table,double level){
+	table.clear();
+	const vector<string> & names = design.getNames();
+	table.addColumn("point");
+	table.addColumn("replications");
+	for(size_t f = 0;f < names.size();f ++){
+		table.addColumn(names[f].c_str());
+	}
+	int first = table.getColumnCount();
+	for(size_t m = 0;m < metrics.size();m ++){
+		table.addColumn((metrics[m] + " mean").c_str());
+		table.addColumn((metrics[m] + " stdev").c_str());
+		table.addColumn((metrics[m] + " halfwidth").c_str());
+	}
+	for(int p = 0;p < design.getPointCount();p ++){
+		size_t row = table.addRow();
+		table.set(row,0,p);
+		table.set(row,1,replications);
+		for(size_t f = 0;f < names.size();f ++){
+			table.set(row,2 + (int)f,design.getPoint(p)[f]);
+		}
+		for(size_t m = 0;m < metrics.size();m ++){
+			Tally * summary = summaries[p * metrics.size() + m];
+			table.set(row,first + 3 * (int)m,summary->mean());
+			table.set(row,first + 3 * (int)m + 1,summary->stdDev());
+			if(summary->getObs() > 1){
+				table.set(row,first + 3 * (int)m + 2,summary->confidence(level));
+			}
+		}
+	}
+}
+
+void Experiment::report(double level){
+	string t(120,'-');
+	const vector<string> & names = design.getNames();
+	char confidence[32];
+	snprintf(confidence,sizeof(confidence),"CONFIDENCE%%%g",level * 100);
+	cout << "设计点数量：" << design.getPointCount() << "，每个设计点重复次数：" << replications
+		<< "，工作线程数量：" << pool->getThreadCount() << "，基础随机数种子：" << seed << endl;
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left) << setw(8) << "POINT";
+	for(size_t f = 0;f < names.size();f ++){
+		cout << setw(16) << names[f];
+	}
+	cout << resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	for(int p = 0;p < design.getPointCount();p ++){
+		cout << setiosflags(ios::left) << setw(8) << p;
+		for(size_t f = 0;f < names.size();f ++){
+			cout << setw(16) << design.getPoint(p)[f];
+		}
+		cout << resetiosflags(ios::left) << endl;
+	}
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(8) << "POINT"
+		<< setw(20) << "TITLE"
+		<< setw(8) << "REPS."
+		<< setw(16) << "MEAN"
+		<< setw(16) << "STDEV"
+		<< setw(16) << "MINIMUM"
+		<< setw(16) << "MAXIMUM"
+		<< setw(16) << confidence
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	for(int p = 0;p < design.getPointCount();p ++){
+		for(size_t m = 0;m < metrics.size();m ++){
+			Tally * summary = summaries[p * metrics.size() + m];
+			cout << setiosflags(ios::left)
+				<< setw(8) << p
+				<< setw(20) << summary->getTitle()
+				<< setw(8) << summary->getObs()
+				<< setw(16) << summary->mean()
+				<< setw(16) << summary->stdDev()
+				<< setw(16) << summary->min()
+				<< setw(16) << summary->max()
+				<< setw(16) << summary->confidence(level)
+				<< resetiosflags(ios::left) << endl;
+		}
+	}
+	cout << t.c_str() << endl;
+}
+
+}
@@ -0,0 +1,311 @@
+/**
+ * @file Experiment.h
+ * @brief 并行参数扫描与仿真实验设计类Factor、Design和Experiment
+ * Design由实验因子生成全因子设计或拉丁超立方设计，每个设计点为各因子的一组取值。
+ * Experiment将每个设计点的每次重复仿真作为一个作业，提交到工作窃取线程池并行运行，
+ * 作业的随机数种子由基础种子、设计点序号和重复序号确定，与线程数量和执行顺序无关；
+ * 设置公共随机数时种子只由基础种子和重复序号确定，各设计点的同一次重复仿真使用相同种子。
+ * 运行结果按照设计点和重复序号顺序整理为按列存储的结果表（每个作业一行），
+ * 以及每个设计点各性能指标的均值、标准差和置信区间半长汇总表。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef EXPERIMENT_H_
+#define EXPERIMENT_H_
+
+#include <string>
+#include <vector>
+#include <functional>
+#include "DataCollection.h"
+#include "Replication.h"
+#include "ResultTable.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 实验因子，取值为区间内的等间隔水平或指定的取值列表
+ */
+class Factor{
+private:
+	/**
+	 * @brief 因子名称
+	 */
+	std::string name;
+	/**
+	 * @brief 因子的各水平取值
+	 */
+	std::vector<double> values;
+	/**
+	 * @brief 因子取值区间，用于拉丁超立方设计
+	 */
+	double lower, upper;
+	/**
+	 * @brief 是否为指定的离散取值列表
+	 */
+	bool discrete;
+public:
+	/**
+	 * @brief 创建区间因子
+	 * @param  name     因子名称
+	 * @param  lower    取值下限
+	 * @param  upper    取值上限
+	 * @param  levels   全因子设计的水平数量，水平在[lower,upper]内等间隔分布
+	 */
+	Factor(const char * name,double lower,double upper,int levels = 2);
+	/**
+	 * @brief 创建离散取值因子
+	 * @param  name     因子名称
+	 * @param  values   因子的各水平取值
+	 */
+	Factor(const char * name,const std::vector<double> & values);
+	/**
+	 * @brief 获取因子名称
+	 * @return const char* 因子名称
+	 */
+	const char * getName() const{
+		return name.c_str();
+	}
+	/**
+	 * @brief 获取水平数量
+	 * @return int 水平数量
+	 */
+	int getLevelCount() const{
+		return (int)values.size();
+	}
+	/**
+	 * @brief 获取水平取值
+	 * @param  level    水平序号
+	 * @return double 水平取值
+	 */
+	double getLevel(int level) const{
+		return values[level];
+	}
+	/**
+	 * @brief 将[0,1)区间的分位点映射为因子取值，区间因子线性映射，离散因子等概率选择水平
+	 * @param  u    [0,1)区间的分位点
+	 * @return double 因子取值
+	 */
+	double quantile(double u) const;
+};
+
+/**
+ * @brief 实验设计，由设计点组成，每个设计点为各因子的一组取值
+ */
+class Design{
+private:
+	/**
+	 * @brief 因子名称
+	 */
+	std::vector<std::string> names;
+	/**
+	 * @brief 设计点列表
+	 */
+	std::vector<std::vector<double>> points;
+public:
+	/**
+	 * @brief 创建空的实验设计，由addPoint添加设计点
+	 * @param  names    因子名称
+	 */
+	Design(const std::vector<std::string> & names):names(names){
+	}
+	/**
+	 * @brief 添加设计点
+	 * @param  values   各因子取值，顺序与因子名称相同
+	 */
+	void addPoint(const std::vector<double> & values);
+	/**
+	 * @brief 获取设计点数量
+	 * @return int 设计点数量
+	 */
+	int getPointCount() const{
+		return (int)points.size();
+	}
+	/**
+	 * @brief 获取设计点
+	 * @param  point    设计点序号
+	 * @return 各因子取值
+	 */
+	const std::vector<double> & getPoint(int point) const{
+		return points[point];
+	}
+	/**
+	 * @brief 获取因子名称
+	 * @return 因子名称列表
+	 */
+	const std::vector<std::string> & getNames() const{
+		return names;
+	}
+	/**
+	 * @brief 生成全因子设计，包括各因子水平的全部组合，第一个因子变化最慢
+	 * @param  factors  实验因子
+	 * @return Design 实验设计
+	 */
+	static Design fullFactorial(const std::vector<Factor> & factors);
+	/**
+	 * @brief 生成拉丁超立方设计，每个因子的取值区间等分为samples层，每层恰好取一个设计点
+	 * @param  factors  实验因子
+	 * @param  samples  设计点数量
+	 * @param  seed     随机数种子
+	 * @return Design 实验设计
+	 */
+	static Design latinHypercube(const std::vector<Factor> & factors,int samples,unsigned long seed);
+};
+
+/**
+ * @brief 传递给模型的设计点
+ */
+class DesignPoint{
+private:
+	/**
+	 * @brief 设计点序号
+	 */
+	int index;
+	/**
+	 * @brief 所属实验设计
+	 */
+	const Design * design;
+public:
+	DesignPoint(int index,const Design * design):index(index),design(design){
+	}
+	/**
+	 * @brief 获取设计点序号
+	 * @return int 设计点序号
+	 */
+	int getIndex() const{
+		return index;
+	}
+	/**
+	 * @brief 获取因子取值
+	 * @param  name     因子名称
+	 * @return double 因子取值，没有该因子时打印错误并退出
+	 */
+	double get(const char * name) const;
+	/**
+	 * @brief 获取因子取值
+	 * @param  factor   因子序号
+	 * @return double 因子取值
+	 */
+	double get(int factor) const{
+		return design->getPoint(index)[factor];
+	}
+};
+
+/**
+ * @brief 实验模型函数，按照设计点的因子取值建立并运行一次仿真，通过Replication对象记录性能指标
+ */
+typedef std::function<void(const DesignPoint &,Replication *)> ExperimentModel;
+
+/**
+ * @brief 并行参数扫描实验类
+ */
+class Experiment{
+private:
+	/**
+	 * @brief 实验设计
+	 */
+	Design design;
+	/**
+	 * @brief 实验模型函数
+	 */
+	ExperimentModel model;
+	/**
+	 * @brief 基础随机数种子
+	 */
+	unsigned long seed;
+	/**
+	 * @brief 工作线程池
+	 */
+	ThreadPool * pool;
+	/**
+	 * @brief 每个设计点的重复次数
+	 */
+	int replications;
+	/**
+	 * @brief 是否在各设计点间使用公共随机数
+	 */
+	bool commonRandomNumbers;
+	/**
+	 * @brief 全部作业，按照设计点和重复序号排列
+	 */
+	std::vector<Replication *> jobs;
+	/**
+	 * @brief 性能指标名称，按照第一次记录的顺序排列
+	 */
+	std::vector<std::string> metrics;
+	/**
+	 * @brief 每个设计点各性能指标的汇总统计，下标为设计点序号*指标数量+指标序号
+	 */
+	std::vector<Tally *> summaries;
+
+	/**
+	 * @brief 删除作业和汇总统计
+	 */
+	void clear();
+public:
+	/**
+	 * @brief 创建参数扫描实验
+	 * @param  design   实验设计
+	 * @param  model    实验模型函数
+	 * @param  seed     基础随机数种子
+	 * @param  threads  工作线程数量，为0时等于处理器核数
+	 */
+	Experiment(const Design & design,ExperimentModel model,unsigned long seed,unsigned threads = 0);
+	~Experiment();
+	/**
+	 * @brief 并行运行全部设计点的指定次数重复仿真
+	 * @param  replications     每个设计点的重复次数
+	 */
+	void run(int replications);
+	/**
+	 * @brief 设置是否在各设计点间使用公共随机数，模型需要使用RandomStreams按照随机来源获取子流
+	 * @param  common   是否使用公共随机数
+	 */
+	void setCommonRandomNumbers(bool common){
+		commonRandomNumbers = common;
+	}
+	/**
+	 * @brief 获取作业的随机数种子
+	 * @param  point        设计点序号
+	 * @param  replication  重复序号
+	 * @return unsigned long 随机数种子
+	 */
+	unsigned long jobSeed(int point,int replication);
+	/**
+	 * @brief 获取设计点性能指标的汇总统计
+	 * @param  point    设计点序号
+	 * @param  metric   性能指标名称
+	 * @return Tally* 汇总统计，没有该性能指标时为NULL
+	 */
+	Tally * getSummary(int point,const char * metric);
+	/**
+	 * @brief 获取实验设计
+	 * @return const Design& 实验设计
+	 */
+	const Design & getDesign(){
+		return design;
+	}
+	/**
+	 * @brief 生成作业结果表，列为point、replication、seed、各因子和各性能指标
+	 * @param  table    结果表
+	 */
+	void getResults(ResultTable & table);
+	/**
+	 * @brief 生成设计点汇总表，列为point、各因子和各性能指标的均值、标准差及置信区间半长
+	 * @param  table    结果表
+	 * @param  level    置信水平
+	 */
+	void getSummaryTable(ResultTable & table,double level = 0.95);
+	/**
+	 * @brief 打印每个设计点各性能指标的均值、标准差、最小值、最大值和置信区间半长
+	 * @param  level    置信水平
+	 */
+	void report(double level = 0.95);
+};
+
+}
+
+#endif /* EXPERIMENT_H_ */
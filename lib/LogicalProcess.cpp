@@ -0,0 +1,139 @@
+/**
+ * @file LogicalProcess.cpp
+ * @brief 并行离散事件仿真的逻辑进程类LogicalProcess和通道类Channel的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <algorithm>
+#include "LogicalProcess.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+Channel::Channel(LogicalProcess * source,LogicalProcess * destination,double lookahead)
+		:source(source),destination(destination),lookahead(lookahead){
+	sentBound = -DBL_MAX;
+	clock = 0;
+}
+
+Channel::~Channel(){
+	for(size_t i = 0;i < messages.size();i ++){
+		delete messages[i].event;
+	}
+}
+
+void Channel::put(double bound,EventNotice * pEvent){
+	sentBound = bound > sentBound ? bound : sentBound;
+	lock_guard<std::mutex> lock(mutex);
+	messages.push_back(ChannelMessage{bound,pEvent,source->getId()});
+}
+
+bool Channel::take(vector<ChannelMessage> & received){
+	lock_guard<std::mutex> lock(mutex);
+	if(messages.empty()){
+		return false;
+	}
+	for(size_t i = 0;i < messages.size();i ++){
+		clock = messages[i].bound > clock ? messages[i].bound : clock;
+		received.push_back(messages[i]);
+	}
+	messages.clear();
+	return true;
+}
+
+LogicalProcess::LogicalProcess(int id,const char * name,unsigned long seed):id(id),name(name){
+	simulator = new Simulator(seed,NULL);
+	simulator->setOwner(this);
+	finished = false;
+	eventMessages = nullMessages = receivedMessages = 0;
+	rolledBackEvents = 0;
+}
+
+LogicalProcess::~LogicalProcess(){
+	delete simulator;
+}
+
+Channel * LogicalProcess::getOutput(LogicalProcess * destination){
+	for(size_t i = 0;i < outputs.size();i ++){
+		if(outputs[i]->getDestination() == destination){
+			return outputs[i];
+		}
+	}
+	return NULL;
+}
+
+void LogicalProcess::send(LogicalProcess * destination,EventNotice * pEvent){
+	if(destination == this){
+		simulator->scheduleEvent(pEvent);
+		return;
+	}
+	Channel * pChannel = getOutput(destination);
+	if(pChannel == NULL){
+		printf("错误：逻辑进程（%s）没有到逻辑进程（%s）的通道\n",name.c_str(),destination->getName());
+		exit(0);
+	}
+	//前瞻量是通道时间戳下界的依据，违反前瞻量的事件可能早于接收方已经推进到的时间
+	double bound = simulator->getClock() + pChannel->getLookahead();
+	if(pEvent->getTime() < bound){
+		printf("错误：逻辑进程（%s）在仿真时间%f发送的事件（%s）时间%f小于通道前瞻量%f\n",name.c_str(),
+				simulator->getClock(),pEvent->getName(),pEvent->getTime(),pChannel->getLookahead());
+		exit(0);
+	}
+	//本逻辑进程以后执行的事件时间不小于当前仿真时间，以后发送的消息时间戳不小于bound
+	pChannel->put(bound,pEvent);
+	eventMessages ++;
+}
+
+//事件消息按照时间和发送方序号排序，空消息排在最后
+static bool earlierMessage(const ChannelMessage & a,const ChannelMessage & b){
+	double ta = a.event != NULL ? a.event->getTime() : DBL_MAX;
+	double tb = b.event != NULL ? b.event->getTime() : DBL_MAX;
+	return ta < tb || (ta == tb && a.source < b.source);
+}
+
+bool LogicalProcess::receive(){
+	bool any = false;
+	received.clear();
+	for(size_t i = 0;i < inputs.size();i ++){
+		any |= inputs[i]->take(received);
+	}
+	stable_sort(received.begin(),received.end(),earlierMessage);
+	for(size_t m = 0;m < received.size() && received[m].event != NULL;m ++){
+		simulator->scheduleEvent(received[m].event);
+		receivedMessages ++;
+	}
+	return any;
+}
+
+double LogicalProcess::getSafeTime(){
+	double safe = DBL_MAX;
+	for(size_t i = 0;i < inputs.size();i ++){
+		if(inputs[i]->getClock() < safe){
+			safe = inputs[i]->getClock();
+		}
+	}
+	return safe;
+}
+
+bool LogicalProcess::sendNullMessages(double bound){
+	bool sent = false;
+	for(size_t i = 0;i < outputs.size();i ++){
+		double time = bound + outputs[i]->getLookahead();
+		if(time > outputs[i]->getSentBound()){
+			outputs[i]->put(time,NULL);
+			nullMessages ++;
+			sent = true;
+		}
+	}
+	return sent;
+}
+
+}
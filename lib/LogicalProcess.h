@@ -0,0 +1,352 @@
+/**
+ * @file LogicalProcess.h
+ * @brief 并行离散事件仿真的逻辑进程类LogicalProcess和逻辑进程间的通道类Channel
+ * 模型划分为若干逻辑进程，每个逻辑进程有自己的Simulator（仿真时钟和未来事件表），
+ * 逻辑进程之间通过单向通道发送带时间戳的EventNotice事件。每条通道声明前瞻量，
+ * 发送的事件时间戳不小于发送方当前仿真时间加前瞻量。每条消息同时携带发送方的承诺：
+ * 以后在本通道上发送的消息时间戳不小于该下界，通道时钟为接收方已收到的最大下界，
+ * 因此同一通道上的事件消息不必按照时间戳顺序发送。
+ * 事件处理函数通过Simulator::getOwner获得所属逻辑进程，调用send向其他逻辑进程发送事件，
+ * 修改模型状态之前调用saveState，使乐观并行仿真引擎能够在回滚时恢复状态。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef LOGICAL_PROCESS_H_
+#define LOGICAL_PROCESS_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include "EventNotice.h"
+#include "Simulator.h"
+#include "Random.h"
+
+namespace rubber_duck{
+
+class LogicalProcess;
+
+/**
+ * @brief 通道消息，事件为NULL时为空消息，只传递时间戳下界
+ */
+struct ChannelMessage{
+	/**
+	 * @brief 时间戳下界，发送方以后在本通道上发送的消息时间戳不小于该值
+	 */
+	double bound;
+	/**
+	 * @brief 消息事件，接收后调度到目的逻辑进程的未来事件表
+	 */
+	EventNotice * event;
+	/**
+	 * @brief 发送方逻辑进程序号
+	 */
+	int source;
+};
+
+/**
+ * @brief 逻辑进程间的单向先进先出通道
+ */
+class Channel{
+protected:
+	/**
+	 * @brief 发送方和接收方逻辑进程
+	 */
+	LogicalProcess * source, * destination;
+	/**
+	 * @brief 前瞻量，发送的消息时间戳不小于发送方仿真时间加前瞻量
+	 */
+	double lookahead;
+	/**
+	 * @brief 保护消息队列的互斥量
+	 */
+	std::mutex mutex;
+	/**
+	 * @brief 已发送尚未接收的消息
+	 */
+	std::deque<ChannelMessage> messages;
+	/**
+	 * @brief 发送方已发送的最大时间戳下界，只由发送方线程访问
+	 */
+	double sentBound;
+	/**
+	 * @brief 通道时钟，即接收方已接收的最大时间戳下界，只由接收方线程访问
+	 */
+	double clock;
+public:
+	/**
+	 * @brief 创建通道，由ParallelEngine::connect调用
+	 * @param  source       发送方逻辑进程
+	 * @param  destination  接收方逻辑进程
+	 * @param  lookahead    前瞻量，必须大于0
+	 */
+	Channel(LogicalProcess * source,LogicalProcess * destination,double lookahead);
+	/**
+	 * @brief 删除尚未接收的消息事件
+	 */
+	virtual ~Channel();
+	/**
+	 * @brief 发送消息，派生类可以通过其他传输方式发送
+	 * @param  bound    时间戳下界，事件消息的时间不小于该值
+	 * @param  pEvent   消息事件，NULL表示空消息
+	 */
+	virtual void put(double bound,EventNotice * pEvent);
+	/**
+	 * @brief 接收全部已到达的消息，更新通道时钟
+	 * @param  received     接收的消息，按照到达顺序追加
+	 * @return bool 是否接收到消息
+	 */
+	virtual bool take(std::vector<ChannelMessage> & received);
+	/**
+	 * @brief 获取发送方逻辑进程
+	 * @return LogicalProcess* 发送方逻辑进程
+	 */
+	LogicalProcess * getSource(){
+		return source;
+	}
+	/**
+	 * @brief 获取接收方逻辑进程
+	 * @return LogicalProcess* 接收方逻辑进程
+	 */
+	LogicalProcess * getDestination(){
+		return destination;
+	}
+	/**
+	 * @brief 获取通道前瞻量
+	 * @return double 前瞻量
+	 */
+	double getLookahead(){
+		return lookahead;
+	}
+	/**
+	 * @brief 获取发送方已发送的最大时间戳下界
+	 * @return double 时间戳下界，没有发送过消息时为-DBL_MAX
+	 */
+	double getSentBound(){
+		return sentBound;
+	}
+	/**
+	 * @brief 获取通道时钟，接收方以后从本通道接收的消息时间戳不小于通道时钟
+	 * @return double 通道时钟
+	 */
+	double getClock(){
+		return clock;
+	}
+};
+
+/**
+ * @brief 逻辑进程
+ */
+class LogicalProcess{
+protected:
+	/**
+	 * @brief 逻辑进程序号和名称
+	 */
+	int id;
+	std::string name;
+	/**
+	 * @brief 逻辑进程的仿真引擎
+	 */
+	Simulator * simulator;
+	/**
+	 * @brief 输入通道和输出通道
+	 */
+	std::vector<Channel *> inputs, outputs;
+	/**
+	 * @brief 接收消息的临时缓冲区
+	 */
+	std::vector<ChannelMessage> received;
+	/**
+	 * @brief 是否已推进到仿真结束时间
+	 */
+	bool finished;
+	/**
+	 * @brief 发送的事件消息、发送的空消息和接收的事件消息数量
+	 */
+	uint64_t eventMessages, nullMessages, receivedMessages;
+	/**
+	 * @brief 回滚撤销的事件数量，保守同步时为0
+	 */
+	uint64_t rolledBackEvents;
+public:
+	/**
+	 * @brief 创建逻辑进程，由ParallelEngine::addLogicalProcess调用
+	 * @param  id       逻辑进程序号
+	 * @param  name     逻辑进程名称
+	 * @param  seed     仿真引擎的随机数种子
+	 */
+	LogicalProcess(int id,const char * name,unsigned long seed);
+	/**
+	 * @brief 删除逻辑进程的仿真引擎及其未执行的事件
+	 */
+	virtual ~LogicalProcess();
+	/**
+	 * @brief 获取逻辑进程序号
+	 * @return int 逻辑进程序号
+	 */
+	int getId(){
+		return id;
+	}
+	/**
+	 * @brief 获取逻辑进程名称
+	 * @return const char* 逻辑进程名称
+	 */
+	const char * getName(){
+		return name.c_str();
+	}
+	/**
+	 * @brief 获取逻辑进程的仿真引擎，用于调度初始事件和本地事件
+	 * @return Simulator* 仿真引擎
+	 */
+	Simulator * getSimulator(){
+		return simulator;
+	}
+	/**
+	 * @brief 获取仿真引擎所属的逻辑进程
+	 * @param  pSimulator   仿真引擎
+	 * @return LogicalProcess* 逻辑进程，不属于逻辑进程时为NULL
+	 */
+	static LogicalProcess * of(Simulator * pSimulator){
+		return (LogicalProcess *)pSimulator->getOwner();
+	}
+	/**
+	 * @brief 添加输入通道
+	 * @param  pChannel     输入通道
+	 */
+	void addInput(Channel * pChannel){
+		inputs.push_back(pChannel);
+	}
+	/**
+	 * @brief 添加输出通道
+	 * @param  pChannel     输出通道
+	 */
+	void addOutput(Channel * pChannel){
+		outputs.push_back(pChannel);
+	}
+	/**
+	 * @brief 获取输入通道
+	 * @return 输入通道列表
+	 */
+	const std::vector<Channel *> & getInputs(){
+		return inputs;
+	}
+	/**
+	 * @brief 获取输出通道
+	 * @return 输出通道列表
+	 */
+	const std::vector<Channel *> & getOutputs(){
+		return outputs;
+	}
+	/**
+	 * @brief 获取到目的逻辑进程的输出通道
+	 * @param  destination  目的逻辑进程
+	 * @return Channel* 输出通道，没有连接时为NULL
+	 */
+	Channel * getOutput(LogicalProcess * destination);
+	/**
+	 * @brief 向其他逻辑进程发送事件，事件时间不能小于当前仿真时间加通道前瞻量；
+	 * 目的逻辑进程为本逻辑进程时直接调度事件
+	 * @param  destination  目的逻辑进程
+	 * @param  pEvent       发送的事件，由目的逻辑进程执行后删除
+	 */
+	virtual void send(LogicalProcess * destination,EventNotice * pEvent);
+	/**
+	 * @brief 接收全部输入通道已到达的消息，将事件按照时间和发送方序号排序后调度到本逻辑进程的
+	 * 未来事件表，同一发送方的事件保持发送顺序，时间相同的事件加入未来事件表的顺序与线程调度无关
+	 * @return bool 是否接收到消息
+	 */
+	virtual bool receive();
+	/**
+	 * @brief 在事件处理函数修改模型状态之前保存状态变量的当前值，回滚时恢复；
+	 * 保守同步不会回滚，不保存状态
+	 * @param  address  状态变量地址
+	 * @param  size     状态变量字节数
+	 */
+	virtual void saveState(void * address,size_t size){
+	}
+	/**
+	 * @brief 保存可以按字节复制的状态变量
+	 * @param  variable     状态变量
+	 */
+	template<class T>
+	void saveState(T & variable){
+		saveState(&variable,sizeof(T));
+	}
+	/**
+	 * @brief 保存随机数生成器的状态，事件处理函数使用随机数之前调用
+	 * @param  pRandom  随机数生成器
+	 */
+	void saveState(Random * pRandom){
+		saveState(*pRandom->getEngine());
+	}
+	/**
+	 * @brief 获取安全时间，即全部输入通道时钟的最小值，时间戳小于安全时间的事件可以安全执行
+	 * @return double 安全时间，没有输入通道时为DBL_MAX
+	 */
+	double getSafeTime();
+	/**
+	 * @brief 在全部输出通道上发送时间戳为bound加前瞻量的空消息，
+	 * 通道上已发送过不小于该时间戳的下界时不发送
+	 * @param  bound    本逻辑进程以后执行的事件时间下界
+	 * @return bool 是否发送了空消息
+	 */
+	bool sendNullMessages(double bound);
+	/**
+	 * @brief 是否已推进到仿真结束时间
+	 * @return bool 是否结束
+	 */
+	bool isFinished(){
+		return finished;
+	}
+	/**
+	 * @brief 设置是否已推进到仿真结束时间，由并行仿真引擎调用
+	 * @param  finished     是否结束
+	 */
+	void setFinished(bool finished){
+		this->finished = finished;
+	}
+	/**
+	 * @brief 获取发送到其他逻辑进程的事件消息数量
+	 * @return uint64_t 事件消息数量
+	 */
+	uint64_t getEventMessages(){
+		return eventMessages;
+	}
+	/**
+	 * @brief 获取发送的空消息数量
+	 * @return uint64_t 空消息数量
+	 */
+	uint64_t getNullMessages(){
+		return nullMessages;
+	}
+	/**
+	 * @brief 获取从其他逻辑进程接收的事件消息数量
+	 * @return uint64_t 事件消息数量
+	 */
+	uint64_t getReceivedMessages(){
+		return receivedMessages;
+	}
+	/**
+	 * @brief 获取回滚撤销的事件数量
+	 * @return uint64_t 事件数量
+	 */
+	uint64_t getRolledBackEvents(){
+		return rolledBackEvents;
+	}
+	/**
+	 * @brief 获取已提交（不会再回滚）的事件数量
+	 * @return uint64_t 事件数量
+	 */
+	uint64_t getCommittedEvents(){
+		return simulator->getEventCount() - rolledBackEvents;
+	}
+};
+
+}
+
+#endif /* LOGICAL_PROCESS_H_ */
@@ -0,0 +1,53 @@
+/**
+ * @file Monitor.cpp
+ * @brief 仿真运行监视器的公共函数
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <typeinfo>
+#include <stdio.h>
+#include <stdlib.h>
+#if defined(__GNUC__)
+	#include <cxxabi.h>
+#endif
+#include "Monitor.h"
+
+namespace rubber_duck{
+
+std::string getEventClassName(EventNotice * pEvent){
+	const char * name = typeid(*pEvent).name();
+#if defined(__GNUC__)
+	int status = 0;
+	char * demangled = abi::__cxa_demangle(name,NULL,NULL,&status);
+	if(status == 0 && demangled != NULL){
+		std::string result(demangled);
+		free(demangled);
+		return result;
+	}
+#endif
+	return std::string(name);
+}
+
+std::string jsonEscape(const char * s){
+	std::string result;
+	for(;*s != 0;s ++){
+		unsigned char c = (unsigned char)*s;
+		if(c == '"' || c == '\\'){
+			result += '\\';
+			result += (char)c;
+		}else if(c < 0x20){
+			char buf[8];
+			snprintf(buf,sizeof(buf),"\\u%04x",c);
+			result += buf;
+		}else{
+			result += (char)c;
+		}
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,127 @@
+/**
+ * @file Monitor.h
+ * @brief 仿真运行监视器接口类Monitor
+ * 监视器通过Simulator::addMonitor注册到仿真引擎，在事件调度、事件执行等
+ * 关键位置得到通知，用于跟踪记录、性能剖析等，未注册监视器时不影响仿真运行。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef MONITOR_H_
+#define MONITOR_H_
+
+#include <string>
+#include "EventNotice.h"
+
+namespace rubber_duck{
+
+class Simulator;
+class Resource;
+
+/**
+ * @brief 仿真运行监视器接口类，所有通知函数缺省为空操作
+ */
+class Monitor{
+public:
+	virtual ~Monitor(){}
+	/**
+	 * @brief 仿真开始运行
+	 * @param  pSimulator    仿真引擎对象指针
+	 */
+	virtual void runStarted(Simulator * pSimulator){};
+	/**
+	 * @brief 仿真运行结束
+	 * @param  pSimulator    仿真引擎对象指针
+	 */
+	virtual void runFinished(Simulator * pSimulator){};
+	/**
+	 * @brief 事件被调度到FEL或CEL
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pEvent        事件对象指针
+	 * @param  conditional   true表示调度到CEL，false表示调度到FEL
+	 */
+	virtual void eventScheduled(Simulator * pSimulator,EventNotice * pEvent,bool conditional){};
+	/**
+	 * @brief 事件调度被取消
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pEvent        事件对象指针
+	 */
+	virtual void eventCancelled(Simulator * pSimulator,EventNotice * pEvent){};
+	/**
+	 * @brief 事件即将执行，仿真时钟已经推进到事件时间
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pEvent        事件对象指针
+	 * @param  conditional   true表示CEL中的条件事件，false表示FEL中的未来事件
+	 */
+	virtual void eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional){};
+	/**
+	 * @brief 事件执行完成，此时事件对象尚未被仿真引擎删除
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pEvent        事件对象指针
+	 * @param  conditional   true表示CEL中的条件事件，false表示FEL中的未来事件
+	 */
+	virtual void eventTriggered(Simulator * pSimulator,EventNotice * pEvent,bool conditional){};
+	/**
+	 * @brief 扫描条件事件表时判断了条件事件的执行条件
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pEvent        条件事件对象指针
+	 * @param  result        条件判断结果，true表示满足执行条件
+	 */
+	virtual void conditionEvaluated(Simulator * pSimulator,EventNotice * pEvent,bool result){};
+	/**
+	 * @brief 开始扫描条件事件表，条件事件表为空时不扫描
+	 * @param  pSimulator    仿真引擎对象指针
+	 */
+	virtual void conditionalScanStarted(Simulator * pSimulator){};
+	/**
+	 * @brief 条件事件表扫描结束
+	 * @param  pSimulator    仿真引擎对象指针
+	 */
+	virtual void conditionalScanFinished(Simulator * pSimulator){};
+	/**
+	 * @brief 仿真引擎切换到CProcess进程的协程
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pProcess      进程对象指针
+	 */
+	virtual void processResumed(Simulator * pSimulator,EventNotice * pProcess){};
+	/**
+	 * @brief CProcess进程的协程切换回仿真引擎
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pProcess      进程对象指针
+	 */
+	virtual void processSuspended(Simulator * pSimulator,EventNotice * pProcess){};
+	/**
+	 * @brief 进程请求资源失败，开始等待资源
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pResource     资源对象指针
+	 * @param  pProcess      进程对象指针
+	 */
+	virtual void resourceWaitStarted(Simulator * pSimulator,Resource * pResource,EventNotice * pProcess){};
+	/**
+	 * @brief 等待资源的进程获得资源
+	 * @param  pSimulator    仿真引擎对象指针
+	 * @param  pResource     资源对象指针
+	 * @param  pProcess      进程对象指针
+	 */
+	virtual void resourceWaitFinished(Simulator * pSimulator,Resource * pResource,EventNotice * pProcess){};
+};
+
+/**
+ * @brief 获得事件对象的C++类名称
+ * @param  pEvent    事件对象指针
+ * @return std::string 事件类名称
+ */
+std::string getEventClassName(EventNotice * pEvent);
+/**
+ * @brief 将字符串转义为JSON字符串内容（不含两端的双引号）
+ * @param  s    字符串
+ * @return std::string 转义后的字符串
+ */
+std::string jsonEscape(const char * s);
+
+}
+
+#endif /* MONITOR_H_ */
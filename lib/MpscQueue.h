@@ -0,0 +1,155 @@
+/**
+ * @file MpscQueue.h
+ * @brief 无锁多生产者单消费者队列MpscQueue
+ * 生产者用比较交换把节点压入链表头部，不需要互斥锁；消费者用一次原子交换取走整个链表，
+ * 反转后按照压入顺序批量处理，每个生产者压入的元素保持先后顺序。链表头、生产者计数和
+ * 消费者计数分别占用独立的缓存行，避免生产者之间以及生产者与消费者之间的伪共享。
+ * 只有消费者摘取整个链表，不会出现单个节点出队的ABA问题。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef MPSC_QUEUE_H_
+#define MPSC_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+namespace rubber_duck{
+
+/**
+ * @brief 缓存行字节数
+ */
+#define MPSC_CACHE_LINE 64
+
+/**
+ * @brief 无锁多生产者单消费者队列
+ * @tparam T 元素类型，可以复制
+ */
+template<class T>
+class MpscQueue{
+private:
+	/**
+	 * @brief 链表节点
+	 */
+	struct Node{
+		T value;
+		Node * next;
+	};
+	/**
+	 * @brief 链表头，最后压入的节点
+	 */
+	alignas(MPSC_CACHE_LINE) std::atomic<Node *> head;
+	/**
+	 * @brief 压入的元素数量，由生产者更新
+	 */
+	alignas(MPSC_CACHE_LINE) std::atomic<uint64_t> pushed;
+	/**
+	 * @brief 取出的元素数量和批次数量，只由消费者访问
+	 */
+	alignas(MPSC_CACHE_LINE) uint64_t popped;
+	uint64_t batches;
+public:
+	MpscQueue():head(NULL),pushed(0),popped(0),batches(0){
+	}
+	/**
+	 * @brief 删除未取出的节点，不处理节点中的元素
+	 */
+	~MpscQueue(){
+		Node * node = head.exchange(NULL);
+		while(node != NULL){
+			Node * next = node->next;
+			delete node;
+			node = next;
+		}
+	}
+	MpscQueue(const MpscQueue &) = delete;
+	MpscQueue & operator=(const MpscQueue &) = delete;
+	/**
+	 * @brief 压入元素，可以由任意线程调用
+	 * @param  value    元素
+	 */
+	void push(const T & value){
+		Node * node = new Node{value,head.load(std::memory_order_relaxed)};
+		while(!head.compare_exchange_weak(node->next,node,std::memory_order_release,std::memory_order_relaxed)){
+		}
+		pushed.fetch_add(1,std::memory_order_relaxed);
+	}
+	/**
+	 * @brief 队列是否为空
+	 * @return bool 是否为空
+	 */
+	bool empty() const {
+		return head.load(std::memory_order_acquire) == NULL;
+	}
+	/**
+	 * @brief 取出全部元素，按照压入顺序交给consume处理，只能由消费者线程调用
+	 * @param  consume  处理元素的函数对象，参数为元素
+	 * @return size_t 取出的元素数量
+	 */
+	template<class F>
+	size_t drain(F consume){
+		Node * node = head.exchange(NULL,std::memory_order_acquire);
+		if(node == NULL){
+			return 0;
+		}
+		//反转链表，恢复压入顺序
+		Node * first = NULL;
+		while(node != NULL){
+			Node * next = node->next;
+			node->next = first;
+			first = node;
+			node = next;
+		}
+		size_t count = 0;
+		while(first != NULL){
+			Node * next = first->next;
+			consume(first->value);
+			delete first;
+			first = next;
+			count ++;
+		}
+		popped += count;
+		batches ++;
+		return count;
+	}
+	/**
+	 * @brief 遍历未取出的元素（从最后压入的元素开始），只能在没有生产者和消费者并发访问时调用
+	 * @param  visit    访问元素的函数对象，参数为元素
+	 */
+	template<class F>
+	void forEach(F visit) const {
+		for(Node * node = head.load(std::memory_order_acquire);node != NULL;node = node->next){
+			visit(node->value);
+		}
+	}
+	/**
+	 * @brief 获取压入的元素数量
+	 * @return uint64_t 元素数量
+	 */
+	uint64_t getPushed() const {
+		return pushed.load(std::memory_order_relaxed);
+	}
+	/**
+	 * @brief 获取取出的元素数量，只能由消费者线程调用
+	 * @return uint64_t 元素数量
+	 */
+	uint64_t getPopped() const {
+		return popped;
+	}
+	/**
+	 * @brief 获取批量取出的次数，只能由消费者线程调用
+	 * @return uint64_t 批次数量
+	 */
+	uint64_t getBatches() const {
+		return batches;
+	}
+};
+
+}
+
+#endif /* MPSC_QUEUE_H_ */
@@ -0,0 +1,340 @@
+/**
+ * @file MultiProcessEngine.cpp
+ * @brief 共享内存多进程保守同步并行仿真引擎MultiProcessEngine的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#ifndef _WIN32
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+#include "EventCodec.h"
+#include "ThreadPool.h"
+#include "MultiProcessEngine.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+ShmChannel::ShmChannel(LogicalProcess * source,LogicalProcess * destination,double lookahead,size_t capacity)
+		:Channel(source,destination,lookahead),ring(capacity){
+}
+
+void ShmChannel::put(double bound,EventNotice * pEvent){
+	sentBound = bound > sentBound ? bound : sentBound;
+	record.clear();
+	EventCodec::put(record,bound);
+	if(pEvent != NULL){
+		EventCodec::encode(pEvent,record);
+		delete pEvent;
+	}
+	//保持消息顺序：有暂存的消息时先写入暂存的消息
+	if(!pending.empty()){
+		flush();
+	}
+	if(pending.empty() && (ring.isClosed() || ring.write(record.data(),record.size()))){
+		return;
+	}
+	pending.push_back(record);
+}
+
+bool ShmChannel::take(vector<ChannelMessage> & received){
+	bool any = false;
+	while(ring.read(record)){
+		const char * bytes = record.data();
+		double bound;
+		EventCodec::get(bytes,record.data() + record.size(),bound);
+		EventNotice * pEvent = NULL;
+		if(record.size() > sizeof(double)){
+			pEvent = EventCodec::decode(bytes,record.size() - sizeof(double));
+		}
+		clock = bound > clock ? bound : clock;
+		received.push_back(ChannelMessage{bound,pEvent,source->getId()});
+		any = true;
+	}
+	return any;
+}
+
+bool ShmChannel::flush(){
+	bool progress = false;
+	while(!pending.empty()){
+		if(ring.isClosed()){
+			pending.clear();
+			return true;
+		}
+		if(!ring.write(pending.front().data(),pending.front().size())){
+			break;
+		}
+		pending.pop_front();
+		progress = true;
+	}
+	return progress;
+}
+
+void ShmChannel::reset(){
+	pending.clear();
+	ring.clear();
+}
+
+MultiProcessEngine::MultiProcessEngine(size_t ringBytes):ringBytes(ringBytes){
+	failures = 0;
+}
+
+MultiProcessEngine::~MultiProcessEngine(){
+	for(size_t i = 0;i < resultRings.size();i ++){
+		delete resultRings[i];
+	}
+}
+
+bool MultiProcessEngine::flushLocal(){
+	bool progress = false;
+	for(size_t i = 0;i < local.size();i ++){
+		if(local[i]->hasPending()){
+			progress |= local[i]->flush();
+		}
+	}
+	return progress;
+}
+
+bool MultiProcessEngine::advance(LogicalProcess * lp){
+	//本分区其他已结束的逻辑进程也可能有暂存的消息
+	bool progress = flushLocal();
+	progress |= ConservativeEngine::advance(lp);
+	if(lp->isFinished()){
+		const vector<Channel *> & inputs = lp->getInputs();
+		for(size_t i = 0;i < inputs.size();i ++){
+			static_cast<ShmChannel *>(inputs[i])->close();
+		}
+	}
+	return progress;
+}
+
+void MultiProcessEngine::runPartition(unsigned partition){
+#ifndef _WIN32
+	local.clear();
+	for(size_t i = 0;i < channels.size();i ++){
+		if((unsigned)channels[i]->getSource()->getId() % threadCount == partition){
+			local.push_back(static_cast<ShmChannel *>(channels[i]));
+		}
+	}
+	runThread(partition);
+	//全部逻辑进程结束后，继续写入接收方尚未结束的通道上暂存的消息
+	while(true){
+		flushLocal();
+		bool remaining = false;
+		for(size_t i = 0;i < local.size();i ++){
+			remaining |= local[i]->hasPending();
+		}
+		if(!remaining){
+			break;
+		}
+		this_thread::yield();
+	}
+	string record;
+	for(size_t i = partition;i < processes.size();i += threadCount){
+		LogicalProcess * lp = processes[i];
+		record.clear();
+		EventCodec::put(record,(int32_t)lp->getId());
+		EventCodec::put(record,lp->getSimulator()->getEventCount());
+		EventCodec::put(record,lp->getEventMessages());
+		EventCodec::put(record,lp->getNullMessages());
+		EventCodec::put(record,lp->getReceivedMessages());
+		EventCodec::put(record,lp->getSimulator()->getClock());
+		if(collector){
+			collector(lp,record);
+		}
+		if(!resultRings[partition]->write(record.data(),record.size())){
+			printf("错误：分区进程%u的结果超过结果缓冲区的容量（%zu字节）\n",partition,ringBytes);
+			fflush(NULL);
+			_exit(1);
+		}
+	}
+	//不执行父进程复制来的退出处理和静态对象析构
+	fflush(NULL);
+	_exit(0);
+#endif
+}
+
+void MultiProcessEngine::run(double endTime,unsigned partitions){
+#ifndef _WIN32
+	this->endTime = endTime;
+	partitions = partitions == 0 ? ThreadPool::hardwareThreads() : partitions;
+	threadCount = partitions < processes.size() ? partitions : (unsigned)processes.size();
+	for(size_t i = 0;i < processes.size();i ++){
+		processes[i]->setFinished(false);
+	}
+	for(size_t i = 0;i < channels.size();i ++){
+		static_cast<ShmChannel *>(channels[i])->reset();
+	}
+	while(resultRings.size() < threadCount){
+		resultRings.push_back(new ShmRing(ringBytes));
+	}
+	for(unsigned p = 0;p < threadCount;p ++){
+		resultRings[p]->clear();
+	}
+	results.assign(processes.size(),ProcessResult());
+	failures = 0;
+	//避免子进程重复输出父进程缓冲区中的内容
+	fflush(NULL);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<pid_t> children(threadCount,-1);
+	for(unsigned p = 0;p < threadCount;p ++){
+		pid_t pid = fork();
+		if(pid == 0){
+			runPartition(p);
+		}
+		if(pid < 0){
+			printf("错误：创建分区进程%u失败：%s\n",p,strerror(errno));
+			for(unsigned q = 0;q < p;q ++){
+				kill(children[q],SIGKILL);
+				waitpid(children[q],NULL,0);
+			}
+			exit(0);
+		}
+		children[p] = pid;
+	}
+	//等待全部分区进程结束，一个分区进程异常终止时其他分区进程无法继续推进，全部终止
+	vector<bool> failed(threadCount,false);
+	unsigned remaining = threadCount;
+	bool aborted = false;
+	while(remaining > 0){
+		int status = 0;
+		pid_t pid = waitpid(-1,&status,0);
+		if(pid < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			break;
+		}
+		unsigned p = 0;
+		while(p < threadCount && children[p] != pid){
+			p ++;
+		}
+		if(p == threadCount){
+			continue;
+		}
+		children[p] = -1;
+		remaining --;
+		if(WIFEXITED(status) && WEXITSTATUS(status) == 0){
+			continue;
+		}
+		failed[p] = true;
+		failures ++;
+		if(aborted){
+			continue;
+		}
+		if(WIFSIGNALED(status)){
+			printf("错误：分区进程%u（pid %d）被信号%d终止\n",p,(int)pid,WTERMSIG(status));
+		}else{
+			printf("错误：分区进程%u（pid %d）的退出码为%d\n",p,(int)pid,WEXITSTATUS(status));
+		}
+		aborted = true;
+		for(unsigned q = 0;q < threadCount;q ++){
+			if(children[q] > 0){
+				kill(children[q],SIGKILL);
+			}
+		}
+	}
+	wallTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	string record;
+	for(unsigned p = 0;p < threadCount;p ++){
+		while(resultRings[p]->read(record)){
+			const char * bytes = record.data();
+			const char * end = record.data() + record.size();
+			int32_t id;
+			EventCodec::get(bytes,end,id);
+			if(id < 0 || (size_t)id >= results.size()){
+				printf("错误：分区进程返回结果的逻辑进程序号（%d）无效\n",(int)id);
+				exit(0);
+			}
+			ProcessResult & result = results[id];
+			EventCodec::get(bytes,end,result.events);
+			EventCodec::get(bytes,end,result.eventMessages);
+			EventCodec::get(bytes,end,result.nullMessages);
+			EventCodec::get(bytes,end,result.receivedMessages);
+			EventCodec::get(bytes,end,result.clock);
+			result.data.assign(bytes,record.data() + record.size() - bytes);
+			result.received = true;
+		}
+	}
+	//分区进程调用exit退出时（例如模型报错）退出码为0，但没有返回结果
+	for(size_t i = 0;i < processes.size();i ++){
+		unsigned p = (unsigned)(i % threadCount);
+		if(!results[i].received && !failed[p]){
+			printf("错误：分区进程%u没有返回逻辑进程（%s）的结果\n",p,processes[i]->getName());
+			failed[p] = true;
+			failures ++;
+		}
+	}
+#else
+	printf("错误：多进程并行仿真引擎只支持POSIX系统\n");
+	exit(0);
+#endif
+}
+
+uint64_t MultiProcessEngine::getEventCount(){
+	uint64_t count = 0;
+	for(size_t i = 0;i < results.size();i ++){
+		count += results[i].events;
+	}
+	return count;
+}
+
+uint64_t MultiProcessEngine::getNullMessageCount(){
+	uint64_t count = 0;
+	for(size_t i = 0;i < results.size();i ++){
+		count += results[i].nullMessages;
+	}
+	return count;
+}
+
+void MultiProcessEngine::report(){
+	string t(106,'-');
+	cout << "同步协议：" << getProtocol() << "，逻辑进程数量：" << processes.size() << "，通道数量：" << channels.size()
+		<< "，分区进程数量：" << threadCount << "，仿真结束时间：" << endTime << endl;
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(6) << "LP"
+		<< setw(20) << "NAME"
+		<< setw(12) << "PARTITION"
+		<< setw(16) << "EVENTS"
+		<< setw(16) << "SENT"
+		<< setw(16) << "RECEIVED"
+		<< setw(14) << "NULLS"
+		<< setw(14) << "CLOCK"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	for(size_t i = 0;i < results.size();i ++){
+		const ProcessResult & result = results[i];
+		cout << setiosflags(ios::left)
+			<< setw(6) << i
+			<< setw(20) << processes[i]->getName()
+			<< setw(12) << (threadCount > 0 ? i % threadCount : 0)
+			<< setw(16) << result.events
+			<< setw(16) << result.eventMessages
+			<< setw(16) << result.receivedMessages
+			<< setw(14) << result.nullMessages
+			<< setw(14) << result.clock
+			<< resetiosflags(ios::left) << endl;
+	}
+	cout << t.c_str() << endl;
+	uint64_t events = getEventCount();
+	cout << "事件数量：" << events << "，空消息数量：" << getNullMessageCount() << "，墙钟时间：" << wallTime
+		<< "秒，事件处理速率：" << (wallTime > 0 ? events / wallTime : 0) << "事件/秒，失败的分区进程数量：" << failures << endl;
+}
+
+}
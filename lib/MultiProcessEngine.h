@@ -0,0 +1,246 @@
+/**
+ * @file MultiProcessEngine.h
+ * @brief 共享内存多进程保守同步并行仿真引擎MultiProcessEngine
+ * 逻辑进程按照序号轮流划分为若干分区，每个分区由fork创建的一个操作系统进程运行，
+ * 分区进程内按照ConservativeEngine的空消息协议推进分配给自己的逻辑进程。
+ * 每条通道是一个POSIX共享内存环形缓冲区（ShmRing），消息事件按照EventCodec注册的类型编码后传送，
+ * 因此跨进程发送的事件类型必须在run之前注册。每个分区进程有模型全局变量的独立副本，
+ * 模型代码中的全局状态不会在分区之间共享；某个分区进程异常终止时，父进程终止其他分区进程并报告失败。
+ * 父进程中的模型在run之后保持初始状态，可以再次运行。分区进程结束前按照逻辑进程调用收集函数，
+ * 将模型结果编码为字节序列，由父进程通过getResult获取。
+ * 环形缓冲区已满时，消息暂存在发送方进程中，在以后推进逻辑进程时继续写入，发送方不会阻塞，
+ * 接收方逻辑进程推进到结束时间后关闭其输入通道，发送方丢弃以后的消息。
+ * 应在创建其他线程之前运行，fork只复制调用线程。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef MULTI_PROCESS_ENGINE_H_
+#define MULTI_PROCESS_ENGINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include "ConservativeEngine.h"
+#include "ShmRing.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 共享内存通道，消息记录为时间戳下界和编码的事件，只有时间戳下界的记录为空消息
+ */
+class ShmChannel:public Channel{
+private:
+	/**
+	 * @brief 共享内存环形缓冲区
+	 */
+	ShmRing ring;
+	/**
+	 * @brief 环形缓冲区已满时暂存的消息记录，只由发送方进程访问
+	 */
+	std::deque<std::string> pending;
+	/**
+	 * @brief 编码和读取消息记录的缓冲区
+	 */
+	std::string record;
+public:
+	/**
+	 * @brief 创建共享内存通道
+	 * @param  source       发送方逻辑进程
+	 * @param  destination  接收方逻辑进程
+	 * @param  lookahead    前瞻量
+	 * @param  capacity     环形缓冲区字节数
+	 */
+	ShmChannel(LogicalProcess * source,LogicalProcess * destination,double lookahead,size_t capacity);
+	/**
+	 * @brief 编码并发送消息，删除消息事件
+	 * @param  bound    时间戳下界
+	 * @param  pEvent   消息事件，NULL表示空消息
+	 */
+	virtual void put(double bound,EventNotice * pEvent);
+	/**
+	 * @brief 读取并解码全部已到达的消息，更新通道时钟
+	 * @param  received     接收的消息，按照到达顺序追加
+	 * @return bool 是否接收到消息
+	 */
+	virtual bool take(std::vector<ChannelMessage> & received);
+	/**
+	 * @brief 将暂存的消息写入环形缓冲区，接收方已关闭时丢弃
+	 * @return bool 是否写入或丢弃了消息
+	 */
+	bool flush();
+	/**
+	 * @brief 是否有暂存的消息
+	 * @return bool 是否有暂存的消息
+	 */
+	bool hasPending(){
+		return !pending.empty();
+	}
+	/**
+	 * @brief 接收方关闭通道
+	 */
+	void close(){
+		ring.close();
+	}
+	/**
+	 * @brief 清空通道，重新运行之前由父进程调用
+	 */
+	void reset();
+};
+
+/**
+ * @brief 分区进程返回的逻辑进程结果
+ */
+struct ProcessResult{
+	/**
+	 * @brief 是否收到结果
+	 */
+	bool received;
+	/**
+	 * @brief 执行的事件数量、发送的事件消息数量、发送的空消息数量和接收的事件消息数量
+	 */
+	uint64_t events, eventMessages, nullMessages, receivedMessages;
+	/**
+	 * @brief 结束时的仿真时钟
+	 */
+	double clock;
+	/**
+	 * @brief 收集函数编码的模型结果
+	 */
+	std::string data;
+};
+
+/**
+ * @brief 共享内存多进程保守同步并行仿真引擎
+ */
+class MultiProcessEngine:public ConservativeEngine{
+public:
+	/**
+	 * @brief 模型结果收集函数，在分区进程中调用，将逻辑进程的模型结果追加到bytes
+	 */
+	typedef std::function<void(LogicalProcess * lp,std::string & bytes)> Collector;
+private:
+	/**
+	 * @brief 每条通道环形缓冲区的字节数
+	 */
+	size_t ringBytes;
+	/**
+	 * @brief 各分区进程返回结果的环形缓冲区
+	 */
+	std::vector<ShmRing *> resultRings;
+	/**
+	 * @brief 各逻辑进程的结果，下标为逻辑进程序号
+	 */
+	std::vector<ProcessResult> results;
+	/**
+	 * @brief 模型结果收集函数
+	 */
+	Collector collector;
+	/**
+	 * @brief 最近一次运行异常终止或没有返回结果的分区进程数量
+	 */
+	unsigned failures;
+	/**
+	 * @brief 分区进程中发送方属于本分区的通道
+	 */
+	std::vector<ShmChannel *> local;
+	/**
+	 * @brief 写入本分区全部通道暂存的消息
+	 * @return bool 是否写入或丢弃了消息
+	 */
+	bool flushLocal();
+	/**
+	 * @brief 分区进程的主函数，推进分配给本分区的逻辑进程，返回结果后退出进程
+	 * @param  partition    分区序号
+	 */
+	void runPartition(unsigned partition);
+protected:
+	/**
+	 * @brief 创建共享内存通道
+	 */
+	virtual Channel * createChannel(LogicalProcess * source,LogicalProcess * destination,double lookahead){
+		return new ShmChannel(source,destination,lookahead,ringBytes);
+	}
+	/**
+	 * @brief 写入暂存的消息，按照空消息协议推进逻辑进程，推进到结束时间后关闭输入通道
+	 * @param  lp   逻辑进程
+	 * @return bool 是否有进展
+	 */
+	virtual bool advance(LogicalProcess * lp);
+public:
+	/**
+	 * @brief 创建多进程并行仿真引擎
+	 * @param  ringBytes    每条通道和每个分区结果的环形缓冲区字节数
+	 */
+	MultiProcessEngine(size_t ringBytes = 1 << 20);
+	/**
+	 * @brief 删除结果环形缓冲区
+	 */
+	virtual ~MultiProcessEngine();
+	/**
+	 * @brief 设置模型结果收集函数
+	 * @param  collector    收集函数
+	 */
+	void setCollector(Collector collector){
+		this->collector = collector;
+	}
+	/**
+	 * @brief 创建分区进程并行运行仿真，等待全部分区进程结束，父进程中的模型状态不变
+	 * @param  endTime      仿真结束时间
+	 * @param  partitions   分区进程数量，为0时等于处理器核数，大于逻辑进程数量时等于逻辑进程数量
+	 */
+	virtual void run(double endTime,unsigned partitions = 0);
+	/**
+	 * @brief 最近一次运行的全部分区进程是否正常结束并返回了结果
+	 * @return bool 是否成功
+	 */
+	bool isSucceeded(){
+		return failures == 0;
+	}
+	/**
+	 * @brief 获取逻辑进程的结果
+	 * @param  id   逻辑进程序号
+	 * @return const ProcessResult& 结果
+	 */
+	const ProcessResult & getResult(int id){
+		return results[id];
+	}
+	/**
+	 * @brief 获取全部逻辑进程执行的事件数量
+	 * @return uint64_t 事件数量
+	 */
+	virtual uint64_t getEventCount();
+	/**
+	 * @brief 获取全部逻辑进程执行的事件数量，保守同步没有回滚
+	 * @return uint64_t 事件数量
+	 */
+	virtual uint64_t getProcessedEventCount(){
+		return getEventCount();
+	}
+	/**
+	 * @brief 获取全部逻辑进程发送的空消息数量
+	 * @return uint64_t 空消息数量
+	 */
+	virtual uint64_t getNullMessageCount();
+	/**
+	 * @brief 获取同步协议名称
+	 * @return const char* 协议名称
+	 */
+	virtual const char * getProtocol(){
+		return "CMB NULL MESSAGE (SHARED MEMORY PROCESSES)";
+	}
+	/**
+	 * @brief 打印分区进程返回的各逻辑进程统计结果
+	 */
+	virtual void report();
+};
+
+}
+
+#endif /* MULTI_PROCESS_ENGINE_H_ */
@@ -0,0 +1,227 @@
+/**
+ * @file OptimisticProcess.cpp
+ * @brief 乐观并行仿真（Time Warp）的逻辑进程类OptimisticProcess的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include "OptimisticProcess.h"
+#include "ProcessNotice.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+OptimisticProcess::OptimisticProcess(int id,const char * name,unsigned long seed):LogicalProcess(id,name,seed){
+	executing = false;
+	rollbacks = antiMessages = 0;
+	simulator->addMonitor(this);
+}
+
+OptimisticProcess::~OptimisticProcess(){
+	//未提交的事件已经从未来事件表中移出，反消息指向的事件由其所在的逻辑进程删除；
+	//保留的事件可能已经重新调度，与提交时相同不删除
+	for(size_t i = 0;i < processed.size();i ++){
+		if(!processed[i].event->isReserved()){
+			delete processed[i].event;
+		}
+	}
+	inbox.drain([](const OptimisticMessage & message){
+		if(!message.anti){
+			delete message.event;
+		}
+	});
+	simulator->removeMonitor(this);
+}
+
+void OptimisticProcess::send(LogicalProcess * destination,EventNotice * pEvent){
+	if(destination == this){
+		simulator->scheduleEvent(pEvent);
+		return;
+	}
+	if(pEvent->getTime() < simulator->getClock()){
+		printf("错误：逻辑进程（%s）在仿真时间%f发送的事件（%s）时间%f小于当前仿真时间\n",name.c_str(),
+				simulator->getClock(),pEvent->getName(),pEvent->getTime());
+		exit(0);
+	}
+	OptimisticProcess * pDestination = (OptimisticProcess *)destination;
+	if(executing){
+		sent.push_back(SentMessage{pDestination,pEvent});
+	}
+	pDestination->post(OptimisticMessage{pEvent,false});
+	eventMessages ++;
+}
+
+void OptimisticProcess::post(const OptimisticMessage & message){
+	inbox.push(message);
+}
+
+bool OptimisticProcess::receive(){
+	taken.clear();
+	if(inbox.drain([this](const OptimisticMessage & message){ taken.push_back(message); }) == 0){
+		return false;
+	}
+	//同一发送方的消息先于其反消息放入收件箱，反消息到达时对应的事件已经接收
+	for(size_t i = 0;i < taken.size();i ++){
+		if(taken[i].anti){
+			annihilate(taken[i].event);
+		}else{
+			rollback(taken[i].event->getTime());
+			simulator->scheduleEvent(taken[i].event);
+			receivedMessages ++;
+		}
+	}
+	taken.clear();
+	return true;
+}
+
+void OptimisticProcess::saveState(void * address,size_t size){
+	if(!executing){
+		return;
+	}
+	states.push_back(SavedState{address,size,bytes.size()});
+	bytes.insert(bytes.end(),(char *)address,(char *)address + size);
+}
+
+void OptimisticProcess::eventScheduled(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	if(executing){
+		scheduled.push_back(pEvent);
+	}
+}
+
+bool OptimisticProcess::executeNextEvent(double limit){
+	if(simulator->getNextEventTime() > limit){
+		return false;
+	}
+	processed.push_back(ProcessedEvent{NULL,simulator->getNextEventTime(),states.size(),bytes.size(),
+			scheduled.size(),sent.size()});
+	executing = true;
+	EventNotice * pEvent = simulator->executeNextEvent();
+	executing = false;
+	processed.back().event = pEvent;
+	if(pEvent->isReserved() && dynamic_cast<ProcessNotice *>(pEvent) != NULL){
+		printf("错误：逻辑进程（%s）执行了进程（%s），乐观并行仿真不能回滚进程的推进状态\n",name.c_str(),
+				pEvent->getName());
+		exit(0);
+	}
+	return true;
+}
+
+void OptimisticProcess::undoLast(){
+	ProcessedEvent & record = processed.back();
+	//按照与保存相反的顺序恢复状态变量，同一变量多次保存时恢复为最早的旧值
+	for(size_t i = states.size();i > record.stateBegin;i --){
+		SavedState & state = states[i - 1];
+		memcpy(state.address,&bytes[state.offset],state.size);
+	}
+	states.resize(record.stateBegin);
+	bytes.resize(record.byteBegin);
+	//回滚事件调度的本地事件如果已执行，已经先于本记录回滚并重新加入未来事件表；
+	//保留的事件重新调度自身时只从未来事件表中取消，下面按照执行时的时间重新加入
+	for(size_t i = scheduled.size();i > record.scheduledBegin;i --){
+		simulator->cancelEvent(scheduled[i - 1]);
+		if(scheduled[i - 1] != record.event){
+			delete scheduled[i - 1];
+		}
+	}
+	scheduled.resize(record.scheduledBegin);
+	for(size_t i = record.sentBegin;i < sent.size();i ++){
+		sent[i].destination->post(OptimisticMessage{sent[i].event,true});
+		antiMessages ++;
+	}
+	sent.resize(record.sentBegin);
+	EventNotice * pEvent = record.event;
+	pEvent->setTime(record.time);
+	processed.pop_back();
+	simulator->scheduleEvent(pEvent);
+	rolledBackEvents ++;
+}
+
+void OptimisticProcess::rollback(double time){
+	//湮灭后仿真时钟可能大于最后一条处理记录的时间，先回退到消息时间
+	simulator->rollbackClock(time);
+	//时间相同的迟到消息排在已执行事件之后，不需要回滚
+	if(processed.empty() || processed.back().time <= time){
+		return;
+	}
+	rollbacks ++;
+	while(!processed.empty() && processed.back().time > time){
+		undoLast();
+	}
+}
+
+void OptimisticProcess::annihilate(EventNotice * pEvent){
+	//处理记录按照事件时间非减排列，只需要查找时间不小于被撤销事件的记录
+	bool executed = false;
+	for(size_t i = processed.size();i > 0 && processed[i - 1].time >= pEvent->getTime();i --){
+		if(processed[i - 1].event == pEvent){
+			executed = true;
+			break;
+		}
+	}
+	if(executed){
+		rollbacks ++;
+		simulator->rollbackClock(pEvent->getTime());
+		bool last = false;
+		while(!last){
+			last = processed.back().event == pEvent;
+			undoLast();
+		}
+	}
+	simulator->cancelEvent(pEvent);
+	delete pEvent;
+}
+
+double OptimisticProcess::getMinimumTime(){
+	double time = simulator->getNextEventTime();
+	//在屏障处调用，此时没有线程访问收件箱
+	inbox.forEach([&time](const OptimisticMessage & message){
+		if(message.event->getTime() < time){
+			time = message.event->getTime();
+		}
+	});
+	return time;
+}
+
+void OptimisticProcess::fossilCollect(double gvt){
+	size_t count = 0;
+	while(count < processed.size() && processed[count].time < gvt){
+		count ++;
+	}
+	if(count == 0){
+		return;
+	}
+	for(size_t i = 0;i < count;i ++){
+		if(!processed[i].event->isReserved()){
+			delete processed[i].event;
+		}
+	}
+	processed.erase(processed.begin(),processed.begin() + count);
+	//截断已提交记录的日志，剩余记录的日志位置前移
+	size_t stateBegin = processed.empty() ? states.size() : processed.front().stateBegin;
+	size_t byteBegin = processed.empty() ? bytes.size() : processed.front().byteBegin;
+	size_t scheduledBegin = processed.empty() ? scheduled.size() : processed.front().scheduledBegin;
+	size_t sentBegin = processed.empty() ? sent.size() : processed.front().sentBegin;
+	states.erase(states.begin(),states.begin() + stateBegin);
+	bytes.erase(bytes.begin(),bytes.begin() + byteBegin);
+	scheduled.erase(scheduled.begin(),scheduled.begin() + scheduledBegin);
+	sent.erase(sent.begin(),sent.begin() + sentBegin);
+	for(size_t i = 0;i < states.size();i ++){
+		states[i].offset -= byteBegin;
+	}
+	for(size_t i = 0;i < processed.size();i ++){
+		processed[i].stateBegin -= stateBegin;
+		processed[i].byteBegin -= byteBegin;
+		processed[i].scheduledBegin -= scheduledBegin;
+		processed[i].sentBegin -= sentBegin;
+	}
+}
+
+}
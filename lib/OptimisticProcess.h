@@ -0,0 +1,219 @@
+/**
+ * @file OptimisticProcess.h
+ * @brief 乐观并行仿真（Time Warp）的逻辑进程类OptimisticProcess
+ * 逻辑进程不等待安全时间，投机执行未来事件表中的事件，已执行的事件保存在处理记录中，
+ * 每条记录对应事件处理期间保存的状态变量旧值（增量状态保存）、调度的本地事件和发送的消息。
+ * 收到时间戳小于已执行事件的迟到消息时，按照与执行相反的顺序回滚：恢复状态变量，
+ * 取消并删除回滚事件调度的本地事件，向接收方发送反消息撤销回滚事件发送的消息，
+ * 再把回滚事件重新加入未来事件表。反消息携带被撤销事件本身的指针，
+ * 接收方在未来事件表中取消该事件，事件已执行时先回滚到该事件之前，称为湮灭。
+ * 时间小于全局虚拟时间（GVT）的处理记录不会再回滚，由fossilCollect提交并删除。
+ * 逻辑进程之间不需要通道，消息直接发送到接收方的收件箱。
+ * 事件处理函数不能使用条件事件，也不能取消已调度的事件。
+ * 保留的事件可以重新调度自身，回滚时恢复事件时间，事件对象中的其他状态需要通过saveState保存；
+ * 进程（ProcessNotice）的推进状态无法恢复，乐观并行仿真不支持进程。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef OPTIMISTIC_PROCESS_H_
+#define OPTIMISTIC_PROCESS_H_
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include "Monitor.h"
+#include "LogicalProcess.h"
+#include "MpscQueue.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 乐观并行仿真的消息
+ */
+struct OptimisticMessage{
+	/**
+	 * @brief 消息事件，反消息时为被撤销的事件
+	 */
+	EventNotice * event;
+	/**
+	 * @brief 是否为反消息
+	 */
+	bool anti;
+};
+
+/**
+ * @brief 已执行事件的处理记录，各项为共享日志中的起始位置
+ */
+struct ProcessedEvent{
+	/**
+	 * @brief 已执行的事件
+	 */
+	EventNotice * event;
+	/**
+	 * @brief 事件执行时的时间，保留的事件重新调度自身后事件时间会改变
+	 */
+	double time;
+	/**
+	 * @brief 状态变量、状态字节、调度的本地事件和发送的消息在日志中的起始位置
+	 */
+	size_t stateBegin, byteBegin, scheduledBegin, sentBegin;
+};
+
+/**
+ * @brief 保存的状态变量
+ */
+struct SavedState{
+	void * address;
+	size_t size;
+	/**
+	 * @brief 旧值在状态字节日志中的位置
+	 */
+	size_t offset;
+};
+
+class OptimisticProcess;
+
+/**
+ * @brief 发送的消息记录，回滚时发送反消息
+ */
+struct SentMessage{
+	OptimisticProcess * destination;
+	EventNotice * event;
+};
+
+/**
+ * @brief 乐观并行仿真的逻辑进程，作为仿真引擎的监视器记录事件处理期间调度的本地事件
+ */
+class OptimisticProcess:public LogicalProcess,public Monitor{
+private:
+	/**
+	 * @brief 无锁收件箱，其他逻辑进程发送的消息和反消息，同一发送方的消息保持发送顺序
+	 */
+	MpscQueue<OptimisticMessage> inbox;
+	/**
+	 * @brief 从收件箱取出的消息
+	 */
+	std::vector<OptimisticMessage> taken;
+	/**
+	 * @brief 已执行尚未提交的事件，按照执行顺序排列
+	 */
+	std::deque<ProcessedEvent> processed;
+	/**
+	 * @brief 状态变量日志和状态字节日志
+	 */
+	std::vector<SavedState> states;
+	std::vector<char> bytes;
+	/**
+	 * @brief 调度的本地事件日志和发送的消息日志
+	 */
+	std::vector<EventNotice *> scheduled;
+	std::vector<SentMessage> sent;
+	/**
+	 * @brief 是否正在执行事件，只有执行事件期间的状态保存、调度和发送才记录到日志
+	 */
+	bool executing;
+	/**
+	 * @brief 回滚次数和发送的反消息数量
+	 */
+	uint64_t rollbacks, antiMessages;
+
+	/**
+	 * @brief 撤销最后一条处理记录，回滚事件重新加入未来事件表
+	 */
+	void undoLast();
+	/**
+	 * @brief 回滚时间大于time的全部处理记录
+	 * @param  time     迟到消息的时间戳
+	 */
+	void rollback(double time);
+	/**
+	 * @brief 湮灭反消息撤销的事件，事件已执行时先回滚到该事件之前
+	 * @param  pEvent   被撤销的事件
+	 */
+	void annihilate(EventNotice * pEvent);
+public:
+	/**
+	 * @brief 创建逻辑进程，由TimeWarpEngine::addLogicalProcess调用
+	 * @param  id       逻辑进程序号
+	 * @param  name     逻辑进程名称
+	 * @param  seed     仿真引擎的随机数种子
+	 */
+	OptimisticProcess(int id,const char * name,unsigned long seed);
+	/**
+	 * @brief 删除未提交的事件和收件箱中的消息事件
+	 */
+	virtual ~OptimisticProcess();
+	/**
+	 * @brief 向其他逻辑进程发送事件，事件时间不能小于当前仿真时间；
+	 * 目的逻辑进程为本逻辑进程时直接调度事件
+	 * @param  destination  目的逻辑进程，必须是OptimisticProcess
+	 * @param  pEvent       发送的事件
+	 */
+	virtual void send(LogicalProcess * destination,EventNotice * pEvent);
+	/**
+	 * @brief 接收收件箱中的消息，迟到消息引起回滚，反消息湮灭对应的事件
+	 * @return bool 是否接收到消息
+	 */
+	virtual bool receive();
+	/**
+	 * @brief 在事件处理期间保存状态变量的旧值
+	 * @param  address  状态变量地址
+	 * @param  size     状态变量字节数
+	 */
+	virtual void saveState(void * address,size_t size);
+	using LogicalProcess::saveState;
+	/**
+	 * @brief 将消息放入收件箱，由发送方线程调用
+	 * @param  message  消息
+	 */
+	void post(const OptimisticMessage & message);
+	/**
+	 * @brief 投机执行下一个事件并保存处理记录
+	 * @param  limit    时间上界，下一个事件时间大于limit时不执行
+	 * @return bool 是否执行了事件
+	 */
+	bool executeNextEvent(double limit);
+	/**
+	 * @brief 获取未执行事件和收件箱消息的最小时间戳，在全部工作线程暂停时用于计算GVT
+	 * @return double 最小时间戳，没有未执行事件和消息时为DBL_MAX
+	 */
+	double getMinimumTime();
+	/**
+	 * @brief 提交并删除时间小于GVT的处理记录，截断日志
+	 * @param  gvt  全局虚拟时间
+	 */
+	void fossilCollect(double gvt);
+	/**
+	 * @brief 记录事件处理期间调度的本地事件
+	 */
+	virtual void eventScheduled(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+	/**
+	 * @brief 获取回滚次数
+	 * @return uint64_t 回滚次数
+	 */
+	uint64_t getRollbacks(){
+		return rollbacks;
+	}
+	/**
+	 * @brief 获取发送的反消息数量
+	 * @return uint64_t 反消息数量
+	 */
+	uint64_t getAntiMessages(){
+		return antiMessages;
+	}
+	/**
+	 * @brief 获取未提交的处理记录数量
+	 * @return size_t 记录数量
+	 */
+	size_t getUncommittedEvents(){
+		return processed.size();
+	}
+};
+
+}
+
+#endif /* OPTIMISTIC_PROCESS_H_ */
@@ -0,0 +1,185 @@
+/**
+ * @file OutputWriter.cpp
+ * @brief 异步缓冲输出对象类OutputWriter实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <string>
+#ifdef _WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+#endif
+#include "OutputWriter.h"
+
+using namespace rubber_duck;
+
+//每条打印内容在环形缓冲区中的头部：内容长度和输出目标
+struct RecordHeader{
+	unsigned int len;
+	unsigned int sinks;
+};
+
+//将一批打印内容直接写入文件句柄对应的文件描述符，不经过stdio缓冲区再复制一次；
+//先输出stdio缓冲区中已有的内容，保持与之前直接打印内容的顺序
+static void writeBatch(FILE * stream,const std::string & batch){
+	fflush(stream);
+	const char * data = batch.data();
+	size_t size = batch.size();
+	while(size > 0){
+#ifdef _WIN32
+		int count = _write(_fileno(stream),data,(unsigned int)size);
+#else
+		ssize_t count = ::write(fileno(stream),data,size);
+#endif
+		if(count < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			return;
+		}
+		data += count;
+		size -= (size_t)count;
+	}
+}
+
+OutputWriter::OutputWriter(FILE * console,FILE * file,size_t bufferSize){
+	capacity = 4096;
+	while(capacity < bufferSize){
+		capacity <<= 1;
+	}
+	ring = new char[capacity];
+	head = 0;
+	tail = 0;
+	written = 0;
+	sleeping = false;
+	closing = false;
+	this->console = console;
+	this->file = file;
+	worker = std::thread(&OutputWriter::drain,this);
+}
+
+OutputWriter::~OutputWriter(){
+	flush();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		closing = true;
+	}
+	wakeup.notify_all();
+	worker.join();
+	delete[] ring;
+}
+
+void OutputWriter::copyIn(size_t pos,const char * src,size_t len){
+	size_t offset = pos & (capacity - 1);
+	size_t first = len < capacity - offset ? len : capacity - offset;
+	memcpy(ring + offset,src,first);
+	memcpy(ring,src + first,len - first);
+}
+
+void OutputWriter::copyOut(size_t pos,char * dst,size_t len){
+	size_t offset = pos & (capacity - 1);
+	size_t first = len < capacity - offset ? len : capacity - offset;
+	memcpy(dst,ring + offset,first);
+	memcpy(dst + first,ring,len - first);
+}
+
+void OutputWriter::write(const char * text,size_t len,int sinks){
+	RecordHeader header;
+	size_t total;
+	//超过缓冲区一半的打印内容分段写入
+	while(len + sizeof(RecordHeader) > capacity / 2){
+		size_t part = capacity / 2 - sizeof(RecordHeader);
+		write(text,part,sinks);
+		text += part;
+		len -= part;
+	}
+	header.len = (unsigned int)len;
+	header.sinks = (unsigned int)sinks;
+	total = sizeof(RecordHeader) + len;
+
+	size_t h = head.load(std::memory_order_relaxed);
+	//缓冲区满时等待后台输出线程
+	while(h + total - tail.load(std::memory_order_acquire) > capacity){
+		wakeup.notify_all();
+		std::this_thread::yield();
+	}
+	copyIn(h,(const char *)&header,sizeof(RecordHeader));
+	copyIn(h + sizeof(RecordHeader),text,len);
+	//与后台输出线程的sleeping和head检查构成顺序一致的配对，避免丢失唤醒
+	head.store(h + total,std::memory_order_seq_cst);
+	if(sleeping.load(std::memory_order_seq_cst)){
+		std::lock_guard<std::mutex> lock(mutex);
+		wakeup.notify_all();
+	}
+}
+
+void OutputWriter::flush(){
+	size_t target = head.load(std::memory_order_relaxed);
+	//后台输出线程每写完一批内容在同一条件变量上通知，write已在需要时唤醒后台输出线程
+	std::unique_lock<std::mutex> lock(mutex);
+	wakeup.wait(lock,[this,target](){
+		return written.load(std::memory_order_acquire) >= target;
+	});
+}
+
+void OutputWriter::drain(){
+	std::string consoleBatch;
+	std::string fileBatch;
+	for(;;){
+		size_t t = tail.load(std::memory_order_relaxed);
+		size_t h = head.load(std::memory_order_acquire);
+		if(t == h){
+			std::unique_lock<std::mutex> lock(mutex);
+			sleeping.store(true,std::memory_order_seq_cst);
+			//再次检查，避免丢失生产者的唤醒
+			if(head.load(std::memory_order_seq_cst) == t){
+				if(closing){
+					sleeping = false;
+					return;
+				}
+				wakeup.wait(lock);
+			}
+			sleeping = false;
+			continue;
+		}
+		//一次取出全部已写入的打印内容，按照输出目标分别合并为一次写入
+		consoleBatch.clear();
+		fileBatch.clear();
+		while(t < h){
+			RecordHeader header;
+			copyOut(t,(char *)&header,sizeof(RecordHeader));
+			//直接从环形缓冲区复制到批量写入的内容
+			if(header.sinks & OUTPUT_CONSOLE){
+				size_t size = consoleBatch.size();
+				consoleBatch.resize(size + header.len);
+				copyOut(t + sizeof(RecordHeader),&consoleBatch[size],header.len);
+			}
+			if(header.sinks & OUTPUT_FILE){
+				size_t size = fileBatch.size();
+				fileBatch.resize(size + header.len);
+				copyOut(t + sizeof(RecordHeader),&fileBatch[size],header.len);
+			}
+			t += sizeof(RecordHeader) + header.len;
+		}
+		tail.store(t,std::memory_order_release);
+		if(!consoleBatch.empty() && console != NULL){
+			writeBatch(console,consoleBatch);
+		}
+		if(!fileBatch.empty() && file != NULL){
+			writeBatch(file,fileBatch);
+		}
+		written.store(t,std::memory_order_release);
+		//唤醒等待输出完成的flush
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+		}
+		wakeup.notify_all();
+	}
+}
@@ -0,0 +1,117 @@
+/**
+ * @file OutputWriter.h
+ * @brief 异步缓冲输出对象类OutputWriter
+ * 仿真线程将打印内容写入无锁环形缓冲区，由后台输出线程批量写入控制台和文件，
+ * 避免逐条打印事件的模型在输出上阻塞仿真运行。每批内容对每个输出目标只调用一次write，不经过stdio缓冲区。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef OUTPUT_WRITER_H_
+#define OUTPUT_WRITER_H_
+
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace rubber_duck{
+
+/**
+ * @brief 控制台输出
+ */
+#define OUTPUT_CONSOLE  1
+/**
+ * @brief 文件输出
+ */
+#define OUTPUT_FILE     2
+
+/**
+ * @brief 异步缓冲输出对象类，环形缓冲区为单生产者单消费者无锁队列，
+ * 生产者为调用write的仿真线程，消费者为后台输出线程
+ */
+class OutputWriter{
+private:
+	/**
+	 * @brief 环形缓冲区
+	 */
+	char * ring;
+	/**
+	 * @brief 环形缓冲区容量，为2的幂
+	 */
+	size_t capacity;
+	/**
+	 * @brief 生产者写入位置，单调递增
+	 */
+	alignas(64) std::atomic<size_t> head;
+	/**
+	 * @brief 消费者读取位置，单调递增
+	 */
+	alignas(64) std::atomic<size_t> tail;
+	/**
+	 * @brief 已经写入控制台和文件的位置
+	 */
+	alignas(64) std::atomic<size_t> written;
+	/**
+	 * @brief 后台输出线程是否处于等待状态
+	 */
+	std::atomic<bool> sleeping;
+	/**
+	 * @brief 后台输出线程是否需要退出
+	 */
+	std::atomic<bool> closing;
+	/**
+	 * @brief 控制台输出文件句柄
+	 */
+	FILE * console;
+	/**
+	 * @brief 打印输出文件句柄
+	 */
+	FILE * file;
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::thread worker;
+	/**
+	 * @brief 后台输出线程函数
+	 */
+	void drain();
+	/**
+	 * @brief 将环形缓冲区中pos开始的len个字节复制到dst
+	 */
+	void copyOut(size_t pos,char * dst,size_t len);
+	/**
+	 * @brief 将src中的len个字节复制到环形缓冲区pos开始的位置
+	 */
+	void copyIn(size_t pos,const char * src,size_t len);
+public:
+	/**
+	 * @brief 创建OutputWriter对象并启动后台输出线程
+	 * @param  console      控制台输出文件句柄，通常为stdout
+	 * @param  file         打印输出文件句柄，NULL表示不进行文件打印
+	 * @param  bufferSize   环形缓冲区容量，向上取整为2的幂
+	 */
+	OutputWriter(FILE * console,FILE * file,size_t bufferSize = 1 << 20);
+	/**
+	 * @brief 输出全部缓冲内容，结束后台输出线程并删除OutputWriter对象
+	 */
+	~OutputWriter();
+	/**
+	 * @brief 写入一条打印内容，缓冲区满时等待后台输出线程
+	 * @param  text      打印内容
+	 * @param  len       打印内容长度
+	 * @param  sinks     输出目标，OUTPUT_CONSOLE和OUTPUT_FILE的组合
+	 */
+	void write(const char * text,size_t len,int sinks);
+	/**
+	 * @brief 等待已写入的打印内容全部输出到控制台和文件
+	 */
+	void flush();
+};
+
+}
+
+#endif /* OUTPUT_WRITER_H_ */
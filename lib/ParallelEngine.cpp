@@ -0,0 +1,182 @@
+/**
+ * @file ParallelEngine.cpp
+ * @brief 并行离散事件仿真引擎基类ParallelEngine的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include "ThreadPool.h"
+#include "ParallelEngine.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+ParallelEngine::ParallelEngine(){
+	endTime = 0;
+	threadCount = 0;
+	wallTime = 0;
+	arrived = generation = 0;
+}
+
+ParallelEngine::~ParallelEngine(){
+	//先删除通道中未接收的事件，再删除逻辑进程及其未来事件表
+	for(size_t i = 0;i < channels.size();i ++){
+		delete channels[i];
+	}
+	for(size_t i = 0;i < processes.size();i ++){
+		delete processes[i];
+	}
+}
+
+LogicalProcess * ParallelEngine::addLogicalProcess(const char * name,unsigned long seed){
+	LogicalProcess * lp = createLogicalProcess((int)processes.size(),name,seed);
+	processes.push_back(lp);
+	return lp;
+}
+
+Channel * ParallelEngine::connect(LogicalProcess * source,LogicalProcess * destination,double lookahead){
+	if(lookahead <= 0){
+		printf("错误：逻辑进程（%s）到（%s）的通道前瞻量（%f）必须大于0\n",source->getName(),destination->getName(),lookahead);
+		exit(0);
+	}
+	if(source == destination || source->getOutput(destination) != NULL){
+		printf("错误：逻辑进程（%s）到（%s）的通道重复或连接到自身\n",source->getName(),destination->getName());
+		exit(0);
+	}
+	Channel * pChannel = createChannel(source,destination,lookahead);
+	source->addOutput(pChannel);
+	destination->addInput(pChannel);
+	channels.push_back(pChannel);
+	return pChannel;
+}
+
+void ParallelEngine::barrier(){
+	unique_lock<std::mutex> lock(mutex);
+	unsigned current = generation;
+	if(++ arrived == threadCount){
+		arrived = 0;
+		generation ++;
+		condition.notify_all();
+	}else{
+		condition.wait(lock,[&]{	return generation != current;	});
+	}
+}
+
+void ParallelEngine::runThread(unsigned thread){
+	//按照序号轮流分配逻辑进程，同一逻辑进程始终由同一线程推进
+	vector<LogicalProcess *> assigned;
+	for(size_t i = thread;i < processes.size();i += threadCount){
+		assigned.push_back(processes[i]);
+	}
+	size_t remaining = assigned.size();
+	while(remaining > 0){
+		bool progress = false;
+		remaining = 0;
+		for(size_t i = 0;i < assigned.size();i ++){
+			if(!assigned[i]->isFinished()){
+				progress |= advance(assigned[i]);
+				remaining += assigned[i]->isFinished() ? 0 : 1;
+			}
+		}
+		if(!progress && remaining > 0){
+			this_thread::yield();
+		}
+	}
+}
+
+void ParallelEngine::run(double endTime,unsigned threads){
+	this->endTime = endTime;
+	threads = threads == 0 ? ThreadPool::hardwareThreads() : threads;
+	threadCount = threads < processes.size() ? threads : (unsigned)processes.size();
+	for(size_t i = 0;i < processes.size();i ++){
+		processes[i]->setFinished(false);
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<thread> workers;
+	for(unsigned t = 0;t < threadCount;t ++){
+		workers.push_back(thread(&ParallelEngine::runThread,this,t));
+	}
+	for(size_t t = 0;t < workers.size();t ++){
+		workers[t].join();
+	}
+	wallTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+uint64_t ParallelEngine::getEventCount(){
+	uint64_t count = 0;
+	for(size_t i = 0;i < processes.size();i ++){
+		count += processes[i]->getCommittedEvents();
+	}
+	return count;
+}
+
+uint64_t ParallelEngine::getProcessedEventCount(){
+	uint64_t count = 0;
+	for(size_t i = 0;i < processes.size();i ++){
+		count += processes[i]->getSimulator()->getEventCount();
+	}
+	return count;
+}
+
+uint64_t ParallelEngine::getRolledBackEventCount(){
+	uint64_t count = 0;
+	for(size_t i = 0;i < processes.size();i ++){
+		count += processes[i]->getRolledBackEvents();
+	}
+	return count;
+}
+
+uint64_t ParallelEngine::getNullMessageCount(){
+	uint64_t count = 0;
+	for(size_t i = 0;i < processes.size();i ++){
+		count += processes[i]->getNullMessages();
+	}
+	return count;
+}
+
+void ParallelEngine::report(){
+	string t(120,'-');
+	cout << "同步协议：" << getProtocol() << "，逻辑进程数量：" << processes.size() << "，通道数量：" << channels.size()
+		<< "，工作线程数量：" << threadCount << "，仿真结束时间：" << endTime << endl;
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(6) << "LP"
+		<< setw(20) << "NAME"
+		<< setw(16) << "EVENTS"
+		<< setw(16) << "SENT"
+		<< setw(16) << "RECEIVED"
+		<< setw(14) << "NULLS"
+		<< setw(14) << "ROLLED BACK"
+		<< setw(14) << "CLOCK"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	for(size_t i = 0;i < processes.size();i ++){
+		LogicalProcess * lp = processes[i];
+		cout << setiosflags(ios::left)
+			<< setw(6) << i
+			<< setw(20) << lp->getName()
+			<< setw(16) << lp->getCommittedEvents()
+			<< setw(16) << lp->getEventMessages()
+			<< setw(16) << lp->getReceivedMessages()
+			<< setw(14) << lp->getNullMessages()
+			<< setw(14) << lp->getRolledBackEvents()
+			<< setw(14) << lp->getSimulator()->getClock()
+			<< resetiosflags(ios::left) << endl;
+	}
+	cout << t.c_str() << endl;
+	uint64_t events = getEventCount();
+	cout << "事件数量：" << events << "，空消息数量：" << getNullMessageCount() << "，墙钟时间：" << wallTime
+		<< "秒，事件处理速率：" << (wallTime > 0 ? events / wallTime : 0) << "事件/秒" << endl;
+}
+
+}
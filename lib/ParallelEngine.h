@@ -0,0 +1,182 @@
+/**
+ * @file ParallelEngine.h
+ * @brief 并行离散事件仿真引擎基类ParallelEngine
+ * ParallelEngine管理逻辑进程和逻辑进程之间的通道，运行时将逻辑进程按照序号轮流分配给
+ * 工作线程，每个工作线程循环推进分配给自己的逻辑进程，直到全部逻辑进程推进到仿真结束时间。
+ * 派生类实现advance，按照各自的同步协议推进一个逻辑进程；需要全局同步的协议可以重新实现
+ * runThread，需要扩展逻辑进程的协议重新实现createLogicalProcess，需要其他消息传输方式的协议重新实现createChannel。
+ * 逻辑进程只能使用事件调度法（EventNotice）建模，CProcess的协作例程状态属于线程，
+ * 不能在同一线程的多个逻辑进程间共享。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef PARALLEL_ENGINE_H_
+#define PARALLEL_ENGINE_H_
+
+#include <stdint.h>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include "LogicalProcess.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 并行离散事件仿真引擎基类
+ */
+class ParallelEngine{
+protected:
+	/**
+	 * @brief 逻辑进程，下标为逻辑进程序号
+	 */
+	std::vector<LogicalProcess *> processes;
+	/**
+	 * @brief 逻辑进程之间的通道
+	 */
+	std::vector<Channel *> channels;
+	/**
+	 * @brief 仿真结束时间，执行时间不大于结束时间的事件
+	 */
+	double endTime;
+	/**
+	 * @brief 最近一次运行的工作线程数量和墙钟时间（秒）
+	 */
+	unsigned threadCount;
+	double wallTime;
+	/**
+	 * @brief 工作线程屏障的互斥量、条件变量、到达线程数量和屏障代数
+	 */
+	std::mutex mutex;
+	std::condition_variable condition;
+	unsigned arrived, generation;
+
+	/**
+	 * @brief 等待全部工作线程到达屏障，用于需要全局同步的协议
+	 */
+	void barrier();
+
+	/**
+	 * @brief 工作线程的主循环，推进分配给本线程的逻辑进程直到全部结束
+	 * @param  thread   工作线程序号
+	 */
+	virtual void runThread(unsigned thread);
+	/**
+	 * @brief 创建逻辑进程，派生类可以创建扩展的逻辑进程
+	 * @param  id       逻辑进程序号
+	 * @param  name     逻辑进程名称
+	 * @param  seed     仿真引擎的随机数种子
+	 * @return LogicalProcess* 逻辑进程
+	 */
+	virtual LogicalProcess * createLogicalProcess(int id,const char * name,unsigned long seed){
+		return new LogicalProcess(id,name,seed);
+	}
+	/**
+	 * @brief 创建通道，派生类可以创建其他传输方式的通道
+	 * @param  source       发送方逻辑进程
+	 * @param  destination  接收方逻辑进程
+	 * @param  lookahead    前瞻量
+	 * @return Channel* 通道
+	 */
+	virtual Channel * createChannel(LogicalProcess * source,LogicalProcess * destination,double lookahead){
+		return new Channel(source,destination,lookahead);
+	}
+	/**
+	 * @brief 按照同步协议推进一个逻辑进程，推进到结束时间后调用setFinished(true)
+	 * @param  lp   逻辑进程
+	 * @return bool 是否有进展（执行了事件或收发了消息），没有进展时工作线程让出处理器
+	 */
+	virtual bool advance(LogicalProcess * lp) = 0;
+public:
+	ParallelEngine();
+	/**
+	 * @brief 删除全部逻辑进程和通道
+	 */
+	virtual ~ParallelEngine();
+	/**
+	 * @brief 添加逻辑进程
+	 * @param  name     逻辑进程名称
+	 * @param  seed     逻辑进程仿真引擎的随机数种子
+	 * @return LogicalProcess* 逻辑进程
+	 */
+	LogicalProcess * addLogicalProcess(const char * name,unsigned long seed);
+	/**
+	 * @brief 建立从source到destination的单向通道
+	 * @param  source       发送方逻辑进程
+	 * @param  destination  接收方逻辑进程
+	 * @param  lookahead    前瞻量，必须大于0
+	 * @return Channel* 通道
+	 */
+	Channel * connect(LogicalProcess * source,LogicalProcess * destination,double lookahead);
+	/**
+	 * @brief 并行运行仿真，执行全部逻辑进程中时间不大于endTime的事件
+	 * @param  endTime  仿真结束时间
+	 * @param  threads  工作线程数量，为0时等于处理器核数，大于逻辑进程数量时等于逻辑进程数量
+	 */
+	virtual void run(double endTime,unsigned threads = 0);
+	/**
+	 * @brief 获取逻辑进程数量
+	 * @return int 逻辑进程数量
+	 */
+	int getLogicalProcessCount(){
+		return (int)processes.size();
+	}
+	/**
+	 * @brief 获取逻辑进程
+	 * @param  id   逻辑进程序号
+	 * @return LogicalProcess* 逻辑进程
+	 */
+	LogicalProcess * getLogicalProcess(int id){
+		return processes[id];
+	}
+	/**
+	 * @brief 获取全部逻辑进程已提交的事件数量，即执行的事件数量减去回滚撤销的事件数量
+	 * @return uint64_t 事件数量
+	 */
+	virtual uint64_t getEventCount();
+	/**
+	 * @brief 获取全部逻辑进程执行的事件数量，包括回滚撤销的事件
+	 * @return uint64_t 事件数量
+	 */
+	virtual uint64_t getProcessedEventCount();
+	/**
+	 * @brief 获取全部逻辑进程回滚撤销的事件数量
+	 * @return uint64_t 事件数量
+	 */
+	uint64_t getRolledBackEventCount();
+	/**
+	 * @brief 获取全部逻辑进程发送的空消息数量
+	 * @return uint64_t 空消息数量
+	 */
+	virtual uint64_t getNullMessageCount();
+	/**
+	 * @brief 获取最近一次运行的墙钟时间
+	 * @return double 秒数
+	 */
+	double getWallTime(){
+		return wallTime;
+	}
+	/**
+	 * @brief 获取最近一次运行的工作线程数量
+	 * @return unsigned 工作线程数量
+	 */
+	unsigned getThreadCount(){
+		return threadCount;
+	}
+	/**
+	 * @brief 获取同步协议名称
+	 * @return const char* 协议名称
+	 */
+	virtual const char * getProtocol() = 0;
+	/**
+	 * @brief 打印各逻辑进程的事件数量、消息数量和仿真时钟，以及总的事件处理速率
+	 */
+	virtual void report();
+};
+
+}
+
+#endif /* PARALLEL_ENGINE_H_ */
@@ -0,0 +1,226 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief 硬件性能计数器类PerfCounters实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <string.h>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#ifdef __linux__
+	#include <errno.h>
+	#include <unistd.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+#endif
+#include "Simulator.h"
+#include "PerfCounters.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//计数器名称
+static const char * CounterNames[PERF_COUNTERS] = {"cycles", "instructions", "cache-misses", "branch-misses"};
+
+#ifdef __linux__
+//打开一个硬件计数器，group为-1时作为计数器组长
+static int openCounter(uint64_t config,int group){
+	struct perf_event_attr attr;
+	memset(&attr,0,sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = config;
+	attr.disabled = group < 0 ? 1 : 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+	return (int)syscall(__NR_perf_event_open,&attr,0,-1,group,0);
+}
+#endif
+
+PerfCounters::PerfCounters(){
+#ifdef __linux__
+	static const uint64_t configs[PERF_COUNTERS] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+	//第一个打开成功的计数器作为组长，其余计数器加入计数器组，一次read读取全部计数值
+	for(int c = 0;c < PERF_COUNTERS;c ++){
+		int fd = openCounter(configs[c],leader);
+		if(fd < 0){
+			if(!error.empty()){
+				error += "; ";
+			}
+			error += string(CounterNames[c]) + ": " + strerror(errno);
+			continue;
+		}
+		fds[c] = fd;
+		if(leader < 0){
+			leader = fd;
+		}
+		order[opened ++] = c;
+	}
+	if(leader >= 0){
+		ioctl(leader,PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP);
+		ioctl(leader,PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP);
+	}else{
+		error += "（请检查/proc/sys/kernel/perf_event_paranoid）";
+	}
+#else
+	error = "硬件性能计数器仅支持Linux平台";
+#endif
+}
+
+PerfCounters::~PerfCounters(){
+#ifdef __linux__
+	for(int c = 0;c < PERF_COUNTERS;c ++){
+		if(fds[c] >= 0){
+			close(fds[c]);
+		}
+	}
+#endif
+}
+
+bool PerfCounters::read(PerfSample & sample){
+	memset(&sample,0,sizeof(sample));
+#ifdef __linux__
+	if(leader < 0){
+		return false;
+	}
+	//PERF_FORMAT_GROUP格式：计数器数量，然后按照打开顺序排列的计数值
+	uint64_t buffer[1 + PERF_COUNTERS];
+	ssize_t n = ::read(leader,buffer,sizeof(uint64_t) * (1 + opened));
+	if(n < (ssize_t)sizeof(uint64_t) || buffer[0] != (uint64_t)opened){
+		return false;
+	}
+	for(int i = 0;i < opened;i ++){
+		sample.values[order[i]] = buffer[1 + i];
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void PerfCounters::reset(){
+	profiles.clear();
+	profileIndex.clear();
+	starts.clear();
+	memset(runTotals,0,sizeof(runTotals));
+	runEvents = 0;
+}
+
+PerfProfile & PerfCounters::profileOf(EventNotice * pEvent){
+	const std::type_info * type = &typeid(*pEvent);
+	std::unordered_map<const std::type_info *,size_t>::iterator it = profileIndex.find(type);
+	if(it == profileIndex.end()){
+		PerfProfile profile;
+		profile.name = getEventClassName(pEvent);
+		profiles.push_back(profile);
+		it = profileIndex.insert(std::make_pair(type,profiles.size() - 1)).first;
+	}
+	return profiles[it->second];
+}
+
+void PerfCounters::runStarted(Simulator * pSimulator){
+	read(runStart);
+}
+
+void PerfCounters::runFinished(Simulator * pSimulator){
+	PerfSample end;
+	if(!read(end)){
+		return;
+	}
+	for(int c = 0;c < PERF_COUNTERS;c ++){
+		runTotals[c] += end.values[c] - runStart.values[c];
+	}
+}
+
+void PerfCounters::eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	if(leader < 0){
+		return;
+	}
+	starts.push_back(PerfSample());
+	read(starts.back());
+}
+
+void PerfCounters::eventTriggered(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	if(leader < 0 || starts.empty()){
+		return;
+	}
+	PerfSample end;
+	read(end);
+	PerfSample & start = starts.back();
+	PerfProfile & profile = profileOf(pEvent);
+	profile.count ++;
+	for(int c = 0;c < PERF_COUNTERS;c ++){
+		profile.totals[c] += end.values[c] - start.values[c];
+	}
+	starts.pop_back();
+	runEvents ++;
+}
+
+//按照CPU周期从大到小排序
+static bool byCycles(const PerfProfile * a,const PerfProfile * b){
+	return a->totals[PERF_CYCLES] > b->totals[PERF_CYCLES];
+}
+
+//打印一行统计结果，不可用的计数器打印"-"
+static void printRow(const string & name,uint64_t count,const uint64_t * totals,const int * fds){
+	double events = count > 0 ? (double)count : 1;
+	cout << setiosflags(ios::left | ios::fixed) << setprecision(2)
+		<< setw(24) << (name.size() > 23 ? name.substr(0,20) + "..." : name)
+		<< setw(12) << count;
+	for(int c = 0;c < PERF_COUNTERS;c ++){
+		if(fds[c] >= 0){
+			cout << setw(16) << totals[c] / events;
+		}else{
+			cout << setw(16) << "-";
+		}
+	}
+	if(fds[PERF_CYCLES] >= 0 && fds[PERF_INSTRUCTIONS] >= 0 && totals[PERF_CYCLES] > 0){
+		cout << setw(16) << (double)totals[PERF_INSTRUCTIONS] / totals[PERF_CYCLES];
+	}else{
+		cout << setw(16) << "-";
+	}
+	cout << resetiosflags(ios::left | ios::fixed) << setprecision(6) << endl;
+}
+
+void PerfCounters::report(){
+	string t(120,'-');
+	if(leader < 0){
+		cout << "硬件性能计数器不可用：" << error << endl;
+		return;
+	}
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(24) << "EVENT CLASS"	//"事件类"
+		<< setw(12) << "COUNT"			//"执行次数"
+		<< setw(16) << "CYCLES/EV"		//"每个事件的CPU周期"
+		<< setw(16) << "INSTR/EV"		//"每个事件的指令数"
+		<< setw(16) << "CACHE-MISS/EV"	//"每个事件的缓存缺失"
+		<< setw(16) << "BR-MISS/EV"		//"每个事件的分支预测失败"
+		<< setw(16) << "IPC"			//"每周期指令数"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	std::vector<const PerfProfile *> sorted;
+	for(size_t i = 0;i < profiles.size();i ++){
+		sorted.push_back(&profiles[i]);
+	}
+	std::sort(sorted.begin(),sorted.end(),byCycles);
+	for(size_t i = 0;i < sorted.size();i ++){
+		printRow(sorted[i]->name,sorted[i]->count,sorted[i]->totals,fds);
+	}
+	cout << t.c_str() << endl;
+	//仿真运行整体的计数值包括事件表操作等引擎开销，按照执行的事件数量平均
+	printRow("RUN (TOTAL)",runEvents,runTotals,fds);
+	cout << t.c_str() << endl;
+	if(!error.empty()){
+		cout << "部分计数器不可用：" << error << endl;
+	}
+}
@@ -0,0 +1,160 @@
+/**
+ * @file PerfCounters.h
+ * @brief 硬件性能计数器类PerfCounters
+ * 在Linux下通过perf_event_open打开CPU周期、指令、缓存缺失和分支预测失败计数器，
+ * 统计Simulator::run整体和各事件类执行时的计数值，报告IPC和每个事件的缺失次数，
+ * 用于确认事件表或内存分配等修改的效果。计数器不可用时（非Linux平台、
+ * perf_event_paranoid限制或虚拟机不支持等）不进行统计，仿真运行不受影响。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef PERF_COUNTERS_H_
+#define PERF_COUNTERS_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <unordered_map>
+#include "Monitor.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 硬件性能计数器序号
+ */
+#define PERF_CYCLES         0	//CPU周期
+#define PERF_INSTRUCTIONS   1	//执行的指令
+#define PERF_CACHE_MISSES   2	//缓存缺失
+#define PERF_BRANCH_MISSES  3	//分支预测失败
+#define PERF_COUNTERS       4
+
+/**
+ * @brief 硬件性能计数值
+ */
+struct PerfSample{
+	uint64_t values[PERF_COUNTERS];
+};
+
+/**
+ * @brief 事件类的硬件性能计数统计结果
+ */
+struct PerfProfile{
+	/**
+	 * @brief 事件类名称
+	 */
+	std::string name;
+	/**
+	 * @brief 执行次数
+	 */
+	uint64_t count = 0;
+	/**
+	 * @brief 各计数器的累计值
+	 */
+	uint64_t totals[PERF_COUNTERS] = {0,0,0,0};
+};
+
+/**
+ * @brief 硬件性能计数器类，作为监视器注册到Simulator，通常由Simulator::setPerfCounters创建
+ */
+class PerfCounters:public Monitor{
+private:
+	/**
+	 * @brief 计数器组的文件描述符，-1表示计数器不可用
+	 */
+	int fds[PERF_COUNTERS] = {-1,-1,-1,-1};
+	/**
+	 * @brief 计数器组长的文件描述符，-1表示全部计数器不可用
+	 */
+	int leader = -1;
+	/**
+	 * @brief 打开的计数器数量，以及按照读取顺序排列的计数器序号
+	 */
+	int opened = 0;
+	int order[PERF_COUNTERS];
+	/**
+	 * @brief 计数器不可用的原因
+	 */
+	std::string error;
+	/**
+	 * @brief 按照事件类保存的统计结果
+	 */
+	std::vector<PerfProfile> profiles;
+	std::unordered_map<const std::type_info *,size_t> profileIndex;
+	/**
+	 * @brief 正在执行的事件开始时的计数值栈
+	 */
+	std::vector<PerfSample> starts;
+	/**
+	 * @brief 仿真运行整体的计数值
+	 */
+	PerfSample runStart;
+	uint64_t runTotals[PERF_COUNTERS] = {0,0,0,0};
+	uint64_t runEvents = 0;
+
+	/**
+	 * @brief 读取全部计数器的当前值
+	 * @param  sample   计数值
+	 * @return true 读取成功
+	 */
+	bool read(PerfSample & sample);
+	PerfProfile & profileOf(EventNotice * pEvent);
+public:
+	/**
+	 * @brief 创建PerfCounters对象并打开硬件性能计数器，仅统计当前线程
+	 */
+	PerfCounters();
+	/**
+	 * @brief 关闭硬件性能计数器并删除PerfCounters对象
+	 */
+	virtual ~PerfCounters();
+	/**
+	 * @brief 是否有可用的硬件性能计数器
+	 * @return true 至少一个计数器可用
+	 */
+	bool isAvailable(){	return leader >= 0;	};
+	/**
+	 * @brief 指定的计数器是否可用
+	 * @param  counter   计数器序号，PERF_CYCLES等
+	 * @return true 计数器可用
+	 */
+	bool isAvailable(int counter){	return fds[counter] >= 0;	};
+	/**
+	 * @brief 获得计数器不可用的原因
+	 * @return const char* 原因描述，计数器全部可用时为空字符串
+	 */
+	const char * getError(){	return error.c_str();	};
+	/**
+	 * @brief 清除全部统计结果
+	 */
+	void reset();
+	/**
+	 * @brief 获得各事件类的统计结果
+	 * @return const std::vector<PerfProfile>& 统计结果
+	 */
+	const std::vector<PerfProfile> & getProfiles(){	return profiles;	};
+	/**
+	 * @brief 获得仿真运行整体的计数器累计值
+	 * @param  counter   计数器序号，PERF_CYCLES等
+	 * @return uint64_t 累计值
+	 */
+	uint64_t getRunTotal(int counter){	return runTotals[counter];	};
+	/**
+	 * @brief 打印仿真运行整体和各事件类的IPC、每个事件的周期数和缺失次数，
+	 * 格式同DataCollection::report
+	 */
+	void report();
+
+	virtual void runStarted(Simulator * pSimulator);
+	virtual void runFinished(Simulator * pSimulator);
+	virtual void eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+	virtual void eventTriggered(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+};
+
+}
+
+#endif /* PERF_COUNTERS_H_ */
@@ -85,6 +85,13 @@ public:
 	 * @param  pSimulator    仿真引擎对象指针
 	 */
 	virtual void trigger(Simulator * pSimulator);
+	/**
+	 * @brief 按照进程子类P直接调用进程推进函数，避免虚函数调用，由EventDispatcher使用
+	 * 该模板定义在EventDispatch.h中
+	 * @param  pSimulator    仿真引擎对象指针
+	 */
+	template<class P>
+	void triggerAs(Simulator * pSimulator);
 };
 
 }
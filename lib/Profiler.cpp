@@ -0,0 +1,251 @@
+/**
+ * @file Profiler.cpp
+ * @brief 事件执行性能剖析类Profiler实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "Simulator.h"
+#include "Profiler.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//计算耗时所在的直方图分段，每个2的幂区间分为PROFILE_SUB_BUCKETS段
+static size_t bucketOf(uint64_t ns){
+	if(ns < PROFILE_SUB_BUCKETS){
+		return (size_t)ns;
+	}
+	int msb;
+#if defined(__GNUC__)
+	msb = 63 - __builtin_clzll(ns);
+#else
+	msb = 0;
+	for(uint64_t v = ns;v > 1;v >>= 1){
+		msb ++;
+	}
+#endif
+	size_t sub = (size_t)((ns >> (msb - 2)) & (PROFILE_SUB_BUCKETS - 1));
+	return msb * PROFILE_SUB_BUCKETS + sub;
+}
+
+//直方图分段的下界和上界
+static void bucketBounds(size_t bucket,double & lower,double & upper){
+	if(bucket < PROFILE_SUB_BUCKETS){
+		lower = (double)bucket;
+		upper = (double)bucket + 1;
+		return;
+	}
+	int msb = (int)(bucket / PROFILE_SUB_BUCKETS);
+	size_t sub = bucket % PROFILE_SUB_BUCKETS;
+	double unit = (double)(1ULL << (msb - 2));
+	lower = (PROFILE_SUB_BUCKETS + sub) * unit;
+	upper = lower + unit;
+}
+
+static uint64_t elapsedNs(std::chrono::steady_clock::time_point from,std::chrono::steady_clock::time_point to){
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+double EventProfile::percentile(double p) const{
+	uint64_t timed = 0;
+	for(size_t b = 0;b < histogram.size();b ++){
+		timed += histogram[b];
+	}
+	if(timed == 0){
+		return 0;
+	}
+	double target = p * timed;
+	uint64_t cumulative = 0;
+	for(size_t b = 0;b < histogram.size();b ++){
+		cumulative += histogram[b];
+		if(cumulative >= target && histogram[b] > 0){
+			double lower,upper;
+			bucketBounds(b,lower,upper);
+			//取分段中点，并限制在观察到的最小值和最大值之间
+			double value = (lower + upper) / 2;
+			value = std::max(value,(double)minNs);
+			value = std::min(value,(double)maxNs);
+			return value;
+		}
+	}
+	return (double)maxNs;
+}
+
+void Profiler::reset(){
+	profiles.clear();
+	profileIndex.clear();
+	lastType = NULL;
+	lastIndex = 0;
+	starts.clear();
+	scanCount = 0;
+	scanNs = 0;
+	runNs = 0;
+}
+
+EventProfile & Profiler::profileOf(EventNotice * pEvent){
+	const std::type_info * type = &typeid(*pEvent);
+	if(type == lastType){
+		return profiles[lastIndex];
+	}
+	std::unordered_map<const std::type_info *,size_t>::iterator it = profileIndex.find(type);
+	if(it == profileIndex.end()){
+		EventProfile profile;
+		profile.name = getEventClassName(pEvent);
+		profiles.push_back(profile);
+		it = profileIndex.insert(std::make_pair(type,profiles.size() - 1)).first;
+	}
+	lastType = type;
+	lastIndex = it->second;
+	return profiles[lastIndex];
+}
+
+void Profiler::runStarted(Simulator * pSimulator){
+	runStart = std::chrono::steady_clock::now();
+}
+
+void Profiler::runFinished(Simulator * pSimulator){
+	runNs += elapsedNs(runStart,std::chrono::steady_clock::now());
+}
+
+void Profiler::eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	EventProfile & profile = profileOf(pEvent);
+	uint64_t fel = pSimulator->getFutureEventCount();
+	uint64_t cel = pSimulator->getConditionalEventCount();
+	profile.felSizeSum += fel;
+	profile.felSizeMax = std::max(profile.felSizeMax,fel);
+	profile.celSizeSum += cel;
+	profile.celSizeMax = std::max(profile.celSizeMax,cel);
+	//最后取时间，不计入剖析本身的开销
+	starts.push_back(std::chrono::steady_clock::now());
+}
+
+void Profiler::eventTriggered(Simulator * pSimulator,EventNotice * pEvent,bool conditional){
+	TimePoint end = std::chrono::steady_clock::now();
+	if(starts.empty()){
+		return;
+	}
+	uint64_t ns = elapsedNs(starts.back(),end);
+	starts.pop_back();
+	EventProfile & profile = profileOf(pEvent);
+	profile.count ++;
+	if(conditional){
+		profile.conditionalCount ++;
+	}
+	profile.totalNs += ns;
+	profile.minNs = std::min(profile.minNs,ns);
+	profile.maxNs = std::max(profile.maxNs,ns);
+	profile.histogram[bucketOf(ns)] ++;
+}
+
+void Profiler::conditionEvaluated(Simulator * pSimulator,EventNotice * pEvent,bool result){
+	EventProfile & profile = profileOf(pEvent);
+	profile.evaluations ++;
+	if(result){
+		profile.successes ++;
+	}
+}
+
+void Profiler::conditionalScanStarted(Simulator * pSimulator){
+	scanStart = std::chrono::steady_clock::now();
+}
+
+void Profiler::conditionalScanFinished(Simulator * pSimulator){
+	scanCount ++;
+	scanNs += elapsedNs(scanStart,std::chrono::steady_clock::now());
+}
+
+//按照执行耗时总计从大到小排序
+static bool byTotalTime(const EventProfile * a,const EventProfile * b){
+	return a->totalNs > b->totalNs;
+}
+
+void Profiler::printHeading() {
+	string t(120,'-');
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(24) << "EVENT CLASS"	//"事件类"
+		<< setw(10) << "COUNT"			//"执行次数"
+		<< setw(12) << "TOTAL(ms)"		//"耗时总计"
+		<< setw(10) << "MEAN(us)"		//"耗时均值"
+		<< setw(10) << "P50(us)"		//"耗时中位数"
+		<< setw(10) << "P90(us)"
+		<< setw(10) << "P99(us)"
+		<< setw(10) << "MAX(us)"		//"耗时最大值"
+		<< setw(14) << "COND.TRUE/EVAL"	//"条件满足次数/判断次数"
+		<< setw(5)  << "FEL"			//"执行时FEL平均长度"
+		<< setw(5)  << "CEL"			//"执行时CEL平均长度"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+}
+
+void Profiler::report(){
+	std::vector<const EventProfile *> sorted;
+	for(size_t i = 0;i < profiles.size();i ++){
+		sorted.push_back(&profiles[i]);
+	}
+	std::sort(sorted.begin(),sorted.end(),byTotalTime);
+	printHeading();
+	for(size_t i = 0;i < sorted.size();i ++){
+		const EventProfile & p = *sorted[i];
+		double samples = p.count > 0 ? (double)p.count : 1;
+		double felMean = (double)p.felSizeSum / samples;
+		double celMean = (double)p.celSizeSum / samples;
+		string name = p.name.size() > 23 ? p.name.substr(0,20) + "..." : p.name;
+		string cond = to_string(p.successes) + "/" + to_string(p.evaluations);
+		cout << setiosflags(ios::left) << setprecision(4)
+			<< setw(24) << name
+			<< setw(10) << p.count
+			<< setw(12) << p.totalNs / 1e6
+			<< setw(10) << p.totalNs / samples / 1e3
+			<< setw(10) << p.percentile(0.5) / 1e3
+			<< setw(10) << p.percentile(0.9) / 1e3
+			<< setw(10) << p.percentile(0.99) / 1e3
+			<< setw(10) << p.maxNs / 1e3
+			<< setw(14) << cond
+			<< setw(5)  << felMean
+			<< setw(5)  << celMean
+			<< resetiosflags(ios::left) << setprecision(6) << endl;
+	}
+	string t(120,'-');
+	cout << t.c_str() << endl;
+	cout << "RUN(ms): " << runNs / 1e6 << "  CEL SCANS: " << scanCount
+		<< "  CEL SCAN(ms): " << scanNs / 1e6 << endl;
+}
+
+void Profiler::exportJSON(const char * fileName){
+	FILE * file = fopen(fileName,"w");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	fprintf(file,"{\n  \"runNs\": %llu,\n  \"scanCount\": %llu,\n  \"scanNs\": %llu,\n  \"events\": [",
+			(unsigned long long)runNs,(unsigned long long)scanCount,(unsigned long long)scanNs);
+	for(size_t i = 0;i < profiles.size();i ++){
+		const EventProfile & p = profiles[i];
+		double samples = p.count > 0 ? (double)p.count : 1;
+		fprintf(file,"%s\n    {\"name\": \"%s\", \"count\": %llu, \"conditionalCount\": %llu, "
+				"\"totalNs\": %llu, \"meanNs\": %.1f, \"minNs\": %llu, \"maxNs\": %llu, "
+				"\"p50Ns\": %.1f, \"p90Ns\": %.1f, \"p99Ns\": %.1f, "
+				"\"evaluations\": %llu, \"successes\": %llu, "
+				"\"felMean\": %.3f, \"felMax\": %llu, \"celMean\": %.3f, \"celMax\": %llu}",
+				i == 0 ? "" : ",",jsonEscape(p.name.c_str()).c_str(),
+				(unsigned long long)p.count,(unsigned long long)p.conditionalCount,
+				(unsigned long long)p.totalNs,p.totalNs / samples,
+				(unsigned long long)(p.count > 0 ? p.minNs : 0),(unsigned long long)p.maxNs,
+				p.percentile(0.5),p.percentile(0.9),p.percentile(0.99),
+				(unsigned long long)p.evaluations,(unsigned long long)p.successes,
+				p.felSizeSum / samples,(unsigned long long)p.felSizeMax,
+				p.celSizeSum / samples,(unsigned long long)p.celSizeMax);
+	}
+	fprintf(file,"\n  ]\n}\n");
+	fclose(file);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file Profiler.h
+ * @brief 事件执行性能剖析类Profiler
+ * 按照事件类统计事件执行次数、执行的墙钟耗时（总计、均值、最大值和百分位数）、
+ * 条件事件的canTrigger判断次数和满足次数以及事件执行时FEL和CEL的长度，
+ * 用于找出仿真模型中消耗CPU时间的事件类。耗时百分位数由对数分段直方图估计，
+ * 相对误差不超过12.5%。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <stdint.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <unordered_map>
+#include "Monitor.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 耗时直方图每个2的幂区间的分段数量
+ */
+#define PROFILE_SUB_BUCKETS 4
+/**
+ * @brief 耗时直方图的分段数量
+ */
+#define PROFILE_BUCKETS (64 * PROFILE_SUB_BUCKETS)
+
+/**
+ * @brief 事件类的剖析统计结果
+ */
+struct EventProfile{
+	/**
+	 * @brief 事件类名称
+	 */
+	std::string name;
+	/**
+	 * @brief 执行次数
+	 */
+	uint64_t count = 0;
+	/**
+	 * @brief 作为条件事件执行的次数
+	 */
+	uint64_t conditionalCount = 0;
+	/**
+	 * @brief 执行耗时总计、最小值和最大值（纳秒）
+	 */
+	uint64_t totalNs = 0;
+	uint64_t minNs = UINT64_MAX;
+	uint64_t maxNs = 0;
+	/**
+	 * @brief canTrigger判断次数和满足执行条件的次数
+	 */
+	uint64_t evaluations = 0;
+	uint64_t successes = 0;
+	/**
+	 * @brief 执行时FEL和CEL长度的累计值和最大值
+	 */
+	uint64_t felSizeSum = 0;
+	uint64_t felSizeMax = 0;
+	uint64_t celSizeSum = 0;
+	uint64_t celSizeMax = 0;
+	/**
+	 * @brief 执行耗时的对数分段直方图
+	 */
+	std::vector<uint64_t> histogram;
+
+	EventProfile():histogram(PROFILE_BUCKETS,0){}
+	/**
+	 * @brief 估计执行耗时的百分位数
+	 * @param  p    百分位，取值范围(0,1)
+	 * @return double 耗时（纳秒）
+	 */
+	double percentile(double p) const;
+};
+
+/**
+ * @brief 事件执行性能剖析类，作为监视器注册到Simulator，通常由Simulator::setProfiler创建
+ */
+class Profiler:public Monitor{
+private:
+	typedef std::chrono::steady_clock::time_point TimePoint;
+	/**
+	 * @brief 按照事件类保存的剖析统计结果
+	 */
+	std::vector<EventProfile> profiles;
+	std::unordered_map<const std::type_info *,size_t> profileIndex;
+	/**
+	 * @brief 最近一次查找的事件类，连续处理同类事件时避免查找散列表
+	 */
+	const std::type_info * lastType = NULL;
+	size_t lastIndex = 0;
+	/**
+	 * @brief 正在执行的事件开始时间栈，CProcess进程在事件执行中可能触发其他事件
+	 */
+	std::vector<TimePoint> starts;
+	/**
+	 * @brief 条件事件表扫描次数、耗时和扫描开始时间
+	 */
+	uint64_t scanCount = 0;
+	uint64_t scanNs = 0;
+	TimePoint scanStart;
+	/**
+	 * @brief 仿真运行的墙钟耗时
+	 */
+	uint64_t runNs = 0;
+	TimePoint runStart;
+
+	EventProfile & profileOf(EventNotice * pEvent);
+public:
+	/**
+	 * @brief 清除全部剖析统计结果
+	 */
+	void reset();
+	/**
+	 * @brief 获得各事件类的剖析统计结果
+	 * @return const std::vector<EventProfile>& 剖析统计结果
+	 */
+	const std::vector<EventProfile> & getProfiles(){	return profiles;	};
+	/**
+	 * @brief 打印剖析报告表头，格式同DataCollection::printHeading
+	 */
+	static void printHeading();
+	/**
+	 * @brief 按照执行耗时总计从大到小打印各事件类的剖析报告，包括表头和表尾
+	 */
+	void report();
+	/**
+	 * @brief 将剖析统计结果导出为JSON文件
+	 * @param  fileName   JSON文件名称
+	 */
+	void exportJSON(const char * fileName);
+
+	virtual void runStarted(Simulator * pSimulator);
+	virtual void runFinished(Simulator * pSimulator);
+	virtual void eventTriggering(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+	virtual void eventTriggered(Simulator * pSimulator,EventNotice * pEvent,bool conditional);
+	virtual void conditionEvaluated(Simulator * pSimulator,EventNotice * pEvent,bool result);
+	virtual void conditionalScanStarted(Simulator * pSimulator);
+	virtual void conditionalScanFinished(Simulator * pSimulator);
+};
+
+}
+
+#endif /* PROFILER_H_ */
@@ -30,7 +30,8 @@ Random::~Random(){
 }
 
 double Random::nextDouble(){
-	return u(*e);
+	double x = u(*e);
+	return antithetic ? 1.0 - x : x;
 }
 
 int Random::nextInteger(int lower, int upper){
@@ -341,7 +342,8 @@ CDFDiscreteTable * rubber_duck::makeDiscreteCDFTable (int number, int valuelist[
 
 double Random::nextContinuous(CDFTable * pTable,double p){
   double  grad, x1, x2, y1,y2;
-  int i;
+  //累计概率的舍入误差使p大于最后一个累计概率时取最后一个区间
+  int i = pTable->size - 1;
 
   if (!pTable)
     err(NULLTAB);
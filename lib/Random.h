@@ -60,6 +60,10 @@ private:
 	 * @brief C++标准的均匀分布随机变量生成对象
 	 */
 	std::uniform_real_distribution<double> u{0.0,1.0};
+	/**
+	 * @brief 是否为对偶随机变量模式，对偶模式下nextDouble返回1-U
+	 */
+	bool antithetic = false;
 public:
 	/**
 	 * @brief 创建Random对象
@@ -70,6 +74,29 @@ public:
 	 * @brief 删除Random对象
 	 */
 	~Random();
+	/**
+	 * @brief 设置对偶随机变量模式，对偶模式下所有分布使用1-U代替均匀分布样本U，
+	 * 对于逆变换法生成的分布（均匀、指数、三角、Weibull、几何和经验分布等），
+	 * 相同种子的两次仿真得到负相关的对偶样本
+	 * @param  antithetic   是否为对偶模式
+	 */
+	void setAntithetic(bool antithetic){
+		this->antithetic = antithetic;
+	}
+	/**
+	 * @brief 是否为对偶随机变量模式
+	 * @return bool 是否为对偶模式
+	 */
+	bool isAntithetic(){
+		return antithetic;
+	}
+	/**
+	 * @brief 获取伪随机数生成引擎，用于保存和恢复生成器状态
+	 * @return std::mt19937_64* 生成引擎
+	 */
+	std::mt19937_64 * getEngine(){
+		return e;
+	}
 	/**
 	 * @brief 产生下一个服从[0,1]均匀分布的随机变量样本
 	 * @return double [0,1]均匀分布的随机变量样本
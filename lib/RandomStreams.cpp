@@ -0,0 +1,48 @@
+/**
+ * @file RandomStreams.cpp
+ * @brief 命名随机数子流管理类RandomStreams的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdint.h>
+#include "RandomStreams.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+RandomStreams::~RandomStreams(){
+	for(size_t i = 0;i < streams.size();i ++){
+		delete streams[i].second;
+	}
+}
+
+Random * RandomStreams::get(const char * name){
+	for(size_t i = 0;i < streams.size();i ++){
+		if(streams[i].first == name){
+			return streams[i].second;
+		}
+	}
+	Random * random = new Random(streamSeed(seed,name));
+	random->setAntithetic(antithetic);
+	streams.push_back(make_pair(string(name),random));
+	return random;
+}
+
+unsigned long RandomStreams::streamSeed(unsigned long seed,const char * name){
+	//FNV-1a散列子流名称，再与重复仿真种子一起经SplitMix64混合
+	uint64_t h = 0xCBF29CE484222325ULL;
+	for(const char * p = name;*p != 0;p ++){
+		h = (h ^ (unsigned char)*p) * 0x100000001B3ULL;
+	}
+	uint64_t z = (uint64_t)seed + h * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return (unsigned long)(z ^ (z >> 31));
+}
+
+}
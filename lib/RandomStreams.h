@@ -0,0 +1,79 @@
+/**
+ * @file RandomStreams.h
+ * @brief 命名随机数子流管理类RandomStreams，支持公共随机数和对偶随机变量方法
+ * 模型中的每个随机来源（到达、服务、路径选择等）使用独立的命名子流，子流的种子只由
+ * 重复仿真种子和子流名称确定，与子流的创建顺序和其他子流的使用次数无关。
+ * 比较不同配置时各配置的同一次重复仿真使用相同的重复仿真种子，相同来源得到同步的
+ * 随机数序列（公共随机数），从而减小配置间差值的方差。
+ * 对偶模式下全部子流使用1-U代替U，与相同种子的非对偶重复仿真组成对偶对。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef RANDOM_STREAMS_H_
+#define RANDOM_STREAMS_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include "Random.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 命名随机数子流管理类
+ */
+class RandomStreams{
+private:
+	/**
+	 * @brief 重复仿真种子
+	 */
+	unsigned long seed;
+	/**
+	 * @brief 是否为对偶模式
+	 */
+	bool antithetic;
+	/**
+	 * @brief 已创建的子流名称和随机变量生成对象
+	 */
+	std::vector<std::pair<std::string,Random *>> streams;
+public:
+	/**
+	 * @brief 创建子流管理对象
+	 * @param  seed         重复仿真种子，通常为Replication::getSeed()
+	 * @param  antithetic   是否为对偶模式，通常为Replication::isAntithetic()
+	 */
+	RandomStreams(unsigned long seed,bool antithetic = false):seed(seed),antithetic(antithetic){
+	}
+	/**
+	 * @brief 删除全部子流
+	 */
+	~RandomStreams();
+	/**
+	 * @brief 获取命名子流，第一次获取时创建
+	 * @param  name     子流名称
+	 * @return Random* 子流的随机变量生成对象
+	 */
+	Random * get(const char * name);
+	/**
+	 * @brief 是否为对偶模式
+	 * @return bool 是否为对偶模式
+	 */
+	bool isAntithetic(){
+		return antithetic;
+	}
+	/**
+	 * @brief 由重复仿真种子和子流名称导出子流种子
+	 * @param  seed     重复仿真种子
+	 * @param  name     子流名称
+	 * @return unsigned long 子流种子
+	 */
+	static unsigned long streamSeed(unsigned long seed,const char * name);
+};
+
+}
+
+#endif /* RANDOM_STREAMS_H_ */
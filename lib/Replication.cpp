@@ -0,0 +1,381 @@
+/**
+ * @file Replication.cpp
+ * @brief 并行独立重复仿真类Replication和ReplicationRunner的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "Replication.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+void Replication::record(const char * name,double value){
+	for(size_t i = 0;i < values.size();i ++){
+		if(values[i].first == name){
+			values[i].second = value;
+			return;
+		}
+	}
+	values.push_back(make_pair(string(name),value));
+}
+
+bool Replication::getValue(const char * name,double & value){
+	for(size_t i = 0;i < values.size();i ++){
+		if(values[i].first == name){
+			value = values[i].second;
+			return true;
+		}
+	}
+	return false;
+}
+
+ReplicationRunner::ReplicationRunner(ReplicationModel model,unsigned long seed,unsigned threads)
+		:model(model),seed(seed){
+	antithetic = false;
+	pool = new ThreadPool(threads);
+}
+
+ReplicationRunner::~ReplicationRunner(){
+	delete pool;
+	for(size_t i = 0;i < replications.size();i ++){
+		delete replications[i];
+	}
+	for(size_t i = 0;i < results.size();i ++){
+		delete results[i];
+	}
+}
+
+unsigned long ReplicationRunner::replicationSeed(unsigned long seed,int index){
+	//SplitMix64混合基础种子和重复序号，相邻序号得到互不相关的种子，
+	//保留53位使种子可以用double精确保存在结果表中
+	uint64_t z = (uint64_t)seed + (uint64_t)(index + 1) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z = z ^ (z >> 31);
+	return (unsigned long)(z >> 11);
+}
+
+void ReplicationRunner::setAntithetic(bool antithetic){
+	if(!replications.empty()){
+		printf("错误：需要在运行重复仿真之前设置对偶模式\n");
+		exit(0);
+	}
+	this->antithetic = antithetic;
+}
+
+void ReplicationRunner::run(int count){
+	int first = (int)replications.size();
+	if(antithetic && (first + count) % 2 != 0){
+		count ++;
+	}
+	for(int i = first;i < first + count;i ++){
+		//对偶模式下第2k和2k+1次重复仿真使用相同种子，后一次为对偶重复仿真
+		if(antithetic){
+			replications.push_back(new Replication(i,replicationSeed(seed,i / 2),i % 2 == 1));
+		}else{
+			replications.push_back(new Replication(i,replicationSeed(seed,i)));
+		}
+	}
+	for(int i = first;i < first + count;i ++){
+		Replication * replication = replications[i];
+		pool->submit([this,replication]{ model(replication); });
+	}
+	pool->wait();
+	merge();
+}
+
+bool ReplicationRunner::runUntil(const char * metric,double halfWidth,bool relative,double level,
+		int minReplications,int maxReplications){
+	int batch = (int)pool->getThreadCount();
+	if(antithetic && batch % 2 != 0){
+		batch ++;
+	}
+	minReplications = minReplications < 2 ? 2 : minReplications;
+	maxReplications = maxReplications < minReplications ? minReplications : maxReplications;
+	int count = getReplicationCount();
+	if(count < minReplications){
+		run(minReplications - count);
+	}
+	while(true){
+		Tally * result = getResult(metric);
+		if(result == NULL){
+			printf("错误：重复仿真没有记录性能指标（%s）\n",metric);
+			exit(0);
+		}
+		double current = result->confidence(level);
+		double target = relative ? halfWidth * fabs(result->mean()) : halfWidth;
+		if(current <= target){
+			return true;
+		}
+		count = getReplicationCount();
+		if(count >= maxReplications){
+			return false;
+		}
+		//半长与重复次数的平方根成反比，估计达到目标还需要的重复次数，
+		//重复次数少时方差估计不准确，每批最多使重复次数加倍，避免过多的重复仿真
+		int next = batch;
+		if(target > 0){
+			double needed = ceil(count * (current / target) * (current / target)) - count;
+			needed = needed > count ? count : needed;
+			next = needed > next ? (int)needed : next;
+		}
+		//按照线程数量的整数倍启动，保持全部工作线程忙
+		next = (next + batch - 1) / batch * batch;
+		if(count + next > maxReplications){
+			next = maxReplications - count;
+		}
+		run(next);
+	}
+}
+
+void ReplicationRunner::merge(){
+	for(size_t r = 0;r < replications.size();r ++){
+		const vector<pair<string,double>> & values = replications[r]->getValues();
+		for(size_t i = 0;i < values.size();i ++){
+			if(getResult(values[i].first.c_str()) == NULL){
+				results.push_back(new Tally(values[i].first.c_str()));
+			}
+		}
+	}
+	for(size_t i = 0;i < results.size();i ++){
+		vector<double> samples = getSamples(results[i]->getTitle());
+		results[i]->reset(0);
+		for(size_t k = 0;k < samples.size();k ++){
+			results[i]->update(samples[k],k);
+		}
+	}
+}
+
+vector<double> ReplicationRunner::getSamples(const char * metric){
+	vector<double> samples;
+	double value, other;
+	if(!antithetic){
+		for(size_t r = 0;r < replications.size();r ++){
+			if(replications[r]->getValue(metric,value)){
+				samples.push_back(value);
+			}
+		}
+		return samples;
+	}
+	for(size_t r = 0;r + 1 < replications.size();r += 2){
+		if(replications[r]->getValue(metric,value) && replications[r + 1]->getValue(metric,other)){
+			samples.push_back((value + other) / 2);
+		}
+	}
+	return samples;
+}
+
+Tally * ReplicationRunner::getResult(const char * name){
+	for(size_t i = 0;i < results.size();i ++){
+		if(strcmp(results[i]->getTitle(),name) == 0){
+			return results[i];
+		}
+	}
+	return NULL;
+}
+
+void ReplicationRunner::report(double level){
+	string t(120,'-');
+	char confidence[32];
+	snprintf(confidence,sizeof(confidence),"CONFIDENCE%%%g",level * 100);
+	cout << "重复仿真次数：" << replications.size() << "，工作线程数量：" << pool->getThreadCount()
+		<< "，基础随机数种子：" << seed << (antithetic ? "，对偶模式（REPS.为对偶对数量）" : "") << endl;
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(20) << "TITLE"
+		<< setw(10) << "REPS."
+		<< setw(16) << "MEAN"
+		<< setw(16) << "STDEV"
+		<< setw(16) << "MINIMUM"
+		<< setw(16) << "MAXIMUM"
+		<< setw(16) << confidence
+		<< setw(10) << "RELATIVE"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	for(size_t i = 0;i < results.size();i ++){
+		Tally * result = results[i];
+		double halfWidth = result->confidence(level);
+		cout << setiosflags(ios::left)
+			<< setw(20) << result->getTitle()
+			<< setw(10) << result->getObs()
+			<< setw(16) << result->mean()
+			<< setw(16) << result->stdDev()
+			<< setw(16) << result->min()
+			<< setw(16) << result->max()
+			<< setw(16) << halfWidth;
+		if(result->mean() != 0 && result->getObs() > 1){
+			cout << setw(10) << halfWidth / fabs(result->mean());
+		}else{
+			cout << setw(10) << "-";
+		}
+		cout << resetiosflags(ios::left) << endl;
+	}
+	cout << t.c_str() << endl;
+}
+
+void ReplicationRunner::reportVarianceReduction(double level){
+	string t(120,'-');
+	if(!antithetic){
+		cout << "非对偶模式，没有方差缩减结果" << endl;
+		return;
+	}
+	cout << "对偶随机变量方法的方差缩减：与同样次数的独立重复仿真比较" << endl;
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(20) << "TITLE"
+		<< setw(10) << "PAIRS"
+		<< setw(16) << "MEAN"
+		<< setw(16) << "HW ANTITHETIC"
+		<< setw(16) << "HW INDEPENDENT"
+		<< setw(16) << "CORRELATION"
+		<< setw(16) << "VAR REDUCTION%"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	for(size_t i = 0;i < results.size();i ++){
+		Tally * pairs = results[i];
+		const char * metric = pairs->getTitle();
+		//把全部重复仿真作为独立样本统计
+		Tally individual(metric);
+		individual.reset(0);
+		vector<double> first, second;
+		double value, other;
+		for(size_t r = 0;r + 1 < replications.size();r += 2){
+			if(replications[r]->getValue(metric,value) && replications[r + 1]->getValue(metric,other)){
+				individual.update(value,r);
+				individual.update(other,r + 1);
+				first.push_back(value);
+				second.push_back(other);
+			}
+		}
+		int n = pairs->getObs();
+		if(n < 2){
+			continue;
+		}
+		//均值估计量的方差：对偶对均值的样本方差/n，独立样本的样本方差/2n
+		double antitheticVar = pairs->variance() / (n - 1);
+		double independentVar = individual.variance() / (2 * n - 1);
+		//对偶对内两次重复仿真的相关系数
+		double mean1 = 0, mean2 = 0, cov = 0, var1 = 0, var2 = 0;
+		for(int k = 0;k < n;k ++){
+			mean1 += first[k] / n;
+			mean2 += second[k] / n;
+		}
+		for(int k = 0;k < n;k ++){
+			cov += (first[k] - mean1) * (second[k] - mean2);
+			var1 += (first[k] - mean1) * (first[k] - mean1);
+			var2 += (second[k] - mean2) * (second[k] - mean2);
+		}
+		cout << setiosflags(ios::left)
+			<< setw(20) << metric
+			<< setw(10) << n
+			<< setw(16) << pairs->mean()
+			<< setw(16) << pairs->confidence(level)
+			<< setw(16) << individual.confidence(level);
+		if(var1 > 0 && var2 > 0){
+			cout << setw(16) << cov / sqrt(var1 * var2);
+		}else{
+			cout << setw(16) << "-";
+		}
+		if(independentVar > 0){
+			cout << setw(16) << 100 * (1 - antitheticVar / independentVar);
+		}else{
+			cout << setw(16) << "-";
+		}
+		cout << resetiosflags(ios::left) << endl;
+	}
+	cout << t.c_str() << endl;
+}
+
+void ReplicationRunner::compare(ReplicationRunner & a,ReplicationRunner & b,double level){
+	string t(120,'-');
+	cout << "配置比较（b - a）：按照重复序号配对的差值与按独立样本估计的比较" << endl;
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(20) << "TITLE"
+		<< setw(8) << "REPS."
+		<< setw(14) << "MEAN A"
+		<< setw(14) << "MEAN B"
+		<< setw(14) << "DIFF"
+		<< setw(16) << "HW PAIRED"
+		<< setw(16) << "HW INDEPENDENT"
+		<< setw(16) << "VAR REDUCTION%"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	for(size_t i = 0;i < a.results.size();i ++){
+		const char * metric = a.results[i]->getTitle();
+		if(b.getResult(metric) == NULL){
+			continue;
+		}
+		vector<double> sa = a.getSamples(metric);
+		vector<double> sb = b.getSamples(metric);
+		size_t n = sa.size() < sb.size() ? sa.size() : sb.size();
+		if(n < 2){
+			continue;
+		}
+		Tally ta(metric), tb(metric), diff(metric);
+		ta.reset(0);
+		tb.reset(0);
+		diff.reset(0);
+		for(size_t k = 0;k < n;k ++){
+			ta.update(sa[k],k);
+			tb.update(sb[k],k);
+			diff.update(sb[k] - sa[k],k);
+		}
+		//差值均值估计量的方差：配对为差值的样本方差/n，独立样本为两个样本方差/n之和
+		double pairedVar = diff.variance() / (n - 1);
+		double independentVar = (ta.variance() + tb.variance()) / (n - 1);
+		double tv = diff.tValue((1 - level) / 2,2 * (int)n - 2);
+		cout << setiosflags(ios::left)
+			<< setw(20) << metric
+			<< setw(8) << n
+			<< setw(14) << ta.mean()
+			<< setw(14) << tb.mean()
+			<< setw(14) << diff.mean()
+			<< setw(16) << diff.confidence(level)
+			<< setw(16) << tv * sqrt(independentVar);
+		if(independentVar > 0){
+			cout << setw(16) << 100 * (1 - pairedVar / independentVar);
+		}else{
+			cout << setw(16) << "-";
+		}
+		cout << resetiosflags(ios::left) << endl;
+	}
+	cout << t.c_str() << endl;
+}
+
+void ReplicationRunner::exportCSV(const char * fileName){
+	FILE * file = fopen(fileName,"w");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	fprintf(file,"Replication,Seed");
+	for(size_t i = 0;i < results.size();i ++){
+		fprintf(file,",%s",results[i]->getTitle());
+	}
+	fprintf(file,"\n");
+	for(size_t r = 0;r < replications.size();r ++){
+		fprintf(file,"%d,%lu",replications[r]->getIndex(),replications[r]->getSeed());
+		for(size_t i = 0;i < results.size();i ++){
+			double value;
+			if(replications[r]->getValue(results[i]->getTitle(),value)){
+				fprintf(file,",%.17g",value);
+			}else{
+				fprintf(file,",");
+			}
+		}
+		fprintf(file,"\n");
+	}
+	fclose(file);
+}
+
+}
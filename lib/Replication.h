@@ -0,0 +1,272 @@
+/**
+ * @file Replication.h
+ * @brief 并行独立重复仿真类Replication和ReplicationRunner
+ * ReplicationRunner使用工作窃取线程池并行运行仿真模型的多次独立重复仿真，
+ * 每次重复仿真由模型工厂函数建立自己的Simulator和统计对象，使用由基础种子和重复序号
+ * 导出的不同随机数种子，并通过Replication对象记录本次仿真的性能指标。
+ * 全部重复仿真完成后，按照重复序号顺序将各次仿真的性能指标合并为Tally对象，
+ * 输出各性能指标在重复仿真间的均值、标准差和置信区间半长，结果与线程数量和执行顺序无关。
+ * runUntil按批运行重复仿真，直到指定性能指标的置信区间半长达到绝对或相对精度要求。
+ * 对偶模式下相邻两次重复仿真使用相同种子组成对偶对，后一次为对偶重复仿真，
+ * 模型通过RandomStreams或Random::setAntithetic使用1-U，合并统计的样本为对偶对的均值。
+ * compare按照重复序号配对比较两个配置，与相同基础种子和RandomStreams一起实现公共随机数方法。
+ * 模型工厂函数在工作线程中执行，不能使用全局变量保存模型状态；使用CProcess的模型
+ * 需要在工厂函数中调用CProcess::init。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef REPLICATION_H_
+#define REPLICATION_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include "DataCollection.h"
+#include "ThreadPool.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 一次重复仿真的上下文，提供随机数种子并记录性能指标
+ */
+class Replication{
+private:
+	/**
+	 * @brief 重复仿真序号，从0开始
+	 */
+	int index;
+	/**
+	 * @brief 随机数种子
+	 */
+	unsigned long seed;
+	/**
+	 * @brief 是否为对偶重复仿真
+	 */
+	bool antithetic;
+	/**
+	 * @brief 按照记录顺序保存的性能指标名称和取值
+	 */
+	std::vector<std::pair<std::string,double>> values;
+public:
+	/**
+	 * @brief 创建重复仿真上下文
+	 * @param  index        重复仿真序号
+	 * @param  seed         随机数种子
+	 * @param  antithetic   是否为对偶重复仿真
+	 */
+	Replication(int index,unsigned long seed,bool antithetic = false):index(index),seed(seed),antithetic(antithetic){
+	}
+	/**
+	 * @brief 获取重复仿真序号
+	 * @return int 重复仿真序号
+	 */
+	int getIndex(){
+		return index;
+	}
+	/**
+	 * @brief 获取本次重复仿真的随机数种子，用于创建Simulator和Random对象
+	 * @return unsigned long 随机数种子
+	 */
+	unsigned long getSeed(){
+		return seed;
+	}
+	/**
+	 * @brief 是否为对偶重复仿真，模型应使用RandomStreams(getSeed(),isAntithetic())创建随机数子流
+	 * @return bool 是否为对偶重复仿真
+	 */
+	bool isAntithetic(){
+		return antithetic;
+	}
+	/**
+	 * @brief 记录性能指标取值，同名指标重复记录时覆盖原值
+	 * @param  name     性能指标名称
+	 * @param  value    性能指标取值
+	 */
+	void record(const char * name,double value);
+	/**
+	 * @brief 以统计对象名称记录其均值，用于合并Tally和Accumulate的统计结果
+	 * @param  pData    统计对象
+	 */
+	void record(DataCollection * pData){
+		record(pData->getTitle(),pData->mean());
+	}
+	/**
+	 * @brief 获取本次重复仿真记录的全部性能指标
+	 * @return 性能指标名称和取值列表
+	 */
+	const std::vector<std::pair<std::string,double>> & getValues(){
+		return values;
+	}
+	/**
+	 * @brief 获取性能指标取值
+	 * @param  name     性能指标名称
+	 * @param  value    性能指标取值
+	 * @return bool 是否记录了该性能指标
+	 */
+	bool getValue(const char * name,double & value);
+};
+
+/**
+ * @brief 重复仿真模型工厂函数，建立并运行一次仿真，通过Replication对象记录性能指标
+ */
+typedef std::function<void(Replication *)> ReplicationModel;
+
+/**
+ * @brief 并行重复仿真运行类
+ */
+class ReplicationRunner{
+private:
+	/**
+	 * @brief 模型工厂函数
+	 */
+	ReplicationModel model;
+	/**
+	 * @brief 基础随机数种子
+	 */
+	unsigned long seed;
+	/**
+	 * @brief 工作线程池
+	 */
+	ThreadPool * pool;
+	/**
+	 * @brief 已完成的重复仿真，按照序号排列
+	 */
+	std::vector<Replication *> replications;
+	/**
+	 * @brief 合并后的各性能指标，按照第一次记录的顺序排列
+	 */
+	std::vector<Tally *> results;
+	/**
+	 * @brief 是否为对偶模式
+	 */
+	bool antithetic;
+
+	/**
+	 * @brief 按照重复序号顺序将各次仿真的性能指标合并为Tally对象
+	 */
+	void merge();
+	/**
+	 * @brief 获取合并统计的样本，对偶模式下为对偶对的均值
+	 * @param  metric   性能指标名称
+	 * @return 按照序号排列的样本
+	 */
+	std::vector<double> getSamples(const char * metric);
+public:
+	/**
+	 * @brief 创建并行重复仿真运行对象
+	 * @param  model    模型工厂函数
+	 * @param  seed     基础随机数种子
+	 * @param  threads  工作线程数量，为0时等于处理器核数
+	 */
+	ReplicationRunner(ReplicationModel model,unsigned long seed,unsigned threads = 0);
+	/**
+	 * @brief 删除重复仿真结果并停止工作线程
+	 */
+	~ReplicationRunner();
+	/**
+	 * @brief 设置对偶模式，需要在运行重复仿真之前设置
+	 * @param  antithetic   是否为对偶模式
+	 */
+	void setAntithetic(bool antithetic);
+	/**
+	 * @brief 是否为对偶模式
+	 * @return bool 是否为对偶模式
+	 */
+	bool isAntithetic(){
+		return antithetic;
+	}
+	/**
+	 * @brief 并行运行指定次数的重复仿真，多次调用时继续增加重复仿真，序号和随机数种子依次延续，
+	 * 对偶模式下次数向上取整为偶数
+	 * @param  count    重复仿真次数
+	 */
+	void run(int count);
+	/**
+	 * @brief 顺序重复仿真：按批并行运行重复仿真，直到性能指标的置信区间半长不大于目标值。
+	 * 每批至少为工作线程数量，根据当前半长按照n*(h/目标)^2估计还需要的重复次数，
+	 * 每批最多使重复次数加倍，达到目标后不再启动新的重复仿真
+	 * @param  metric           性能指标名称
+	 * @param  halfWidth        目标半长，relative为true时为相对于均值绝对值的比例
+	 * @param  relative         是否为相对精度
+	 * @param  level            置信水平
+	 * @param  minReplications  最少重复次数，不少于2
+	 * @param  maxReplications  最多重复次数
+	 * @return bool 是否达到精度要求，达到最多重复次数仍未满足时返回false
+	 */
+	bool runUntil(const char * metric,double halfWidth,bool relative = false,double level = 0.95,
+			int minReplications = 10,int maxReplications = 1000);
+	/**
+	 * @brief 获取已完成的重复仿真次数
+	 * @return int 重复仿真次数
+	 */
+	int getReplicationCount(){
+		return (int)replications.size();
+	}
+	/**
+	 * @brief 获取一次重复仿真的记录
+	 * @param  index    重复仿真序号
+	 * @return Replication* 重复仿真对象
+	 */
+	Replication * getReplication(int index){
+		return replications[index];
+	}
+	/**
+	 * @brief 获取工作线程数量
+	 * @return unsigned 工作线程数量
+	 */
+	unsigned getThreadCount(){
+		return pool->getThreadCount();
+	}
+	/**
+	 * @brief 获取性能指标在重复仿真间的合并统计结果，样本为各次重复仿真的指标取值
+	 * @param  name     性能指标名称
+	 * @return Tally* 合并统计结果，没有该性能指标时为NULL
+	 */
+	Tally * getResult(const char * name);
+	/**
+	 * @brief 获取全部性能指标的合并统计结果
+	 * @return 合并统计结果列表
+	 */
+	const std::vector<Tally *> & getResults(){
+		return results;
+	}
+	/**
+	 * @brief 打印各性能指标在重复仿真间的均值、标准差、最小值、最大值和置信区间半长
+	 * @param  level    置信水平
+	 */
+	void report(double level = 0.95);
+	/**
+	 * @brief 打印对偶模式的方差缩减效果：对偶对均值的方差与同样次数独立重复仿真均值方差的比较
+	 * @param  level    置信水平
+	 */
+	void reportVarianceReduction(double level = 0.95);
+	/**
+	 * @brief 按照重复序号配对比较两个配置各性能指标的差值（b - a），打印配对差值的置信区间、
+	 * 按独立样本估计的置信区间以及公共随机数方法的方差缩减比例
+	 * @param  a        配置a的重复仿真
+	 * @param  b        配置b的重复仿真
+	 * @param  level    置信水平
+	 */
+	static void compare(ReplicationRunner & a,ReplicationRunner & b,double level = 0.95);
+	/**
+	 * @brief 将每次重复仿真的随机数种子和性能指标输出到CSV文件，每次重复仿真一行
+	 * @param  fileName     文件名
+	 */
+	void exportCSV(const char * fileName);
+	/**
+	 * @brief 由基础随机数种子和重复序号导出重复仿真的随机数种子
+	 * @param  seed     基础随机数种子
+	 * @param  index    重复仿真序号
+	 * @return unsigned long 随机数种子
+	 */
+	static unsigned long replicationSeed(unsigned long seed,int index);
+};
+
+}
+
+#endif /* REPLICATION_H_ */
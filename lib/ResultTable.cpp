@@ -0,0 +1,126 @@
+/**
+ * @file ResultTable.cpp
+ * @brief 按列存储的仿真实验结果表类ResultTable的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <limits>
+#include "ResultTable.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+int ResultTable::addColumn(const char * name){
+	names.push_back(name);
+	columns.push_back(vector<double>(getRowCount(),numeric_limits<double>::quiet_NaN()));
+	return (int)names.size() - 1;
+}
+
+int ResultTable::findColumn(const char * name) const{
+	for(size_t i = 0;i < names.size();i ++){
+		if(names[i] == name){
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+size_t ResultTable::addRow(){
+	size_t row = getRowCount();
+	for(size_t i = 0;i < columns.size();i ++){
+		columns[i].push_back(numeric_limits<double>::quiet_NaN());
+	}
+	return row;
+}
+
+void ResultTable::clear(){
+	names.clear();
+	columns.clear();
+}
+
+void ResultTable::writeCSV(const char * fileName) const{
+	FILE * file = fopen(fileName,"w");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	for(size_t i = 0;i < names.size();i ++){
+		fprintf(file,"%s%s",i == 0 ? "" : ",",names[i].c_str());
+	}
+	fprintf(file,"\n");
+	size_t rows = getRowCount();
+	for(size_t r = 0;r < rows;r ++){
+		for(size_t i = 0;i < columns.size();i ++){
+			if(i > 0){
+				fprintf(file,",");
+			}
+			if(!std::isnan(columns[i][r])){
+				fprintf(file,"%.17g",columns[i][r]);
+			}
+		}
+		fprintf(file,"\n");
+	}
+	fclose(file);
+}
+
+void ResultTable::writeBinary(const char * fileName) const{
+	FILE * file = fopen(fileName,"wb");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(0);
+	}
+	ResultFileHeader header;
+	memcpy(header.magic,RESULT_MAGIC,8);
+	header.version = 1;
+	header.columnCount = (uint32_t)names.size();
+	header.rowCount = getRowCount();
+	fwrite(&header,sizeof(header),1,file);
+	for(size_t i = 0;i < names.size();i ++){
+		uint32_t length = (uint32_t)names[i].size();
+		fwrite(&length,sizeof(length),1,file);
+		fwrite(names[i].data(),1,length,file);
+	}
+	for(size_t i = 0;i < columns.size();i ++){
+		fwrite(columns[i].data(),sizeof(double),columns[i].size(),file);
+	}
+	fclose(file);
+}
+
+bool ResultTable::readBinary(const char * fileName){
+	clear();
+	FILE * file = fopen(fileName,"rb");
+	if(file == NULL){
+		return false;
+	}
+	ResultFileHeader header;
+	bool ok = fread(&header,sizeof(header),1,file) == 1 && memcmp(header.magic,RESULT_MAGIC,8) == 0
+			&& header.version == 1;
+	for(uint32_t i = 0;ok && i < header.columnCount;i ++){
+		uint32_t length = 0;
+		ok = fread(&length,sizeof(length),1,file) == 1;
+		string name(ok ? length : 0,' ');
+		ok = ok && fread(&name[0],1,length,file) == length;
+		names.push_back(name);
+	}
+	for(uint32_t i = 0;ok && i < header.columnCount;i ++){
+		vector<double> column(header.rowCount);
+		ok = fread(column.data(),sizeof(double),header.rowCount,file) == header.rowCount;
+		columns.push_back(column);
+	}
+	fclose(file);
+	if(!ok){
+		clear();
+	}
+	return ok;
+}
+
+}
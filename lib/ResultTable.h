@@ -0,0 +1,141 @@
+/**
+ * @file ResultTable.h
+ * @brief 按列存储的仿真实验结果表类ResultTable
+ * 每列为一个名称和一组double取值，所有列的行数相同，可以输出CSV文件和二进制文件。
+ * 二进制文件格式：ResultFileHeader + 列名称表 + 按列连续存储的取值，
+ * 列名称表由每个名称的长度（uint32）及内容组成，每列为rowCount个double。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef RESULT_TABLE_H_
+#define RESULT_TABLE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace rubber_duck{
+
+/**
+ * @brief 结果文件标识
+ */
+#define RESULT_MAGIC "RDRESLT1"
+
+/**
+ * @brief 二进制结果文件头
+ */
+struct ResultFileHeader{
+	char magic[8];
+	uint32_t version;
+	uint32_t columnCount;
+	uint64_t rowCount;
+};
+
+/**
+ * @brief 按列存储的结果表
+ */
+class ResultTable{
+private:
+	/**
+	 * @brief 列名称
+	 */
+	std::vector<std::string> names;
+	/**
+	 * @brief 各列取值
+	 */
+	std::vector<std::vector<double>> columns;
+public:
+	/**
+	 * @brief 添加一列，已有数据行时新列取值为NaN
+	 * @param  name     列名称
+	 * @return int 列序号
+	 */
+	int addColumn(const char * name);
+	/**
+	 * @brief 查找列序号
+	 * @param  name     列名称
+	 * @return int 列序号，没有该列时为-1
+	 */
+	int findColumn(const char * name) const;
+	/**
+	 * @brief 添加一行，各列取值为NaN
+	 * @return size_t 行序号
+	 */
+	size_t addRow();
+	/**
+	 * @brief 设置取值
+	 * @param  row      行序号
+	 * @param  column   列序号
+	 * @param  value    取值
+	 */
+	void set(size_t row,int column,double value){
+		columns[column][row] = value;
+	}
+	/**
+	 * @brief 获取取值
+	 * @param  row      行序号
+	 * @param  column   列序号
+	 * @return double 取值
+	 */
+	double get(size_t row,int column) const{
+		return columns[column][row];
+	}
+	/**
+	 * @brief 获取一列的全部取值
+	 * @param  column   列序号
+	 * @return 该列取值
+	 */
+	const std::vector<double> & getColumn(int column) const{
+		return columns[column];
+	}
+	/**
+	 * @brief 获取列名称
+	 * @param  column   列序号
+	 * @return const char* 列名称
+	 */
+	const char * getColumnName(int column) const{
+		return names[column].c_str();
+	}
+	/**
+	 * @brief 获取列数量
+	 * @return int 列数量
+	 */
+	int getColumnCount() const{
+		return (int)names.size();
+	}
+	/**
+	 * @brief 获取行数量
+	 * @return size_t 行数量
+	 */
+	size_t getRowCount() const{
+		return columns.empty() ? 0 : columns[0].size();
+	}
+	/**
+	 * @brief 删除全部行和列
+	 */
+	void clear();
+	/**
+	 * @brief 输出CSV文件，第一行为列名称，NaN输出为空
+	 * @param  fileName     文件名
+	 */
+	void writeCSV(const char * fileName) const;
+	/**
+	 * @brief 输出二进制文件
+	 * @param  fileName     文件名
+	 */
+	void writeBinary(const char * fileName) const;
+	/**
+	 * @brief 读取writeBinary输出的二进制文件
+	 * @param  fileName     文件名
+	 * @return bool 是否读取成功
+	 */
+	bool readBinary(const char * fileName);
+};
+
+}
+
+#endif /* RESULT_TABLE_H_ */
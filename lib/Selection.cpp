@@ -0,0 +1,231 @@
+/**
+ * @file Selection.cpp
+ * @brief KN全序贯排序与选择类Selection的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <cmath>
+#include "Replication.h"
+#include "Selection.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+Selection::Selection(const Design & design,ExperimentModel model,const char * metric,unsigned long seed,
+		bool minimize,unsigned threads)
+		:design(design),model(model),metric(metric),seed(seed),minimize(minimize){
+	best = -1;
+	completed = false;
+	stages = 0;
+	delta = alpha = h2 = 0;
+	n0 = maxReplications = 0;
+	pool = new ThreadPool(threads);
+}
+
+Selection::~Selection(){
+	delete pool;
+	clear();
+}
+
+void Selection::clear(){
+	for(size_t i = 0;i < tallies.size();i ++){
+		delete tallies[i];
+	}
+	tallies.clear();
+	samples.clear();
+	eliminated.clear();
+	pairVariances.clear();
+}
+
+void Selection::run(const vector<int> & systems,int count){
+	int first = (int)samples[systems[0]].size();
+	vector<Replication *> jobs;
+	for(size_t s = 0;s < systems.size();s ++){
+		for(int r = first;r < first + count;r ++){
+			//各配置的同一次重复仿真使用相同种子（公共随机数）
+			jobs.push_back(new Replication(r,ReplicationRunner::replicationSeed(seed,r)));
+		}
+	}
+	for(size_t s = 0;s < systems.size();s ++){
+		for(int r = 0;r < count;r ++){
+			Replication * job = jobs[s * count + r];
+			int system = systems[s];
+			pool->submit([this,system,job]{ model(DesignPoint(system,&design),job); });
+		}
+	}
+	pool->wait();
+	for(size_t s = 0;s < systems.size();s ++){
+		for(int r = 0;r < count;r ++){
+			Replication * job = jobs[s * count + r];
+			double value;
+			if(!job->getValue(metric.c_str(),value)){
+				printf("错误：重复仿真没有记录性能指标（%s）\n",metric.c_str());
+				exit(0);
+			}
+			samples[systems[s]].push_back(value);
+			tallies[systems[s]]->update(value,first + r);
+			delete job;
+		}
+	}
+}
+
+void Selection::eliminate(vector<int> & survivors){
+	int k = design.getPointCount();
+	int r = (int)samples[survivors[0]].size();
+	vector<int> remaining;
+	for(size_t a = 0;a < survivors.size();a ++){
+		int i = survivors[a];
+		bool inferior = false;
+		for(size_t b = 0;b < survivors.size() && !inferior;b ++){
+			int l = survivors[b];
+			if(l == i){
+				continue;
+			}
+			//三角形继续区域的半宽随重复次数线性收缩，r超过h^2*S^2/delta^2后为0
+			double w = delta / (2 * r) * (h2 * pairVariances[i * k + l] / (delta * delta) - r);
+			w = w > 0 ? w : 0;
+			double diff = tallies[i]->mean() - tallies[l]->mean();
+			inferior = (minimize ? diff : -diff) > w;
+		}
+		if(inferior){
+			eliminated[i] = r;
+		}else{
+			remaining.push_back(i);
+		}
+	}
+	survivors = remaining;
+}
+
+int Selection::select(double delta,double alpha,int n0,int maxReplications){
+	if(delta <= 0 || alpha <= 0 || alpha >= 1 || design.getPointCount() < 1){
+		printf("错误：排序与选择需要至少一个配置，无差别区间大于0，错误选择概率在0和1之间\n");
+		exit(0);
+	}
+	clear();
+	int k = design.getPointCount();
+	this->delta = delta;
+	this->alpha = alpha;
+	this->n0 = n0 = n0 < 2 ? 2 : n0;
+	this->maxReplications = maxReplications = maxReplications < n0 ? n0 : maxReplications;
+	for(int i = 0;i < k;i ++){
+		samples.push_back(vector<double>());
+		tallies.push_back(new Tally(metric.c_str()));
+		tallies[i]->reset(0);
+		eliminated.push_back(0);
+	}
+	vector<int> survivors;
+	for(int i = 0;i < k;i ++){
+		survivors.push_back(i);
+	}
+	run(survivors,n0);
+	stages = 1;
+
+	//KN方法的继续区域常数：h^2 = 2*eta*(n0-1)，eta = ((2*alpha/(k-1))^(-2/(n0-1)) - 1) / 2
+	double eta = k > 1 ? (pow(2 * alpha / (k - 1),-2.0 / (n0 - 1)) - 1) / 2 : 0;
+	h2 = 2 * eta * (n0 - 1);
+	pairVariances.assign(k * k,0);
+	for(int i = 0;i < k;i ++){
+		for(int l = i + 1;l < k;l ++){
+			Tally diff("DIFF");
+			diff.reset(0);
+			for(int r = 0;r < n0;r ++){
+				diff.update(samples[i][r] - samples[l][r],r);
+			}
+			//Tally的方差除以n，换算为除以n-1的样本方差
+			pairVariances[i * k + l] = pairVariances[l * k + i] = diff.variance() * n0 / (n0 - 1);
+		}
+	}
+	eliminate(survivors);
+
+	//每阶段的重复次数使全部工作线程忙，配置越少每个配置的重复次数越多
+	int threads = (int)pool->getThreadCount();
+	while(survivors.size() > 1){
+		int r = (int)samples[survivors[0]].size();
+		if(r >= maxReplications){
+			break;
+		}
+		int batch = (threads + (int)survivors.size() - 1) / (int)survivors.size();
+		batch = r + batch > maxReplications ? maxReplications - r : batch;
+		run(survivors,batch);
+		stages ++;
+		eliminate(survivors);
+	}
+	completed = survivors.size() == 1;
+	best = survivors[0];
+	for(size_t s = 1;s < survivors.size();s ++){
+		double diff = tallies[survivors[s]]->mean() - tallies[best]->mean();
+		if(minimize ? diff < 0 : diff > 0){
+			best = survivors[s];
+		}
+	}
+	return best;
+}
+
+int Selection::getTotalReplications(){
+	int total = 0;
+	for(size_t i = 0;i < samples.size();i ++){
+		total += (int)samples[i].size();
+	}
+	return total;
+}
+
+int Selection::getWorstCaseReplications(){
+	int k = design.getPointCount();
+	int total = 0;
+	for(int i = 0;i < k;i ++){
+		int n = n0;
+		for(int l = 0;l < k;l ++){
+			if(l != i){
+				int stop = (int)floor(h2 * pairVariances[i * k + l] / (delta * delta)) + 1;
+				n = stop > n ? stop : n;
+			}
+		}
+		total += n < maxReplications ? n : maxReplications;
+	}
+	return total;
+}
+
+void Selection::report(){
+	string t(120,'-');
+	const vector<string> & names = design.getNames();
+	cout << "配置数量：" << design.getPointCount() << "，性能指标：" << metric << (minimize ? "（最小）" : "（最大）")
+		<< "，无差别区间：" << delta << "，错误选择概率：" << alpha << "，第一阶段重复次数：" << n0
+		<< "，阶段数量：" << stages << "，工作线程数量：" << pool->getThreadCount() << endl;
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left) << setw(8) << "SYSTEM";
+	for(size_t f = 0;f < names.size();f ++){
+		cout << setw(14) << names[f];
+	}
+	cout << setw(8) << "REPS."
+		<< setw(16) << "MEAN"
+		<< setw(16) << "STDEV"
+		<< setw(12) << "STATUS"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	for(int i = 0;i < design.getPointCount();i ++){
+		cout << setiosflags(ios::left) << setw(8) << i;
+		for(size_t f = 0;f < names.size();f ++){
+			cout << setw(14) << design.getPoint(i)[f];
+		}
+		cout << setw(8) << getReplications(i)
+			<< setw(16) << tallies[i]->mean()
+			<< setw(16) << tallies[i]->stdDev()
+			<< setw(12) << (i == best ? "SELECTED" : eliminated[i] > 0 ? "ELIMINATED" : "SURVIVED")
+			<< resetiosflags(ios::left) << endl;
+	}
+	cout << t.c_str() << endl;
+	int total = getTotalReplications();
+	int worst = getWorstCaseReplications();
+	cout << (completed ? "选择结果：配置" : "达到最多重复次数，按样本均值选择：配置") << best
+		<< "，总重复次数：" << total << "，不淘汰配置时需要：" << worst
+		<< "，节省：" << (worst > 0 ? 100.0 * (worst - total) / worst : 0) << "%" << endl;
+}
+
+}
@@ -0,0 +1,181 @@
+/**
+ * @file Selection.h
+ * @brief 排序与选择类Selection，使用KN全序贯淘汰方法从多个配置中选择最优配置
+ * 每个配置为实验设计的一个设计点，配置的同一次重复仿真使用相同种子（公共随机数）。
+ * 第一阶段每个配置并行运行n0次重复仿真，由配对差值的样本方差确定各配置对的继续区域；
+ * 之后各阶段只对未淘汰的配置增加重复仿真，样本均值明显劣于其他配置的配置被淘汰，
+ * 只剩一个配置时停止，以不低于1-alpha的概率选中与最优配置相差不小于delta的最优配置
+ * （无差别区间为delta）。每阶段的重复次数按照线程数量和剩余配置数量确定，保持工作线程忙，
+ * 因此淘汰检查的时机与线程数量有关，各配置的重复次数可能随线程数量不同。
+ * 达到最多重复次数仍有多个配置未淘汰时，选择样本均值最优的配置。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef SELECTION_H_
+#define SELECTION_H_
+
+#include <string>
+#include <vector>
+#include "DataCollection.h"
+#include "ThreadPool.h"
+#include "Experiment.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief KN全序贯排序与选择类
+ */
+class Selection{
+private:
+	/**
+	 * @brief 实验设计，每个设计点为一个配置
+	 */
+	Design design;
+	/**
+	 * @brief 实验模型函数
+	 */
+	ExperimentModel model;
+	/**
+	 * @brief 比较的性能指标名称
+	 */
+	std::string metric;
+	/**
+	 * @brief 基础随机数种子
+	 */
+	unsigned long seed;
+	/**
+	 * @brief 是否选择性能指标最小的配置，为false时选择最大的配置
+	 */
+	bool minimize;
+	/**
+	 * @brief 工作线程池
+	 */
+	ThreadPool * pool;
+	/**
+	 * @brief 每个配置各次重复仿真的性能指标取值
+	 */
+	std::vector<std::vector<double>> samples;
+	/**
+	 * @brief 每个配置性能指标的统计
+	 */
+	std::vector<Tally *> tallies;
+	/**
+	 * @brief 配置淘汰时的重复次数，未淘汰时为0
+	 */
+	std::vector<int> eliminated;
+	/**
+	 * @brief 选中的配置序号
+	 */
+	int best;
+	/**
+	 * @brief 是否在达到最多重复次数之前完成选择
+	 */
+	bool completed;
+	/**
+	 * @brief 运行阶段数量
+	 */
+	int stages;
+	/**
+	 * @brief 选择参数：无差别区间、错误选择概率和继续区域常数h^2
+	 */
+	double delta, alpha, h2;
+	/**
+	 * @brief 第一阶段重复次数和每个配置最多重复次数
+	 */
+	int n0, maxReplications;
+	/**
+	 * @brief 第一阶段配对差值的样本方差，下标为i*配置数量+l
+	 */
+	std::vector<double> pairVariances;
+
+	/**
+	 * @brief 删除统计结果
+	 */
+	void clear();
+	/**
+	 * @brief 对指定配置并行运行重复仿真，序号从当前重复次数开始
+	 * @param  systems  配置序号
+	 * @param  count    每个配置的重复次数
+	 */
+	void run(const std::vector<int> & systems,int count);
+	/**
+	 * @brief 淘汰劣于其他未淘汰配置的配置
+	 * @param  survivors    未淘汰的配置序号，淘汰后更新
+	 */
+	void eliminate(std::vector<int> & survivors);
+public:
+	/**
+	 * @brief 创建排序与选择对象
+	 * @param  design   实验设计，每个设计点为一个配置
+	 * @param  model    实验模型函数
+	 * @param  metric   比较的性能指标名称
+	 * @param  seed     基础随机数种子
+	 * @param  minimize 是否选择性能指标最小的配置
+	 * @param  threads  工作线程数量，为0时等于处理器核数
+	 */
+	Selection(const Design & design,ExperimentModel model,const char * metric,unsigned long seed,
+			bool minimize = true,unsigned threads = 0);
+	~Selection();
+	/**
+	 * @brief 运行KN全序贯选择过程
+	 * @param  delta            无差别区间，小于delta的差异认为无关紧要
+	 * @param  alpha            错误选择概率上限
+	 * @param  n0               第一阶段每个配置的重复次数，不少于2
+	 * @param  maxReplications  每个配置最多重复次数
+	 * @return int 选中的配置序号
+	 */
+	int select(double delta,double alpha = 0.05,int n0 = 10,int maxReplications = 1000);
+	/**
+	 * @brief 获取选中的配置序号
+	 * @return int 配置序号
+	 */
+	int getBest(){
+		return best;
+	}
+	/**
+	 * @brief 是否在达到最多重复次数之前只剩一个配置
+	 * @return bool 是否完成选择
+	 */
+	bool isCompleted(){
+		return completed;
+	}
+	/**
+	 * @brief 获取配置性能指标的统计
+	 * @param  system   配置序号
+	 * @return Tally* 统计结果
+	 */
+	Tally * getSummary(int system){
+		return tallies[system];
+	}
+	/**
+	 * @brief 获取配置的重复次数
+	 * @param  system   配置序号
+	 * @return int 重复次数
+	 */
+	int getReplications(int system){
+		return (int)samples[system].size();
+	}
+	/**
+	 * @brief 获取全部配置的重复次数之和
+	 * @return int 重复次数之和
+	 */
+	int getTotalReplications();
+	/**
+	 * @brief 获取不淘汰配置时达到同样选择精度需要的重复次数之和，
+	 * 即每个配置都运行到最大的配对停止次数
+	 * @return int 重复次数之和
+	 */
+	int getWorstCaseReplications();
+	/**
+	 * @brief 打印各配置的因子取值、重复次数、均值、标准差、淘汰阶段和选择结果
+	 */
+	void report();
+};
+
+}
+
+#endif /* SELECTION_H_ */
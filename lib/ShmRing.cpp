@@ -0,0 +1,132 @@
+/**
+ * @file ShmRing.cpp
+ * @brief POSIX共享内存环形缓冲区ShmRing的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+#include "ShmRing.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+//记录按照8字节对齐
+static inline uint64_t alignRecord(uint64_t size){
+	return (size + 7) & ~(uint64_t)7;
+}
+
+ShmRing::ShmRing(size_t capacity){
+	capacity = (size_t)alignRecord(capacity > 64 ? capacity : 64);
+	mappedSize = sizeof(ShmRingHeader) + capacity;
+#ifndef _WIN32
+	//同一进程创建的共享内存对象按照进程号和序号命名
+	static atomic<unsigned> sequence(0);
+	char name[64];
+	snprintf(name,sizeof(name),"/rubberduck-%d-%u",(int)getpid(),sequence ++);
+	int fd = shm_open(name,O_CREAT | O_EXCL | O_RDWR,0600);
+	if(fd < 0){
+		printf("错误：创建共享内存（%s）失败：%s\n",name,strerror(errno));
+		exit(0);
+	}
+	if(ftruncate(fd,(off_t)mappedSize) != 0){
+		printf("错误：设置共享内存（%s）大小%zu字节失败：%s\n",name,mappedSize,strerror(errno));
+		::close(fd);
+		shm_unlink(name);
+		exit(0);
+	}
+	void * address = mmap(NULL,mappedSize,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+	::close(fd);
+	//映射保持有效，删除名称后不会在进程异常终止时遗留共享内存对象
+	shm_unlink(name);
+	if(address == MAP_FAILED){
+		printf("错误：映射共享内存（%s）失败：%s\n",name,strerror(errno));
+		exit(0);
+	}
+	header = new(address) ShmRingHeader();
+	header->head.store(0);
+	header->tail.store(0);
+	header->closed.store(0);
+	header->capacity = capacity;
+	data = (char *)address + sizeof(ShmRingHeader);
+#else
+	printf("错误：共享内存环形缓冲区只支持POSIX系统\n");
+	exit(0);
+#endif
+}
+
+ShmRing::~ShmRing(){
+#ifndef _WIN32
+	munmap(header,mappedSize);
+#endif
+}
+
+void ShmRing::copyIn(uint64_t position,const void * source,size_t size){
+	size_t offset = (size_t)(position % header->capacity);
+	size_t first = size < header->capacity - offset ? size : header->capacity - offset;
+	memcpy(data + offset,source,first);
+	memcpy(data,(const char *)source + first,size - first);
+}
+
+void ShmRing::copyOut(uint64_t position,void * target,size_t size){
+	size_t offset = (size_t)(position % header->capacity);
+	size_t first = size < header->capacity - offset ? size : header->capacity - offset;
+	memcpy(target,data + offset,first);
+	memcpy((char *)target + first,data,size - first);
+}
+
+bool ShmRing::write(const void * record,size_t size){
+	uint64_t need = alignRecord(sizeof(uint32_t) + size);
+	if(need > header->capacity){
+		printf("错误：记录（%zu字节）超过共享内存环形缓冲区的容量（%llu字节）\n",size,
+				(unsigned long long)header->capacity);
+		exit(0);
+	}
+	uint64_t head = header->head.load(memory_order_relaxed);
+	uint64_t tail = header->tail.load(memory_order_acquire);
+	if(header->capacity - (head - tail) < need){
+		return false;
+	}
+	uint32_t length = (uint32_t)size;
+	copyIn(head,&length,sizeof(length));
+	copyIn(head + sizeof(length),record,size);
+	//记录数据写入后再发布写入位置
+	header->head.store(head + need,memory_order_release);
+	return true;
+}
+
+bool ShmRing::read(string & record){
+	uint64_t tail = header->tail.load(memory_order_relaxed);
+	uint64_t head = header->head.load(memory_order_acquire);
+	if(tail == head){
+		return false;
+	}
+	uint32_t length = 0;
+	copyOut(tail,&length,sizeof(length));
+	record.resize(length);
+	copyOut(tail + sizeof(length),&record[0],length);
+	//记录数据读出后再释放空间
+	header->tail.store(tail + alignRecord(sizeof(length) + length),memory_order_release);
+	return true;
+}
+
+void ShmRing::clear(){
+	header->head.store(0);
+	header->tail.store(0);
+	header->closed.store(0);
+}
+
+}
@@ -0,0 +1,125 @@
+/**
+ * @file ShmRing.h
+ * @brief POSIX共享内存中的单生产者单消费者环形缓冲区ShmRing
+ * 环形缓冲区由shm_open创建的共享内存对象映射得到，映射后立即删除共享内存对象的名称，
+ * 进程异常终止时操作系统自动回收共享内存。在fork之前创建的环形缓冲区由父进程和子进程共享，
+ * 一个进程写入记录，另一个进程读取记录。写入位置和读取位置是单调递增的字节计数，
+ * 分别占用独立的缓存行，只由写入方或读取方修改，不需要锁。
+ * 每条记录由4字节长度和记录数据组成，按照8字节对齐。读取方不再需要记录时关闭缓冲区，
+ * 写入方据此丢弃尚未写入的记录。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef SHM_RING_H_
+#define SHM_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+namespace rubber_duck{
+
+/**
+ * @brief 共享内存环形缓冲区的头部
+ */
+struct ShmRingHeader{
+	/**
+	 * @brief 写入位置，只由写入方修改
+	 */
+	alignas(64) std::atomic<uint64_t> head;
+	/**
+	 * @brief 读取位置，只由读取方修改
+	 */
+	alignas(64) std::atomic<uint64_t> tail;
+	/**
+	 * @brief 读取方是否已关闭，关闭后写入方不再需要写入记录
+	 */
+	alignas(64) std::atomic<uint32_t> closed;
+	/**
+	 * @brief 数据区字节数
+	 */
+	uint64_t capacity;
+};
+
+/**
+ * @brief 单生产者单消费者共享内存环形缓冲区
+ */
+class ShmRing{
+private:
+	/**
+	 * @brief 映射的共享内存：头部和数据区
+	 */
+	ShmRingHeader * header;
+	char * data;
+	size_t mappedSize;
+	/**
+	 * @brief 从环形位置position开始复制size字节，处理数据区末尾的回绕
+	 */
+	void copyIn(uint64_t position,const void * source,size_t size);
+	void copyOut(uint64_t position,void * target,size_t size);
+public:
+	/**
+	 * @brief 创建共享内存环形缓冲区，失败时报错退出
+	 * @param  capacity     数据区字节数，向上取整为8的倍数
+	 */
+	ShmRing(size_t capacity);
+	/**
+	 * @brief 解除共享内存映射
+	 */
+	~ShmRing();
+	ShmRing(const ShmRing &) = delete;
+	ShmRing & operator=(const ShmRing &) = delete;
+	/**
+	 * @brief 写入一条记录，只能由写入方调用
+	 * @param  record   记录数据
+	 * @param  size     记录字节数，加上长度后不能超过数据区字节数
+	 * @return bool 是否写入，剩余空间不足时不写入
+	 */
+	bool write(const void * record,size_t size);
+	/**
+	 * @brief 读取一条记录，只能由读取方调用
+	 * @param  record   读取的记录数据
+	 * @return bool 是否读取，没有记录时为false
+	 */
+	bool read(std::string & record);
+	/**
+	 * @brief 是否没有未读取的记录
+	 * @return bool 是否为空
+	 */
+	bool empty(){
+		return header->head.load(std::memory_order_acquire) == header->tail.load(std::memory_order_acquire);
+	}
+	/**
+	 * @brief 读取方关闭缓冲区，通知写入方以后写入的记录不会再被读取
+	 */
+	void close(){
+		header->closed.store(1,std::memory_order_release);
+	}
+	/**
+	 * @brief 读取方是否已关闭缓冲区
+	 * @return bool 是否已关闭
+	 */
+	bool isClosed(){
+		return header->closed.load(std::memory_order_acquire) != 0;
+	}
+	/**
+	 * @brief 清空并重新打开缓冲区，只能在没有进程访问时调用
+	 */
+	void clear();
+	/**
+	 * @brief 获取数据区字节数
+	 * @return size_t 字节数
+	 */
+	size_t getCapacity(){
+		return (size_t)header->capacity;
+	}
+};
+
+}
+
+#endif /* SHM_RING_H_ */
@@ -9,13 +9,37 @@
  */
 
 #include <vector>
+#include <string>
+#include <algorithm>
 #include <stdarg.h>
+#include <float.h>
+#include <string.h>
 #include "platdefs.h"
+#ifndef _WIN32
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
 #include "Error.h"
+#include "OutputWriter.h"
+#include "BinaryTrace.h"
+#include "ChromeTrace.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include "Checkpoint.h"
+#include "DataCollection.h"
+#include "CProcess.h"
 #include "Simulator.h"
 
 using namespace rubber_duck;
 
+//工作线程正在执行的同时事件的副作用记录及其所属的仿真引擎，不在并行执行同时事件时为NULL，
+//事件处理函数操作其他仿真引擎时不推迟提交
+static thread_local DeferredEffects * currentEffects = NULL;
+static thread_local Simulator * currentEffectsOwner = NULL;
+
 Simulator::Simulator(unsigned long int seed,const char * printFileName){
 	//初始化随机数流
 	random = new Random(seed);
@@ -31,14 +55,44 @@ Simulator::Simulator(unsigned long int seed,const char * printFileName){
 		}
 	}
 	//为避免中文乱码，需要在Windows的命令行终端输入"chcp 65001"命令，将编码改为utf-8
+	if(instanceHook != NULL){
+		instanceHook(this,true);
+	}
 }
 
+InstanceHook Simulator::instanceHook = NULL;
+
+//通知所有注册的监视器
+#define NOTIFY_MONITORS(call) do{ \
+	if(!monitors.empty()){ \
+		for(size_t m = 0;m < monitors.size();m ++){ \
+			monitors[m]->call; \
+		} \
+	} \
+}while(0)
+
 Simulator::~Simulator(){
+	if(instanceHook != NULL){
+		instanceHook(this,false);
+	}
+	//关闭二进制跟踪文件
+	setBinaryTrace(NULL);
+	setChromeTrace(NULL);
+	setProfiler(false);
+	setPerfCounters(false);
+	//输出全部异步打印内容
+	if (writer != NULL){
+		delete writer;
+	}
 	//关闭输出打印文件
 	if (printFile != NULL){
 		fclose(printFile);
 	}
 	delete random;
+	setSimultaneousThreads(0);
+	inbox.drain([](EventNotice * pEvent){
+		delete pEvent;
+	});
 	futureEventList.removeAll();
 	conditionalEventList.removeAll();
 }
@@ -51,6 +105,9 @@ void Simulator::reset(unsigned long int seed,const char * printFileName){
 	}
 	//创建输出打印文件
 	if (printFileName != NULL){
+		//异步打印的后台输出线程需要切换到新的输出打印文件
+		bool async = writer != NULL;
+		setAsyncOutput(false);
 		if(printFile != NULL){
 			fclose(printFile);
 		}
@@ -59,6 +116,7 @@ void Simulator::reset(unsigned long int seed,const char * printFileName){
 			printf("错误：打开文件失败（%s），请检查路径或访问权限\n",printFileName);
 			exit(0);
 		}
+		setAsyncOutput(async);
 	}
 	clock = 0;
 	duration = -1;
@@ -66,7 +124,81 @@ void Simulator::reset(unsigned long int seed,const char * printFileName){
 	conditionalEventList.removeAll();
 }
 
+void Simulator::stop(){
+	terminated = true;
+	flush();
+}
+
+void Simulator::addMonitor(Monitor * pMonitor){
+	monitors.push_back(pMonitor);
+}
+
+void Simulator::removeMonitor(Monitor * pMonitor){
+	for(std::vector<Monitor *>::iterator it = monitors.begin();it != monitors.end();it ++){
+		if(*it == pMonitor){
+			monitors.erase(it);
+			return;
+		}
+	}
+}
+
+void Simulator::setBinaryTrace(const char * traceFileName){
+	if(binaryTrace != NULL){
+		removeMonitor(binaryTrace);
+		delete binaryTrace;
+		binaryTrace = NULL;
+	}
+	if(traceFileName != NULL){
+		binaryTrace = new BinaryTrace(traceFileName);
+		addMonitor(binaryTrace);
+	}
+}
+
+void Simulator::setProfiler(bool enable){
+	if(profiler != NULL){
+		removeMonitor(profiler);
+		delete profiler;
+		profiler = NULL;
+	}
+	if(enable){
+		profiler = new Profiler();
+		addMonitor(profiler);
+	}
+}
+
+void Simulator::setPerfCounters(bool enable){
+	if(perfCounters != NULL){
+		removeMonitor(perfCounters);
+		delete perfCounters;
+		perfCounters = NULL;
+	}
+	if(enable){
+		perfCounters = new PerfCounters();
+		//计数器不可用时不注册监视器，仅保留不可用原因供report打印
+		if(perfCounters->isAvailable()){
+			addMonitor(perfCounters);
+		}
+	}
+}
+
+void Simulator::setChromeTrace(const char * traceFileName){
+	if(chromeTrace != NULL){
+		removeMonitor(chromeTrace);
+		delete chromeTrace;
+		chromeTrace = NULL;
+	}
+	if(traceFileName != NULL){
+		chromeTrace = new ChromeTrace(traceFileName);
+		addMonitor(chromeTrace);
+	}
+}
+
 void Simulator::cancelEvent(EventNotice * pEvent){
+	if(deferring && currentEffectsOwner == this){
+		currentEffects->operations.push_back(std::make_pair(DeferredEffects::CANCEL,pEvent));
+		return;
+	}
+	NOTIFY_MONITORS(eventCancelled(this,pEvent));
 	futureEventList.removeEvent(pEvent);
 	conditionalEventList.removeEvent(pEvent);
 }
@@ -87,19 +219,25 @@ void Simulator::scheduleEvent(EventNotice * pEvent){
 		printf("仿真时间=%f，事件：%s 发生时间小于当前仿真时间！\n",clock,pEvent->getName());
 		exit(0);
 	}
+	if(deferring && currentEffectsOwner == this){
+		currentEffects->operations.push_back(std::make_pair(DeferredEffects::SCHEDULE,pEvent));
+		return;
+	}
 	//按照事件时间添加仿真事件
 	futureEventList.insertEvent(pEvent);
-	if(debug){
-		print("仿真时间=%f 在FEL中添加未来事件(%s),发生时间：%f。\n",clock,pEvent->getName(),pEvent->getTime());
-	}
+	NOTIFY_MONITORS(eventScheduled(this,pEvent,false));
+	SIM_TRACE(this,"仿真时间=%f 在FEL中添加未来事件(%s),发生时间：%f。\n",clock,pEvent->getName(),pEvent->getTime());
 }
 
 void Simulator::scheduleConditionalEvent(EventNotice * pEvent){
+	if(deferring && currentEffectsOwner == this){
+		currentEffects->operations.push_back(std::make_pair(DeferredEffects::SCHEDULE_CONDITIONAL,pEvent));
+		return;
+	}
 	//添加条件事件
 	conditionalEventList.insertEvent(pEvent);
-	if(debug){
-		print("仿真时间=%f 在CEL中添加条件事件{%s}。\n",clock,pEvent->getName());
-	}
+	NOTIFY_MONITORS(eventScheduled(this,pEvent,true));
+	SIM_TRACE(this,"仿真时间=%f 在CEL中添加条件事件{%s}。\n",clock,pEvent->getName());
 }
 
 bool Simulator::isEnd(){
@@ -113,14 +251,7 @@ bool Simulator::isEnd(){
 }
 
 void Simulator::triggerEvent(EventNotice* pEvent){
-	//Step2: 将CLOCK推进至该事件的时间
-	clock = pEvent->getTime();
-	if(debug){
-		print("仿真时间=%f 发生事件(%s)。\n",clock,pEvent->getName());
-	}
-	//Step3: 执行该事件，更新Snapshot表
-	//Step4: 如果必要，调度新的未来事件
-	pEvent->trigger(this);
+	dispatchEvent(pEvent);
 	//如果不需要保留事件，则删除当前事件
 	if(!pEvent->isReserved()){
 		//删除事件
@@ -128,6 +259,30 @@ void Simulator::triggerEvent(EventNotice* pEvent){
 	}
 }
 
+void Simulator::dispatchEvent(EventNotice* pEvent){
+	//Step2: 将CLOCK推进至该事件的时间
+	clock = pEvent->getTime();
+	//Step3: 执行该事件，更新Snapshot表
+	//Step4: 如果必要，调度新的未来事件
+	executeEvent(pEvent,false);
+	eventCount ++;
+}
+
+void Simulator::executeEvent(EventNotice* pEvent,bool conditional){
+	if(conditional){
+		SIM_TRACE(this,"仿真时间=%f 发生条件事件{%s}\n",clock,pEvent->getName());
+	}else{
+		SIM_TRACE(this,"仿真时间=%f 发生事件(%s)。\n",clock,pEvent->getName());
+	}
+	NOTIFY_MONITORS(eventTriggering(this,pEvent,conditional));
+	if(triggerFunction != NULL){
+		triggerFunction(pEvent,this);
+	}else{
+		pEvent->trigger(this);
+	}
+	NOTIFY_MONITORS(eventTriggered(this,pEvent,conditional));
+}
+
 void Simulator::scanFutureEvents(bool CEL){
 	if(futureEventList.size() == 0){
 		return;
@@ -138,6 +293,10 @@ void Simulator::scanFutureEvents(bool CEL){
 		//Step2: 将CLOCK推进至该事件的时间
 		clock = CEL[0]->getTime();
 		//按照事件优先级排序调度时间相同的事件
+		if(simultaneousPool != NULL && CEL.size() > 1 && monitors.empty()){
+			triggerSimultaneousEvents(CEL);
+			return;
+		}
 		for (unsigned i = 0;i < CEL.size();i ++){
 			EventNotice* pEvent = CEL[i];
 			triggerEvent(pEvent);
@@ -149,6 +308,112 @@ void Simulator::scanFutureEvents(bool CEL){
 	}
 }
 
+void Simulator::triggerSimultaneousEvents(std::vector<EventNotice*> & events){
+	size_t begin = 0;
+	for(size_t i = 0;i <= events.size();i ++){
+		if(i < events.size() && events[i]->getConflictKey() >= 0){
+			continue;
+		}
+		//[begin,i)为设置了冲突键的连续事件，未设置冲突键的事件在前后两批之间串行执行
+		triggerIndependentEvents(events,begin,i);
+		if(i < events.size()){
+			triggerEvent(events[i]);
+		}
+		begin = i + 1;
+	}
+}
+
+void Simulator::triggerIndependentEvents(std::vector<EventNotice*> & events,size_t begin,size_t end){
+	if(end <= begin){
+		return;
+	}
+	simultaneousOrder.clear();
+	for(size_t i = begin;i < end;i ++){
+		simultaneousOrder.push_back(i);
+	}
+	//按照冲突键稳定排序，同一冲突键的事件连续排列并保持优先级顺序
+	std::stable_sort(simultaneousOrder.begin(),simultaneousOrder.end(),[&](size_t a,size_t b){
+		return events[a]->getConflictKey() < events[b]->getConflictKey();
+	});
+	if(events[simultaneousOrder.front()]->getConflictKey() == events[simultaneousOrder.back()]->getConflictKey()){
+		for(size_t i = begin;i < end;i ++){
+			triggerEvent(events[i]);
+		}
+		return;
+	}
+#ifndef NDEBUG
+	//进程对象在工作线程中切换协程会使用工作线程的主协程，不能并行执行
+	for(size_t i = begin;i < end;i ++){
+		if(dynamic_cast<ProcessNotice *>(events[i]) != NULL || dynamic_cast<CProcess *>(events[i]) != NULL){
+			printf("错误：进程对象（%s）设置了冲突键，进程不能与其他同时事件并行执行\n",events[i]->getName());
+			exit(0);
+		}
+	}
+#endif
+	simultaneousEffects.resize(end - begin);
+	for(size_t i = 0;i < simultaneousEffects.size();i ++){
+		simultaneousEffects[i].operations.clear();
+		simultaneousEffects[i].output.clear();
+	}
+	deferring = true;
+	for(size_t g = 0;g < simultaneousOrder.size();){
+		size_t h = g + 1;
+		while(h < simultaneousOrder.size()
+				&& events[simultaneousOrder[h]]->getConflictKey() == events[simultaneousOrder[g]]->getConflictKey()){
+			h ++;
+		}
+		simultaneousPool->submit([this,&events,begin,g,h](){
+			for(size_t k = g;k < h;k ++){
+				size_t index = simultaneousOrder[k];
+				EventNotice * pEvent = events[index];
+				currentEffects = &simultaneousEffects[index - begin];
+				currentEffectsOwner = this;
+				executeEvent(pEvent,false);
+				currentEffects = NULL;
+				currentEffectsOwner = NULL;
+			}
+		});
+		g = h;
+	}
+	simultaneousPool->wait();
+	deferring = false;
+	//按照优先级顺序提交副作用，时间相同的新事件加入未来事件表的顺序与线程调度无关
+	for(size_t i = begin;i < end;i ++){
+		DeferredEffects & effects = simultaneousEffects[i - begin];
+		if(!effects.output.empty()){
+			print("%s",effects.output.c_str());
+		}
+		for(size_t k = 0;k < effects.operations.size();k ++){
+			EventNotice * pEvent = effects.operations[k].second;
+			switch(effects.operations[k].first){
+			case DeferredEffects::SCHEDULE:
+				scheduleEvent(pEvent);
+				break;
+			case DeferredEffects::SCHEDULE_CONDITIONAL:
+				scheduleConditionalEvent(pEvent);
+				break;
+			case DeferredEffects::CANCEL:
+				cancelEvent(pEvent);
+				break;
+			}
+		}
+		eventCount ++;
+		if(!events[i]->isReserved()){
+			delete events[i];
+		}
+	}
+}
+
+void Simulator::setSimultaneousThreads(unsigned threads){
+	if(simultaneousPool != NULL){
+		delete simultaneousPool;
+		simultaneousPool = NULL;
+	}
+	if(threads > 1){
+		simultaneousPool = new ThreadPool(threads);
+	}
+}
+
 class EndEvent:public EventNotice{
 public:
 	EndEvent(double time):EventNotice(time) {
@@ -159,8 +424,9 @@ public:
     };
 };
 
-void Simulator::run(double duration,bool bCEL){
+void Simulator::startRun(double duration){
 	this->duration = duration;
+	NOTIFY_MONITORS(runStarted(this));
 
 	//扫描调度条件事件,避免仿真模型初始化时不存在确定事件，仅存在条件事件
 	scanConditionalEvents();
@@ -168,17 +434,275 @@ void Simulator::run(double duration,bool bCEL){
 	if(duration > 0){
 		scheduleEvent(new EndEvent(duration));
 	}
+}
 
-	//按照解结规则执行相同时间的仿真事件
-	while(!isEnd()){
+void Simulator::finishRun(){
+	NOTIFY_MONITORS(runFinished(this));
+	flush();
+}
+
+void Simulator::run(double duration,bool bCEL){
+	startRun(duration);
+	//按照解结规则执行相同时间的仿真事件，每次循环开始时取出其他线程投递的事件
+	while(true){
+		drainInbox();
+		if(isEnd()){
+			break;
+		}
 		//扫描调度未来事件
 		scanFutureEvents(bCEL);
 		//扫描调度条件事件
 		scanConditionalEvents();
 	}
+	finishRun();
+}
+
+void Simulator::runUntil(double time){
+	scanConditionalEvents();
+	drainInbox();
+	while(!terminated && !futureEventList.isEmpty() && futureEventList.getImminentEventTime() < time){
+		scanFutureEvents(false);
+		scanConditionalEvents();
+		drainInbox();
+	}
+}
+
+bool Simulator::step(){
+	drainInbox();
+	if(terminated || futureEventList.isEmpty()){
+		return false;
+	}
+	scanFutureEvents(false);
+	scanConditionalEvents();
+	return true;
+}
+
+void Simulator::drainInbox(){
+	if(inbox.empty()){
+		return;
+	}
+	inbox.drain([this](EventNotice * pEvent){
+		//投递时不知道仿真时间，迟到的事件按照当前仿真时间执行
+		if(pEvent->getTime() < clock){
+			pEvent->setTime(clock);
+		}
+		scheduleEvent(pEvent);
+	});
+}
+
+double Simulator::getNextEventTime(){
+	if(terminated || futureEventList.isEmpty()){
+		return DBL_MAX;
+	}
+	return futureEventList.getImminentEventTime();
+}
+
+EventNotice * Simulator::executeNextEvent(){
+	if(terminated || futureEventList.isEmpty()){
+		return NULL;
+	}
+	EventNotice * pEvent = futureEventList.popImminentEvent();
+	dispatchEvent(pEvent);
+	return pEvent;
+}
+
+void Simulator::rollbackClock(double time){
+	if(time < clock){
+		clock = time;
+	}
+}
+
+void Simulator::saveCheckpoint(CheckpointWriter & writer){
+	writer.put(clock);
+	writer.put(eventCount);
+	uint32_t count = 0;
+	for(EventList::iterator it = futureEventList.begin();it != futureEventList.end();it ++){
+		count += dynamic_cast<EndEvent *>(*it) == NULL ? 1 : 0;
+	}
+	writer.put(count);
+	for(EventList::iterator it = futureEventList.begin();it != futureEventList.end();it ++){
+		if(dynamic_cast<EndEvent *>(*it) == NULL){
+			writer.putEventRecord(*it);
+		}
+	}
+	writer.put((uint32_t)conditionalEventList.size());
+	for(EventList::iterator it = conditionalEventList.begin();it != conditionalEventList.end();it ++){
+		writer.putEventRecord(*it);
+	}
+}
+
+void Simulator::restoreCheckpoint(CheckpointReader & reader){
+	futureEventList.removeAll();
+	conditionalEventList.removeAll();
+	terminated = false;
+	reader.get(clock);
+	reader.get(eventCount);
+	//按照保存顺序插入，时间相同的事件保持原有的先后顺序
+	uint32_t count;
+	reader.get(count);
+	for(uint32_t i = 0;i < count;i ++){
+		futureEventList.insertEvent(reader.getEventRecord());
+	}
+	reader.get(count);
+	for(uint32_t i = 0;i < count;i ++){
+		conditionalEventList.insertEvent(reader.getEventRecord());
+	}
+}
+
+#ifndef _WIN32
+//向管道写入全部数据，被信号中断时继续写入
+static bool writeAll(int fd,const char * data,size_t size){
+	while(size > 0){
+		ssize_t count = write(fd,data,size);
+		if(count < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			return false;
+		}
+		data += count;
+		size -= (size_t)count;
+	}
+	return true;
+}
+#endif
+
+std::vector<BranchResult> Simulator::branch(int k,BranchReseed reseed,const std::vector<DataCollection *> & statistics,
+		double duration,unsigned processes){
+	std::vector<BranchResult> results(k > 0 ? k : 0,BranchResult{false,clock,eventCount,std::vector<double>()});
+#ifndef _WIN32
+	processes = processes == 0 ? ThreadPool::hardwareThreads() : processes;
+	//避免分支进程重复输出父进程缓冲区中的内容
+	flush();
+	fflush(NULL);
+	std::vector<pid_t> children(results.size(),-1);
+	std::vector<int> pipes(results.size(),-1);
+	//各分支返回的结果，全部分支进程创建之后才合并统计，以免以后的分支从合并后的统计开始运行
+	std::vector<std::string> records(results.size());
+	std::string bytes;
+	int next = 0;
+	for(int i = 0;i < k;i ++){
+		//按照分支序号依次收集结果，同时运行的分支进程不超过上限
+		while(next < k && next < i + (int)processes){
+			int fds[2];
+			pid_t pid = -1;
+			if(pipe(fds) != 0){
+				printf("错误：创建仿真分支%d的管道失败：%s\n",next,strerror(errno));
+			}else if((pid = fork()) < 0){
+				printf("错误：创建仿真分支%d的进程失败：%s\n",next,strerror(errno));
+				::close(fds[0]);
+				::close(fds[1]);
+			}
+			//终止已经创建但尚未收集结果的分支进程，全部分支按照失败返回，统计对象保持不变
+			if(pid < 0){
+				for(int q = i;q < next;q ++){
+					::close(pipes[q]);
+					kill(children[q],SIGKILL);
+					waitpid(children[q],NULL,0);
+				}
+				for(size_t q = 0;q < results.size();q ++){
+					results[q].succeeded = false;
+				}
+				return results;
+			}
+			if(pid == 0){
+				::close(fds[0]);
+				//分支进程中只有调用线程，异步打印线程和同时事件线程池不存在，放弃这些对象（不能等待其线程结束），
+				//改为同步打印，同时事件串行执行
+				writer = NULL;
+				simultaneousPool = NULL;
+				//父进程已经运行结束或调用了stop时，分支仍从分支时刻继续运行
+				terminated = false;
+				if(reseed){
+					reseed(next);
+				}
+				run(duration);
+				CheckpointWriter writer;
+				writer.put(clock);
+				writer.put(eventCount);
+				for(size_t s = 0;s < statistics.size();s ++){
+					writer.put(statistics[s]->mean());
+					bytes.clear();
+					statistics[s]->saveState(bytes);
+					writer.putString(bytes);
+				}
+				bool written = writeAll(fds[1],writer.getBytes().data(),writer.getBytes().size());
+				//不执行父进程复制来的退出处理和静态对象析构
+				fflush(NULL);
+				_exit(written ? 0 : 1);
+			}
+			::close(fds[1]);
+			children[next] = pid;
+			pipes[next] = fds[0];
+			next ++;
+		}
+		std::string & record = records[i];
+		char buffer[65536];
+		ssize_t count;
+		while((count = read(pipes[i],buffer,sizeof(buffer))) != 0){
+			if(count < 0){
+				if(errno == EINTR){
+					continue;
+				}
+				break;
+			}
+			record.append(buffer,(size_t)count);
+		}
+		::close(pipes[i]);
+		int status = 0;
+		while(waitpid(children[i],&status,0) < 0 && errno == EINTR){
+		}
+		if(WIFSIGNALED(status)){
+			printf("错误：仿真分支%d（pid %d）被信号%d终止\n",i,(int)children[i],WTERMSIG(status));
+			continue;
+		}
+		if(!WIFEXITED(status) || WEXITSTATUS(status) != 0){
+			printf("错误：仿真分支%d（pid %d）的退出码为%d\n",i,(int)children[i],WEXITSTATUS(status));
+			continue;
+		}
+		//分支进程中的模型调用exit退出时退出码为0，但没有返回结果
+		if(record.empty()){
+			printf("错误：仿真分支%d没有返回结果\n",i);
+			continue;
+		}
+		results[i].succeeded = true;
+	}
+	int merged = 0;
+	for(int i = 0;i < k;i ++){
+		if(!results[i].succeeded){
+			continue;
+		}
+		BranchResult & result = results[i];
+		CheckpointReader reader(records[i].data(),records[i].size());
+		reader.get(result.clock);
+		reader.get(result.events);
+		for(size_t s = 0;s < statistics.size();s ++){
+			double mean;
+			reader.get(mean);
+			result.means.push_back(mean);
+			reader.getString(bytes);
+			const char * cursor = bytes.data();
+			//第一个成功的分支替换原有统计，以后的分支合并
+			if(merged == 0){
+				statistics[s]->restoreState(cursor);
+			}else{
+				statistics[s]->mergeState(cursor);
+			}
+		}
+		merged ++;
+	}
+#else
+	printf("错误：仿真分支只支持POSIX系统\n");
+	exit(0);
+#endif
+	return results;
 }
 
 void Simulator::scanConditionalEvents(){
+	if(conditionalEventList.empty()){
+		return;
+	}
+	NOTIFY_MONITORS(conditionalScanStarted(this));
 	bool bRoutineExecuted = true;
 	//如果执行了条件事件，则需要重新扫描条件事件表
 	while(bRoutineExecuted){
@@ -189,8 +713,10 @@ void Simulator::scanConditionalEvents(){
 				it != conditionalEventList.end();
 				it++){
 			EventNotice* pEvent = (*it);
+			bool bCanTrigger = conditionFunction != NULL ? conditionFunction(pEvent,this) : pEvent->canTrigger(this);
+			NOTIFY_MONITORS(conditionEvaluated(this,pEvent,bCanTrigger));
 			//如果满足事件执行条件，则结束扫描，执行条件事件
-			if(pEvent->canTrigger(this)){
+			if(bCanTrigger){
 				bRoutineExecuted = true;
 				break;
 			}
@@ -200,11 +726,9 @@ void Simulator::scanConditionalEvents(){
 			EventNotice* pEvent = (*it);
 			//删除执行的条件事件
 			conditionalEventList.remove(pEvent);
-			if(debug){
-				print("仿真时间=%f 发生条件事件{%s}\n",clock,pEvent->getName());
-			}
 			//执行条件事件，如果必要，调度新的未来事件
-			pEvent->trigger(this);
+			executeEvent(pEvent,true);
+			eventCount ++;
 			//如果不需要保留事件，则删除当前条件事件
 			if(!pEvent->isReserved()){
 				//删除事件
@@ -212,23 +736,88 @@ void Simulator::scanConditionalEvents(){
 			}
 		}
 	}
+	NOTIFY_MONITORS(conditionalScanFinished(this));
 }
 
 //打印输出函数
 void Simulator::print(const char* strFormat,...){
 	char szTemp[4096];
+	std::string longText;
+	const char * text = szTemp;
 
 	va_list ap;
 	va_start(ap, strFormat);
-	vsprintf(szTemp, strFormat, ap);
+	int len = vsnprintf(szTemp, sizeof(szTemp), strFormat, ap);
 	va_end(ap);
+	if(len < 0){
+		return;
+	}
+	//超过缓冲区长度的打印内容重新格式化
+	if(len >= (int)sizeof(szTemp)){
+		longText.resize(len + 1);
+		va_start(ap, strFormat);
+		vsnprintf(&longText[0], len + 1, strFormat, ap);
+		va_end(ap);
+		text = longText.c_str();
+	}
 
+	//并行执行的同时事件的打印内容按照优先级顺序提交
+	if (deferring && currentEffectsOwner == this){
+		currentEffects->output.append(text,len);
+		return;
+	}
+	int sinks = outputSinks;
+	if (printFile == NULL){
+		sinks &= ~OUTPUT_FILE;
+	}
+	//异步打印
+	if (writer != NULL){
+		writer->write(text,len,sinks);
+		return;
+	}
 	//打印到控制台
-	printf(szTemp);
-
+	if (sinks & OUTPUT_CONSOLE){
+		fputs(text,stdout);
+	}
 	//打印到文件
-	if (printFile != NULL){
-		fprintf(printFile,szTemp);
+	if (sinks & OUTPUT_FILE){
+		fputs(text,printFile);
+	}
+}
+
+void Simulator::setAsyncOutput(bool async,size_t bufferSize){
+	if (async && writer == NULL){
+		//同步打印的内容需要先于异步打印内容输出
+		fflush(stdout);
+		if (printFile != NULL){
+			fflush(printFile);
+		}
+		writer = new OutputWriter(stdout,printFile,bufferSize);
+	}else if (!async && writer != NULL){
+		delete writer;
+		writer = NULL;
+	}
+}
+
+void Simulator::setConsoleOutput(bool enable){
+	if (enable){
+		outputSinks |= OUTPUT_CONSOLE;
+	}else{
+		outputSinks &= ~OUTPUT_CONSOLE;
+	}
+}
+
+void Simulator::setFileOutput(bool enable){
+	if (enable){
+		outputSinks |= OUTPUT_FILE;
+	}else{
+		outputSinks &= ~OUTPUT_FILE;
+	}
+}
+
+void Simulator::flush(){
+	if (writer != NULL){
+		writer->flush();
 	}
 }
 
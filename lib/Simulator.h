@@ -12,11 +12,104 @@
 #define SIMULATOR_H_
 
 #include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <functional>
 #include "EventList.h"
+#include "MpscQueue.h"
 #include "ProcessNotice.h"
 #include "Random.h"
+#include "OutputWriter.h"
+#include "Monitor.h"
+#include "Profiler.h"
+#include "PerfCounters.h"
+
+/**
+ * @brief 是否编译事件调度跟踪打印代码，缺省为1
+ * 编译时定义RUBBERDUCK_TRACE=0（CMake选项RUBBERDUCK_TRACE=OFF或make TRACE=0），
+ * 仿真引擎中将不包含任何跟踪打印代码，setDebug()不再产生输出
+ */
+#ifndef RUBBERDUCK_TRACE
+#define RUBBERDUCK_TRACE 1
+#endif
+
+/**
+ * @brief 跟踪打印事件调度过程，仅在调用setDebug()后输出，语法格式同Simulator::print
+ */
+#if RUBBERDUCK_TRACE
+#define SIM_TRACE(pSimulator,...) do{ if((pSimulator)->isDebug()){ (pSimulator)->print(__VA_ARGS__); } }while(0)
+#else
+#define SIM_TRACE(pSimulator,...) do{ }while(0)
+#endif
 
 namespace rubber_duck{
+
+class Simulator;
+class BinaryTrace;
+class ChromeTrace;
+class ThreadPool;
+class CheckpointWriter;
+class CheckpointReader;
+class DataCollection;
+/**
+ * @brief 事件处理分派函数，由EventDispatcher::trigger提供
+ */
+typedef void (*TriggerFunction)(EventNotice * pEvent,Simulator * pSimulator);
+/**
+ * @brief 仿真引擎创建和删除时的通知函数，created为true表示创建，false表示即将删除
+ */
+typedef void (*InstanceHook)(Simulator * pSimulator,bool created);
+/**
+ * @brief 事件条件判断分派函数，由EventDispatcher::canTrigger提供
+ */
+typedef bool (*ConditionFunction)(EventNotice * pEvent,Simulator * pSimulator);
+
+/**
+ * @brief 并行执行的同时事件对仿真引擎的副作用，整批事件执行完成后按照优先级顺序提交
+ */
+struct DeferredEffects{
+	/**
+	 * @brief 副作用类型：调度未来事件、调度条件事件、取消事件
+	 */
+	enum Operation{	SCHEDULE,SCHEDULE_CONDITIONAL,CANCEL	};
+	/**
+	 * @brief 按照发生顺序记录的副作用
+	 */
+	std::vector<std::pair<Operation,EventNotice *> > operations;
+	/**
+	 * @brief 打印输出的内容
+	 */
+	std::string output;
+};
+
+/**
+ * @brief 仿真分支的随机数重置函数，在分支进程中继续运行之前调用，参数为分支序号
+ */
+typedef std::function<void(int index)> BranchReseed;
+
+/**
+ * @brief 仿真分支返回的结果
+ */
+struct BranchResult{
+	/**
+	 * @brief 分支进程是否正常结束并返回了结果
+	 */
+	bool succeeded;
+	/**
+	 * @brief 分支结束时的仿真时钟
+	 */
+	double clock;
+	/**
+	 * @brief 分支结束时已执行的事件数量，包括分支之前执行的事件
+	 */
+	uint64_t events;
+	/**
+	 * @brief 各汇总统计对象在本分支中的均值，顺序与branch的statistics参数相同
+	 */
+	std::vector<double> means;
+};
+
 /**
  * @brief 仿真引擎对象类，负责事件调度、随机变量生成和输出打印等
  */
@@ -42,6 +135,34 @@ private:
 	 * @brief 打印输出文件句柄指针
 	 */
 	FILE* printFile = NULL;
+	/**
+	 * @brief 异步缓冲输出对象指针，NULL表示同步打印
+	 */
+	OutputWriter * writer = NULL;
+	/**
+	 * @brief 打印输出目标，OUTPUT_CONSOLE和OUTPUT_FILE的组合
+	 */
+	int outputSinks = OUTPUT_CONSOLE | OUTPUT_FILE;
+	/**
+	 * @brief 注册的仿真运行监视器
+	 */
+	std::vector<Monitor *> monitors;
+	/**
+	 * @brief 由setBinaryTrace创建的二进制事件跟踪记录对象
+	 */
+	BinaryTrace * binaryTrace = NULL;
+	/**
+	 * @brief 由setChromeTrace创建的Chrome trace-event跟踪对象
+	 */
+	ChromeTrace * chromeTrace = NULL;
+	/**
+	 * @brief 由setProfiler创建的事件执行性能剖析对象
+	 */
+	Profiler * profiler = NULL;
+	/**
+	 * @brief 由setPerfCounters创建的硬件性能计数器对象
+	 */
+	PerfCounters * perfCounters = NULL;
 	/**
 	 * @brief 是否跟踪打印事件调度过程
 	 */
@@ -52,13 +173,75 @@ private:
 	Random * random = NULL;
 
 	double duration = -1;
+	/**
+	 * @brief 本仿真引擎执行的事件数量
+	 */
+	uint64_t eventCount = 0;
+	/**
+	 * @brief 仿真引擎创建和删除时的通知函数
+	 */
+	static InstanceHook instanceHook;
+	/**
+	 * @brief 静态事件处理分派函数，NULL表示按照虚函数分派
+	 */
+	TriggerFunction triggerFunction = NULL;
+	/**
+	 * @brief 静态事件条件判断分派函数，NULL表示按照虚函数分派
+	 */
+	ConditionFunction conditionFunction = NULL;
+	/**
+	 * @brief 拥有本仿真引擎的对象，例如并行仿真的逻辑进程
+	 */
+	void * owner = NULL;
+	/**
+	 * @brief 并行执行同时事件的线程池，NULL表示串行执行
+	 */
+	ThreadPool * simultaneousPool = NULL;
+	/**
+	 * @brief 是否正在并行执行同时事件，此时事件处理函数对仿真引擎的副作用推迟提交
+	 */
+	bool deferring = false;
+	/**
+	 * @brief 并行执行的同时事件按照冲突键排序后的序号，以及各事件的副作用
+	 */
+	std::vector<size_t> simultaneousOrder;
+	std::vector<DeferredEffects> simultaneousEffects;
+	/**
+	 * @brief 其他线程通过post投递的未来事件，由运行仿真的线程在每次事件循环开始时批量取出
+	 */
+	MpscQueue<EventNotice *> inbox;
+	/**
+	 * @brief 将收件箱中的事件按照投递顺序插入FEL
+	 */
+	void drainInbox();
 	/**
 	 * @brief 扫描调度条件事件
 	 */
 	void scanConditionalEvents();
 	void scanFutureEvents(bool CEL);
 	void triggerEvent(EventNotice* pEvent);
+	void dispatchEvent(EventNotice* pEvent);
+	/**
+	 * @brief 执行事件处理函数，包括跟踪打印和监视器通知，串行执行和并行执行同时事件时共用
+	 * @param  pEvent       事件对象指针
+	 * @param  conditional  是否为条件事件
+	 */
+	void executeEvent(EventNotice* pEvent,bool conditional);
+	/**
+	 * @brief 执行同一时刻按照优先级排序的事件，设置了冲突键的连续事件并行执行
+	 * @param  events     同时事件
+	 */
+	void triggerSimultaneousEvents(std::vector<EventNotice*> & events);
+	/**
+	 * @brief 按照冲突键分组并行执行events[begin,end)，再按照优先级顺序提交副作用
+	 */
+	void triggerIndependentEvents(std::vector<EventNotice*> & events,size_t begin,size_t end);
 	bool isEnd();
+	/**
+	 * @brief 运行开始和结束时的处理：通知监视器，调度仿真结束事件，运行结束时输出异步打印内容
+	 */
+	void startRun(double duration);
+	void finishRun();
 public:
 	/**
 	 * @brief 创建Simulator对象
@@ -81,6 +264,28 @@ public:
 	 * @param  pEvent  插入的未来事件指针
 	 */
 	void scheduleEvent(EventNotice * pEvent);
+	/**
+	 * @brief 从其他线程向仿真引擎投递未来事件，线程安全且不加锁。
+	 * 事件在run或runUntil的下一次事件循环开始时插入FEL，此时事件时间小于仿真时间的按照当前仿真时间执行
+	 * @param  pEvent  投递的未来事件指针，所有权转移给仿真引擎
+	 */
+	void post(EventNotice * pEvent){
+		inbox.push(pEvent);
+	}
+	/**
+	 * @brief 获取通过post投递的事件数量
+	 * @return uint64_t 事件数量
+	 */
+	uint64_t getPostedEventCount(){
+		return inbox.getPushed();
+	}
+	/**
+	 * @brief 获取从收件箱批量取出事件的次数，只能由运行仿真的线程调用
+	 * @return uint64_t 批次数量
+	 */
+	uint64_t getPostedBatchCount(){
+		return inbox.getBatches();
+	}
 	/**
 	 * @brief 调度条件事件，将pEvent插入到CEL中
 	 * @param  pEvent   条件事件指针
@@ -102,29 +307,218 @@ public:
 	 */
 	void run(double duration = -1,bool bCEL = false);
 	/**
-	 * @brief 终止仿真运行
+	 * @brief 执行时间小于指定时间的全部未来事件及其引起的条件事件，不调度结束事件，
+	 * 也不通知监视器运行开始和结束，用于并行仿真的逻辑进程按照安全时间分段推进
+	 * @param  time   时间上界（不包括）
+	 */
+	void runUntil(double time);
+	/**
+	 * @brief 执行下一个未来事件及其引起的条件事件，不调度结束事件，也不通知监视器运行开始和结束，
+	 * 用于重要性分裂等需要在每个事件之后检查模型状态的算法
+	 * @return bool 是否执行了事件，已终止或没有未来事件时为false
+	 */
+	bool step();
+	/**
+	 * @brief 获取下一个未来事件的时间
+	 * @return double 下一个未来事件的时间，没有未来事件或已终止时为DBL_MAX
+	 */
+	double getNextEventTime();
+	/**
+	 * @brief 执行下一个未来事件，执行后不删除事件，也不扫描条件事件，
+	 * 用于乐观并行仿真保存已执行的事件，回滚后重新调度
+	 * @return EventNotice* 已执行的事件，由调用者负责删除；没有未来事件或已终止时为NULL
 	 */
-	void stop(){	terminated = true;	};
+	EventNotice * executeNextEvent();
 	/**
-	 * @brief 跟踪打印事件调度过程
+	 * @brief 将仿真时钟回退到指定时间，用于乐观并行仿真的回滚
+	 * @param  time   回退后的仿真时间，大于当前仿真时间时不改变仿真时钟
+	 */
+	void rollbackClock(double time);
+	/**
+	 * @brief 将仿真时钟、已执行的事件数量以及FEL和CEL中的事件写入检查点，由Checkpoint::save调用，
+	 * run调度的结束事件不写入
+	 * @param  writer   检查点写入器
+	 */
+	void saveCheckpoint(CheckpointWriter & writer);
+	/**
+	 * @brief 删除FEL和CEL中的事件，从检查点恢复仿真时钟、已执行的事件数量以及FEL和CEL中的事件，
+	 * 由Checkpoint::restore调用
+	 * @param  reader   检查点读取器
+	 */
+	void restoreCheckpoint(CheckpointReader & reader);
+	/**
+	 * @brief 从当前仿真状态创建k个写时复制的分支进程（仅支持POSIX系统），每个分支进程调用reseed重置随机数后
+	 * 继续运行到结束，通过管道返回统计对象的状态。父进程等待全部分支结束，按照分支序号将统计状态合并到
+	 * statistics中（样本汇总，原有统计被替换），父进程的仿真状态保持在分支时刻。全部分支进程创建之后才合并，
+	 * 每个分支都从分支时刻的统计开始，结果与processes无关。创建管道或进程失败时终止已创建的分支进程，
+	 * 全部分支按照失败返回，statistics保持不变。父进程已经运行结束或调用了stop时，分支仍然继续运行。
+	 * 分支进程中采用同步打印，同时事件串行执行（fork不复制异步打印线程和线程池）。
+	 * 分支之前的样本在每个分支中都会出现，统计对象应在分支之后重置（例如预热结束事件）。
+	 * 应在事件处理函数之外调用，并且没有模型创建的其他线程运行，fork只复制调用线程。
+	 * @param  k            分支数量
+	 * @param  reseed       随机数重置函数，参数为分支序号，为空时各分支相同
+	 * @param  statistics   汇总的统计对象
+	 * @param  duration     分支继续运行的仿真时长，含义同run
+	 * @param  processes    同时运行的分支进程数量上限，为0时等于处理器核数
+	 * @return std::vector<BranchResult> 各分支的结果
+	 */
+	std::vector<BranchResult> branch(int k,BranchReseed reseed,const std::vector<DataCollection *> & statistics,
+			double duration = -1,unsigned processes = 0);
+	/**
+	 * @brief 终止仿真运行，如果采用异步打印，则等待已打印内容全部输出
+	 */
+	void stop();
+	/**
+	 * @brief 跟踪打印事件调度过程，RUBBERDUCK_TRACE为0时无效
 	 */
 	void setDebug(){	debug = true;	};
 	/**
 	 * @brief 判断是否跟踪打印事件调度过程
 	 * @return true 跟踪打印事件调度
-	 * @return false 不跟踪打印事件调度
+	 * @return false 不跟踪打印事件调度，RUBBERDUCK_TRACE为0时总是返回false
+	 */
+	bool isDebug(){	return RUBBERDUCK_TRACE && debug;	};
+	/**
+	 * @brief 注册仿真运行监视器，Simulator不负责删除监视器
+	 * @param  pMonitor   监视器对象指针
+	 */
+	void addMonitor(Monitor * pMonitor);
+	/**
+	 * @brief 注销仿真运行监视器
+	 * @param  pMonitor   监视器对象指针
+	 */
+	void removeMonitor(Monitor * pMonitor);
+	/**
+	 * @brief 获得注册的仿真运行监视器，供CProcess和Resource发送通知
+	 * @return const std::vector<Monitor *>& 监视器列表
+	 */
+	const std::vector<Monitor *> & getMonitors(){	return monitors;	};
+	/**
+	 * @brief 将事件调度过程记录到紧凑二进制跟踪文件，由tools/TraceDecoder解码
+	 * @param  traceFileName   跟踪文件名称，NULL表示结束跟踪记录并关闭跟踪文件
 	 */
-	bool isDebug(){	return debug;	};
+	void setBinaryTrace(const char * traceFileName);
+	/**
+	 * @brief 将仿真引擎的运行活动以Chrome trace-event JSON格式流式写入文件，
+	 * 可以在Perfetto或chrome://tracing中按照墙钟时间查看各仿真阶段的耗时
+	 * @param  traceFileName   跟踪文件名称，NULL表示结束跟踪并关闭跟踪文件
+	 */
+	void setChromeTrace(const char * traceFileName);
+	/**
+	 * @brief 设置是否按照事件类统计事件执行次数、墙钟耗时、条件判断次数和事件表长度
+	 * @param  enable   true表示开始剖析（清除已有统计结果），false表示结束剖析并删除剖析结果
+	 */
+	void setProfiler(bool enable);
+	/**
+	 * @brief 获得事件执行性能剖析对象，用于打印剖析报告或导出JSON
+	 * @return Profiler* 剖析对象指针，未调用setProfiler(true)时为NULL
+	 */
+	Profiler * getProfiler(){	return profiler;	};
+	/**
+	 * @brief 设置是否统计仿真运行和各事件类执行时的硬件性能计数器（仅支持Linux），
+	 * 计数器不可用时不进行统计，getPerfCounters()->report()打印不可用原因
+	 * @param  enable   true表示开始统计，false表示结束统计并删除统计结果
+	 */
+	void setPerfCounters(bool enable);
+	/**
+	 * @brief 获得硬件性能计数器对象，用于打印IPC和缓存缺失等统计报告
+	 * @return PerfCounters* 硬件性能计数器对象指针，未调用setPerfCounters(true)时为NULL
+	 */
+	PerfCounters * getPerfCounters(){	return perfCounters;	};
+	/**
+	 * @brief 获得未来事件表中的事件数量
+	 * @return size_t 事件数量
+	 */
+	size_t getFutureEventCount(){	return futureEventList.size();	};
+	/**
+	 * @brief 获得条件事件表中的事件数量
+	 * @return size_t 事件数量
+	 */
+	size_t getConditionalEventCount(){	return conditionalEventList.size();	};
+	/**
+	 * @brief 设置静态事件分派模板，按照事件类型标识直接调用事件处理函数
+	 * Dispatcher为EventDispatcher模板实例，参见EventDispatch.h
+	 */
+	template<class Dispatcher>
+	void setDispatcher(){
+		triggerFunction = &Dispatcher::trigger;
+		conditionFunction = &Dispatcher::canTrigger;
+	};
+	/**
+	 * @brief 按照静态事件分派模板运行仿真，含义同run(duration,false)。
+	 * 事件循环随Dispatcher实例化，事件处理函数的分派内联到循环中，没有函数指针和虚函数调用；
+	 * 注册了监视器或跟踪打印时按照run执行，条件事件按照setDispatcher设置的分派函数判断
+	 * @param  duration     仿真运行时长，小于等于0表示运行到没有未来事件或调用stop
+	 */
+	template<class Dispatcher>
+	void runDispatched(double duration = -1){
+		setDispatcher<Dispatcher>();
+		if(!monitors.empty() || isDebug()){
+			run(duration);
+			return;
+		}
+		startRun(duration);
+		while(true){
+			drainInbox();
+			if(isEnd()){
+				break;
+			}
+			if(!futureEventList.isEmpty()){
+				EventNotice * pEvent = futureEventList.popImminentEvent();
+				clock = pEvent->getTime();
+				Dispatcher::trigger(pEvent,this);
+				eventCount ++;
+				if(!pEvent->isReserved()){
+					delete pEvent;
+				}
+			}
+			if(!conditionalEventList.empty()){
+				scanConditionalEvents();
+			}
+		}
+		finishRun();
+	};
 	/**
 	 * @brief 获取当前仿真时间
 	 * @return double 当前仿真时间
 	 */
 	double getClock(){	return clock;	};
+	/**
+	 * @brief 获取本仿真引擎已执行的事件数量，包括未来事件和条件事件
+	 * @return uint64_t 事件数量
+	 */
+	uint64_t getEventCount(){	return eventCount;	};
+	/**
+	 * @brief 设置仿真引擎创建和删除时的通知函数，例如由运行统计汇总进程中各仿真引擎的事件数量。
+	 * 只在构造函数和析构函数中调用，应在创建仿真引擎之前设置
+	 * @param  hook     通知函数，NULL表示不通知
+	 */
+	static void setInstanceHook(InstanceHook hook){	instanceHook = hook;	};
 	/**
 	 * @brief 获取缺省的随机变量生成器
 	 * @return Random* 随机变量生成器指针
 	 */
 	Random * getRandom(){	return random;	};
+	/**
+	 * @brief 获取拥有本仿真引擎的对象
+	 * @return void* 拥有者指针
+	 */
+	void * getOwner(){	return owner;	};
+	/**
+	 * @brief 设置拥有本仿真引擎的对象，事件处理函数可以由getOwner找到所属的逻辑进程等对象
+	 * @param  owner  拥有者指针
+	 */
+	void setOwner(void * owner){	this->owner = owner;	};
+	/**
+	 * @brief 设置并行执行同时事件的线程数量，只对run(duration,true)按照优先级执行同时事件有效。
+	 * 同一时刻设置了冲突键（EventNotice::setConflictKey）的连续事件按照冲突键分组，不同组在线程池中
+	 * 并行执行，同一组按照优先级顺序串行执行；未设置冲突键的事件串行执行，也是并行执行的分界。
+	 * 并行执行期间事件处理函数调度、取消事件和打印输出推迟到这批事件执行完成后按照优先级顺序提交，
+	 * 仿真结果与线程数量无关。并行执行的事件不能共享随机数生成器，也不能是进程交互法的进程（调试版本中检查）；
+	 * 注册了监视器时串行执行，以保证监视器按照事件顺序收到通知。
+	 * @param  threads    线程数量，0或1表示串行执行
+	 */
+	void setSimultaneousThreads(unsigned threads);
 	/**
 	 * @brief 同时打印到控制台和文件的函数，语法格式同printf函数
 	 * 如果设置了printFileName，则将输出同时打印到该文本文件
@@ -132,6 +526,28 @@ public:
 	 * @param  ...              打印参数
 	 */
 	void print(const char* strFormat,...);
+	/**
+	 * @brief 设置是否采用异步缓冲打印，由后台输出线程批量写入控制台和文件
+	 * 采用异步打印时，在print之外直接输出到控制台的内容（例如DataCollection::report）
+	 * 之前应调用flush，run结束和stop时会自动调用flush
+	 * @param  async        是否异步打印
+	 * @param  bufferSize   异步打印的缓冲区字节数
+	 */
+	void setAsyncOutput(bool async,size_t bufferSize = 1 << 20);
+	/**
+	 * @brief 设置print是否输出到控制台
+	 * @param  enable   是否输出到控制台
+	 */
+	void setConsoleOutput(bool enable);
+	/**
+	 * @brief 设置print是否输出到打印输出文件
+	 * @param  enable   是否输出到打印输出文件
+	 */
+	void setFileOutput(bool enable);
+	/**
+	 * @brief 等待异步打印的内容全部输出到控制台和文件
+	 */
+	void flush();
 	/**
 	 * @brief 激活无条件延迟进程参与仿真调度
 	 * @param  pProcess         激活的进程
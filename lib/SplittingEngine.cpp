@@ -0,0 +1,164 @@
+/**
+ * @file SplittingEngine.cpp
+ * @brief 重要性分裂引擎SplittingEngine的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include "SplittingEngine.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+SplittingEngine::SplittingEngine(Simulator * pSimulator,Checkpoint * pCheckpoint,ImportanceFunction importance,
+		double rareLevel,unsigned long seed):pSimulator(pSimulator),pCheckpoint(pCheckpoint),importance(importance),
+		rareLevel(rareLevel),seeds(seed),estimates("SPLITTING ESTIMATE"){
+	initialLevel = 0;
+	trialEstimate = 0;
+	events = hits = retrials = killed = 0;
+	wallTime = 0;
+}
+
+void SplittingEngine::addThreshold(double threshold,int split){
+	if(threshold >= rareLevel || (!thresholds.empty() && threshold <= thresholds.back())){
+		printf("错误：阈值（%f）必须大于已添加的阈值并且小于稀有水平（%f）\n",threshold,rareLevel);
+		exit(0);
+	}
+	if(split < 1){
+		printf("错误：阈值（%f）的分裂数量（%d）必须不小于1\n",threshold,split);
+		exit(0);
+	}
+	thresholds.push_back(threshold);
+	splits.push_back(split);
+}
+
+int SplittingEngine::levelOf(double value){
+	int level = 0;
+	while(level < (int)thresholds.size() && value >= thresholds[level]){
+		level ++;
+	}
+	return level;
+}
+
+void SplittingEngine::simulate(int level,int birth){
+	while(pSimulator->step()){
+		events ++;
+		double value = importance(pSimulator);
+		if(value >= rareLevel){
+			hits ++;
+			trialEstimate += weights.back();
+			return;
+		}
+		int current = levelOf(value);
+		//重试轨迹降到出生阈值以下时结束，由留在低重要性区域的轨迹继续仿真
+		if(current < birth){
+			killed ++;
+			return;
+		}
+		if(current > level){
+			string state;
+			pCheckpoint->save(pSimulator,state);
+			split(state,level,current,birth,true);
+			return;
+		}
+		//向下越过阈值后再次向上越过时重新分裂
+		level = current;
+	}
+}
+
+void SplittingEngine::split(const string & state,int from,int to,int birth,bool original){
+	if(from == to){
+		//原轨迹首先从保存时的状态直接继续，重试轨迹恢复状态并重置随机数
+		if(!original){
+			pCheckpoint->restore(pSimulator,state.data(),state.size());
+			pCheckpoint->reseed(pSimulator,seeds());
+		}
+		simulate(to,birth);
+		return;
+	}
+	crossings[from] ++;
+	crossingWeights[from] += weights[from];
+	//一次越过多个阈值时逐个阈值分裂，第一条复制轨迹继承原轨迹的出生阈值
+	int count = from < initialLevel ? 1 : splits[from];
+	retrials += count - 1;
+	for(int i = 0;i < count;i ++){
+		split(state,from + 1,to,i == 0 ? birth : from + 1,original && i == 0);
+	}
+}
+
+void SplittingEngine::run(int trials){
+	crossings.assign(thresholds.size(),0);
+	crossingWeights.assign(thresholds.size(),0);
+	estimates.reset(0);
+	events = hits = retrials = killed = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	string root;
+	pCheckpoint->save(pSimulator,root);
+	weights.assign(thresholds.size() + 1,1.0);
+	for(int n = 0;n < trials;n ++){
+		pCheckpoint->restore(pSimulator,root.data(),root.size());
+		pCheckpoint->reseed(pSimulator,seeds());
+		if(initialization){
+			initialization(pSimulator);
+		}
+		//初始状态已经越过的阈值不分裂，区域的权重为初始区域以上各阈值分裂数量乘积的倒数
+		if(n == 0){
+			initialLevel = levelOf(importance(pSimulator));
+			for(int level = initialLevel + 1;level <= (int)thresholds.size();level ++){
+				weights[level] = weights[level - 1] / splits[level - 1];
+			}
+		}
+		trialEstimate = 0;
+		simulate(initialLevel,0);
+		estimates.update(trialEstimate,n);
+	}
+	pCheckpoint->restore(pSimulator,root.data(),root.size());
+	wallTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void SplittingEngine::report(){
+	string t(84,'-');
+	cout << "稀有水平：" << rareLevel << "，阈值数量：" << thresholds.size() << "，主试验次数：" << estimates.getObs() << endl;
+	cout << t.c_str() << endl;
+	cout << setiosflags(ios::left)
+		<< setw(8) << "LEVEL"
+		<< setw(14) << "THRESHOLD"
+		<< setw(10) << "SPLIT"
+		<< setw(16) << "CROSSINGS"
+		<< setw(18) << "UPCROSS/TRIAL"
+		<< setw(18) << "RATIO"
+		<< resetiosflags(ios::left) << endl;
+	cout << t.c_str() << endl;
+	double trials = estimates.getObs() > 0 ? estimates.getObs() : 1;
+	double previous = 1;
+	for(size_t i = 0;i < thresholds.size();i ++){
+		//每次主试验向上越过阈值的期望次数，与上一阈值之比用于选择分裂数量
+		double reach = crossingWeights[i] / trials;
+		cout << setiosflags(ios::left)
+			<< setw(8) << i + 1
+			<< setw(14) << thresholds[i]
+			<< setw(10) << splits[i]
+			<< setw(16) << crossings[i]
+			<< setw(18) << reach
+			<< setw(18) << (previous > 0 ? reach / previous : 0)
+			<< resetiosflags(ios::left) << endl;
+		previous = reach;
+	}
+	cout << t.c_str() << endl;
+	double estimate = getEstimate();
+	cout << "概率估计：" << estimate << "，95%置信区间半长：" << getConfidence()
+		<< "，相对误差：" << (estimate > 0 ? getConfidence() / estimate : 0) << endl;
+	cout << "到达稀有水平的轨迹数量：" << hits << "，重试轨迹数量：" << retrials << "，提前结束的重试轨迹数量：" << killed
+		<< "，事件数量：" << events << "，墙钟时间：" << wallTime << "秒" << endl;
+}
+
+}
@@ -0,0 +1,211 @@
+/**
+ * @file SplittingEngine.h
+ * @brief 稀有事件仿真的重要性分裂引擎SplittingEngine，采用RESTART方法
+ * 用户提供模型状态的重要性函数、递增的阈值及各阈值的分裂数量，稀有事件为重要性函数达到稀有水平。
+ * 每次主试验从初始状态开始，仿真引擎每执行一个事件后计算重要性函数，轨迹向上越过阈值k时
+ * 通过Checkpoint在内存中保存仿真状态，复制为R_k条轨迹：原轨迹保持原有的出生阈值和随机数，其余R_k-1条重试轨迹的
+ * 出生阈值为k，重要性函数降到出生阈值以下时结束，从而不在低重要性区域重复仿真。
+ * 向下越过阈值后继续仿真的轨迹再次向上越过阈值时重新分裂。轨迹的权重由所在区域确定，
+ * 为其下各阈值分裂数量乘积的倒数，主试验的估计值为到达稀有水平的轨迹权重之和，
+ * 概率估计为各主试验估计值的均值，主试验之间独立，由主试验估计值的样本方差得到置信区间。
+ * 估计的是主试验结束（仿真引擎终止或没有未来事件）之前重要性函数达到稀有水平的概率，
+ * 例如排队系统在忙期内队长达到上限的概率。复制的轨迹由Checkpoint::reseed使用不同的随机数，
+ * 因此模型使用的随机变量生成器和全部状态都必须注册到检查点。FEL中已调度事件的时间属于仿真状态，
+ * 复制的轨迹在各自执行新的随机抽样之后才开始不同；主试验的初始事件应在初始化函数中调度，
+ * 使每次主试验使用不同的随机数。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef SPLITTING_ENGINE_H_
+#define SPLITTING_ENGINE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <random>
+#include <functional>
+#include "DataCollection.h"
+#include "Checkpoint.h"
+#include "Simulator.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 重要性分裂引擎
+ */
+class SplittingEngine{
+public:
+	/**
+	 * @brief 重要性函数，根据仿真引擎和模型的当前状态计算重要性
+	 */
+	typedef std::function<double(Simulator * pSimulator)> ImportanceFunction;
+	/**
+	 * @brief 主试验初始化函数，在每次主试验恢复初始状态并重置随机数之后调用，用于调度初始事件
+	 */
+	typedef std::function<void(Simulator * pSimulator)> InitializationFunction;
+private:
+	/**
+	 * @brief 仿真引擎和保存仿真状态的检查点
+	 */
+	Simulator * pSimulator;
+	Checkpoint * pCheckpoint;
+	/**
+	 * @brief 重要性函数
+	 */
+	ImportanceFunction importance;
+	/**
+	 * @brief 主试验初始化函数
+	 */
+	InitializationFunction initialization;
+	/**
+	 * @brief 稀有水平
+	 */
+	double rareLevel;
+	/**
+	 * @brief 递增的阈值和各阈值的分裂数量
+	 */
+	std::vector<double> thresholds;
+	std::vector<int> splits;
+	/**
+	 * @brief 主试验初始状态所在的区域和各区域的轨迹权重
+	 */
+	int initialLevel;
+	std::vector<double> weights;
+	/**
+	 * @brief 各阈值被向上越过的次数和越过时的轨迹权重之和
+	 */
+	std::vector<uint64_t> crossings;
+	std::vector<double> crossingWeights;
+	/**
+	 * @brief 产生复制轨迹随机数种子的生成引擎
+	 */
+	std::mt19937_64 seeds;
+	/**
+	 * @brief 各主试验的估计值
+	 */
+	Tally estimates;
+	/**
+	 * @brief 当前主试验的估计值
+	 */
+	double trialEstimate;
+	/**
+	 * @brief 执行的事件数量、到达稀有水平的轨迹数量、重试轨迹数量和提前结束的重试轨迹数量
+	 */
+	uint64_t events, hits, retrials, killed;
+	/**
+	 * @brief 最近一次运行的墙钟时间（秒）
+	 */
+	double wallTime;
+	/**
+	 * @brief 获取重要性对应的区域，即不大于重要性的阈值数量
+	 * @param  value    重要性
+	 * @return int 区域序号
+	 */
+	int levelOf(double value);
+	/**
+	 * @brief 从仿真引擎的当前状态推进一条轨迹，直到结束、降到出生阈值以下、到达稀有水平或向上越过阈值
+	 * @param  level    轨迹当前所在的区域
+	 * @param  birth    出生阈值对应的区域，主试验为0
+	 */
+	void simulate(int level,int birth);
+	/**
+	 * @brief 在阈值from到to-1处依次分裂，原轨迹直接推进，重试轨迹从state恢复并重置随机数后推进
+	 * @param  state    越过阈值时保存的仿真状态
+	 * @param  from     第一个越过的阈值
+	 * @param  to       越过阈值后所在的区域
+	 * @param  birth    原轨迹的出生区域
+	 * @param  original 是否为原轨迹，仿真引擎的状态仍为state
+	 */
+	void split(const std::string & state,int from,int to,int birth,bool original);
+public:
+	/**
+	 * @brief 创建重要性分裂引擎
+	 * @param  pSimulator   仿真引擎，运行时的模型状态为每次主试验的初始状态
+	 * @param  pCheckpoint  注册了模型事件类型、随机变量生成器和模型状态的检查点
+	 * @param  importance   重要性函数
+	 * @param  rareLevel    稀有水平
+	 * @param  seed         复制轨迹随机数种子的种子
+	 */
+	SplittingEngine(Simulator * pSimulator,Checkpoint * pCheckpoint,ImportanceFunction importance,double rareLevel,
+			unsigned long seed);
+	/**
+	 * @brief 添加阈值，阈值必须递增并且小于稀有水平
+	 * @param  threshold    阈值
+	 * @param  split        越过阈值时的分裂数量，为1时不分裂
+	 */
+	void addThreshold(double threshold,int split);
+	/**
+	 * @brief 设置主试验初始化函数
+	 * @param  initialization   初始化函数
+	 */
+	void setInitialization(InitializationFunction initialization){
+		this->initialization = initialization;
+	}
+	/**
+	 * @brief 运行指定次数的主试验，结束后仿真引擎恢复到初始状态
+	 * @param  trials   主试验次数
+	 */
+	void run(int trials);
+	/**
+	 * @brief 获取稀有事件概率的估计值
+	 * @return double 概率估计值
+	 */
+	double getEstimate(){
+		return estimates.mean();
+	}
+	/**
+	 * @brief 获取主试验估计值的方差
+	 * @return double 方差
+	 */
+	double getVariance(){
+		return estimates.variance();
+	}
+	/**
+	 * @brief 获取概率估计值的置信区间半长
+	 * @param  level    置信水平
+	 * @return double 置信区间半长
+	 */
+	double getConfidence(double level = 0.95){
+		return estimates.confidence(level);
+	}
+	/**
+	 * @brief 获取主试验次数
+	 * @return int 主试验次数
+	 */
+	int getTrialCount(){
+		return estimates.getObs();
+	}
+	/**
+	 * @brief 获取全部轨迹执行的事件数量
+	 * @return uint64_t 事件数量
+	 */
+	uint64_t getEventCount(){
+		return events;
+	}
+	/**
+	 * @brief 获取到达稀有水平的轨迹数量
+	 * @return uint64_t 轨迹数量
+	 */
+	uint64_t getHitCount(){
+		return hits;
+	}
+	/**
+	 * @brief 获取最近一次运行的墙钟时间
+	 * @return double 墙钟时间（秒）
+	 */
+	double getWallTime(){
+		return wallTime;
+	}
+	/**
+	 * @brief 打印各阈值的向上越过次数和每次主试验的期望越过次数，以及稀有事件概率估计
+	 */
+	void report();
+};
+
+}
+
+#endif /* SPLITTING_ENGINE_H_ */
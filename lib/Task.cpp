@@ -12,9 +12,9 @@
 
 namespace rubber_duck {
 
-_Task main_task;
-_Task *current_task = nullptr;
-JMP_BUF tmp_jmpb;
+thread_local _Task main_task;
+thread_local _Task *current_task = nullptr;
+thread_local JMP_BUF tmp_jmpb;
 
 unsigned dist(_Task *from, _Task *to)
 {
@@ -103,7 +103,8 @@ void task_init(unsigned total_stack, unsigned main_stack)
 
 _Task *task_create(_Task_fn fnp, void *arg, unsigned stack_size)
 {
-    _Task *p;
+    /* volatile: p is live across SETJMP/LONGJMP */
+    _Task * volatile p;
 
     for (p = main_task.next; p != nullptr; p = p->next) {  // find free block
         if (!p->used && p->size >= stack_size) {
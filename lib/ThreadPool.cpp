@@ -0,0 +1,184 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief 工作窃取线程池类ThreadPool的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include "ThreadPool.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+//当前线程所属的线程池和线程序号，用于在工作线程中提交任务时放入本线程的队列
+static thread_local ThreadPool * CurrentPool = NULL;
+static thread_local unsigned CurrentIndex = 0;
+
+//工作线程启动参数
+struct WorkerStart{
+	ThreadPool * pool;
+	unsigned index;
+};
+
+ThreadPool::ThreadPool(unsigned threadCount,size_t stackSize):queued(0){
+	unfinished = 0;
+	nextQueue = 0;
+	stopping = false;
+	if(threadCount == 0){
+		threadCount = hardwareThreads();
+	}
+	for(unsigned i = 0;i < threadCount;i ++){
+		queues.push_back(new WorkQueue());
+	}
+#ifndef _WIN32
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr,stackSize);
+#endif
+	for(unsigned i = 0;i < threadCount;i ++){
+		WorkerStart * start = new WorkerStart{this,i};
+#ifdef _WIN32
+		HANDLE thread = CreateThread(NULL,stackSize,workerEntry,start,STACK_SIZE_PARAM_IS_A_RESERVATION,NULL);
+		if(thread == NULL){
+			printf("错误：创建工作线程失败\n");
+			exit(0);
+		}
+#else
+		pthread_t thread;
+		if(pthread_create(&thread,&attr,workerEntry,start) != 0){
+			printf("错误：创建工作线程失败\n");
+			exit(0);
+		}
+#endif
+		threads.push_back(thread);
+	}
+#ifndef _WIN32
+	pthread_attr_destroy(&attr);
+#endif
+}
+
+ThreadPool::~ThreadPool(){
+	wait();
+	{
+		lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+	for(size_t i = 0;i < threads.size();i ++){
+#ifdef _WIN32
+		WaitForSingleObject(threads[i],INFINITE);
+		CloseHandle(threads[i]);
+#else
+		pthread_join(threads[i],NULL);
+#endif
+	}
+	for(size_t i = 0;i < queues.size();i ++){
+		delete queues[i];
+	}
+}
+
+#ifdef _WIN32
+DWORD WINAPI ThreadPool::workerEntry(LPVOID arg){
+#else
+void * ThreadPool::workerEntry(void * arg){
+#endif
+	WorkerStart * start = (WorkerStart *)arg;
+	ThreadPool * pool = start->pool;
+	unsigned index = start->index;
+	delete start;
+	CurrentPool = pool;
+	CurrentIndex = index;
+	pool->workerLoop(index);
+#ifdef _WIN32
+	return 0;
+#else
+	return NULL;
+#endif
+}
+
+void ThreadPool::workerLoop(unsigned index){
+	function<void()> task;
+	while(true){
+		if(takeTask(index,task)){
+			task();
+			task = nullptr;
+			lock_guard<std::mutex> lock(mutex);
+			if(-- unfinished == 0){
+				allDone.notify_all();
+			}
+			continue;
+		}
+		unique_lock<std::mutex> lock(mutex);
+		workAvailable.wait(lock,[this]{ return stopping || queued.load() > 0; });
+		if(stopping && queued.load() <= 0){
+			return;
+		}
+	}
+}
+
+bool ThreadPool::takeTask(unsigned index,function<void()> & task){
+	//先从自己队列的队尾取出最近提交的任务
+	{
+		WorkQueue * own = queues[index];
+		lock_guard<std::mutex> lock(own->mutex);
+		if(!own->tasks.empty()){
+			task = move(own->tasks.back());
+			own->tasks.pop_back();
+			queued --;
+			return true;
+		}
+	}
+	//再从其他队列的队首窃取最早提交的任务
+	for(size_t k = 1;k < queues.size();k ++){
+		WorkQueue * victim = queues[(index + k) % queues.size()];
+		lock_guard<std::mutex> lock(victim->mutex);
+		if(!victim->tasks.empty()){
+			task = move(victim->tasks.front());
+			victim->tasks.pop_front();
+			queued --;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::submit(function<void()> task){
+	unsigned index;
+	{
+		//先计数再放入队列，保证任务执行完成时unfinished已经包含该任务
+		lock_guard<std::mutex> lock(mutex);
+		unfinished ++;
+		queued ++;
+		if(CurrentPool == this){
+			index = CurrentIndex;
+		}else{
+			index = nextQueue;
+			nextQueue = (nextQueue + 1) % queues.size();
+		}
+	}
+	{
+		WorkQueue * queue = queues[index];
+		lock_guard<std::mutex> lock(queue->mutex);
+		queue->tasks.push_back(move(task));
+	}
+	workAvailable.notify_one();
+}
+
+void ThreadPool::wait(){
+	unique_lock<std::mutex> lock(mutex);
+	allDone.wait(lock,[this]{ return unfinished == 0; });
+}
+
+unsigned ThreadPool::hardwareThreads(){
+	unsigned n = thread::hardware_concurrency();
+	return n == 0 ? 1 : n;
+}
+
+}
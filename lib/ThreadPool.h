@@ -0,0 +1,147 @@
+/**
+ * @file ThreadPool.h
+ * @brief 工作窃取线程池类ThreadPool
+ * 每个工作线程有自己的任务队列，从队尾取出自己的任务，队列为空时从其他线程队列的队首窃取任务，
+ * 减少多个线程争用同一个任务队列。Linux下协作例程的堆栈从线程堆栈中分配，
+ * 因此工作线程的堆栈大小可以指定，需要大于CProcess::init的总堆栈大小。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <stddef.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+namespace rubber_duck{
+
+/**
+ * @brief 工作线程缺省堆栈大小，64MB
+ */
+#define THREAD_POOL_STACK_SIZE (64 * 1024 * 1024)
+
+/**
+ * @brief 工作窃取线程池类
+ */
+class ThreadPool{
+private:
+	/**
+	 * @brief 工作线程的任务队列
+	 */
+	struct WorkQueue{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+	/**
+	 * @brief 工作线程的任务队列列表
+	 */
+	std::vector<WorkQueue *> queues;
+	/**
+	 * @brief 工作线程句柄
+	 */
+#ifdef _WIN32
+	std::vector<HANDLE> threads;
+#else
+	std::vector<pthread_t> threads;
+#endif
+	/**
+	 * @brief 已提交但尚未开始执行的任务数量
+	 */
+	std::atomic<long> queued;
+	/**
+	 * @brief 已提交但尚未执行完成的任务数量
+	 */
+	long unfinished;
+	/**
+	 * @brief 下一个提交任务的队列序号
+	 */
+	unsigned nextQueue;
+	/**
+	 * @brief 是否停止工作线程
+	 */
+	bool stopping;
+	/**
+	 * @brief 保护unfinished、stopping和线程等待条件的互斥锁
+	 */
+	std::mutex mutex;
+	/**
+	 * @brief 有新任务的通知条件
+	 */
+	std::condition_variable workAvailable;
+	/**
+	 * @brief 全部任务完成的通知条件
+	 */
+	std::condition_variable allDone;
+
+	/**
+	 * @brief 工作线程入口函数
+	 * @param  arg      ThreadPool对象和线程序号
+	 */
+#ifdef _WIN32
+	static DWORD WINAPI workerEntry(LPVOID arg);
+#else
+	static void * workerEntry(void * arg);
+#endif
+	/**
+	 * @brief 工作线程主循环
+	 * @param  index    线程序号
+	 */
+	void workerLoop(unsigned index);
+	/**
+	 * @brief 从自己的队列队尾或其他队列队首取出一个任务
+	 * @param  index    线程序号
+	 * @param  task     取出的任务
+	 * @return bool 是否取得任务
+	 */
+	bool takeTask(unsigned index,std::function<void()> & task);
+public:
+	/**
+	 * @brief 创建线程池
+	 * @param  threadCount  工作线程数量，为0时等于处理器核数
+	 * @param  stackSize    工作线程的堆栈大小（字节）
+	 */
+	ThreadPool(unsigned threadCount = 0,size_t stackSize = THREAD_POOL_STACK_SIZE);
+	/**
+	 * @brief 等待全部任务完成后停止工作线程
+	 */
+	~ThreadPool();
+	/**
+	 * @brief 提交任务，在工作线程中调用时放入本线程的队列，否则轮流放入各线程的队列
+	 * @param  task     任务函数对象
+	 */
+	void submit(std::function<void()> task);
+	/**
+	 * @brief 等待已提交的全部任务执行完成，不能在工作线程中调用
+	 */
+	void wait();
+	/**
+	 * @brief 获取工作线程数量
+	 * @return unsigned 工作线程数量
+	 */
+	unsigned getThreadCount(){
+		return (unsigned)queues.size();
+	}
+	/**
+	 * @brief 获取处理器核数
+	 * @return unsigned 处理器核数，无法确定时为1
+	 */
+	static unsigned hardwareThreads();
+};
+
+}
+
+#endif /* THREAD_POOL_H_ */
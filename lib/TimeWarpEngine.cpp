@@ -0,0 +1,104 @@
+/**
+ * @file TimeWarpEngine.cpp
+ * @brief 乐观同步（Time Warp）并行仿真引擎TimeWarpEngine的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <float.h>
+#include <thread>
+#include <iostream>
+#include "TimeWarpEngine.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+TimeWarpEngine::TimeWarpEngine(unsigned batchSize,unsigned gvtInterval)
+		:batchSize(batchSize > 0 ? batchSize : 1),gvtInterval(gvtInterval > 0 ? gvtInterval : 1){
+	window = DBL_MAX;
+	gvt = 0;
+	gvtRounds = 0;
+}
+
+bool TimeWarpEngine::advance(LogicalProcess * lp){
+	OptimisticProcess * process = (OptimisticProcess *)lp;
+	bool progress = process->receive();
+	double limit = window < DBL_MAX && gvt + window < endTime ? gvt + window : endTime;
+	for(unsigned i = 0;i < batchSize && process->executeNextEvent(limit);i ++){
+		progress = true;
+	}
+	return progress;
+}
+
+void TimeWarpEngine::runThread(unsigned thread){
+	vector<OptimisticProcess *> assigned;
+	for(size_t i = thread;i < processes.size();i += threadCount){
+		assigned.push_back((OptimisticProcess *)processes[i]);
+	}
+	while(true){
+		for(unsigned round = 0;round < gvtInterval;round ++){
+			bool progress = false;
+			for(size_t i = 0;i < assigned.size();i ++){
+				progress |= advance(assigned[i]);
+			}
+			if(!progress){
+				this_thread::yield();
+			}
+		}
+		//全部线程到达屏障后没有正在发送的消息，未执行事件和收件箱消息的最小时间戳即为GVT
+		barrier();
+		if(thread == 0){
+			double minimum = DBL_MAX;
+			for(size_t i = 0;i < processes.size();i ++){
+				double time = ((OptimisticProcess *)processes[i])->getMinimumTime();
+				minimum = time < minimum ? time : minimum;
+			}
+			gvt = minimum;
+			gvtRounds ++;
+		}
+		barrier();
+		for(size_t i = 0;i < assigned.size();i ++){
+			assigned[i]->fossilCollect(gvt);
+		}
+		if(gvt > endTime){
+			break;
+		}
+	}
+	for(size_t i = 0;i < assigned.size();i ++){
+		assigned[i]->setFinished(true);
+	}
+}
+
+uint64_t TimeWarpEngine::getRollbackCount(){
+	uint64_t count = 0;
+	for(size_t i = 0;i < processes.size();i ++){
+		count += ((OptimisticProcess *)processes[i])->getRollbacks();
+	}
+	return count;
+}
+
+uint64_t TimeWarpEngine::getAntiMessageCount(){
+	uint64_t count = 0;
+	for(size_t i = 0;i < processes.size();i ++){
+		count += ((OptimisticProcess *)processes[i])->getAntiMessages();
+	}
+	return count;
+}
+
+double TimeWarpEngine::getEfficiency(){
+	uint64_t processed = getProcessedEventCount();
+	return processed > 0 ? (double)getEventCount() / processed : 1.0;
+}
+
+void TimeWarpEngine::report(){
+	ParallelEngine::report();
+	cout << "执行事件数量：" << getProcessedEventCount() << "，回滚撤销事件数量：" << getRolledBackEventCount()
+		<< "，回滚次数：" << getRollbackCount() << "，反消息数量：" << getAntiMessageCount()
+		<< "，GVT计算次数：" << gvtRounds << "，效率：" << getEfficiency() << endl;
+}
+
+}
@@ -0,0 +1,128 @@
+/**
+ * @file TimeWarpEngine.h
+ * @brief 乐观同步（Time Warp）并行仿真引擎TimeWarpEngine
+ * 逻辑进程（OptimisticProcess）不需要前瞻量，每次推进接收消息后投机执行至多batchSize个事件，
+ * 迟到消息引起回滚和反消息。工作线程每推进gvtInterval轮后在屏障处暂停，此时没有正在发送的消息，
+ * 全局虚拟时间（GVT）等于全部逻辑进程未执行事件和收件箱消息时间戳的最小值，
+ * 时间小于GVT的处理记录不会再回滚，提交后删除（化石收集）。GVT大于结束时间时仿真结束。
+ * 可以设置乐观窗口，逻辑进程不执行时间大于GVT加窗口的事件，以限制投机执行的深度。
+ * 效率为提交的事件数量与执行的事件数量之比。
+ * 模型在事件处理函数中修改状态之前调用LogicalProcess::saveState保存状态变量和随机数生成器。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef TIME_WARP_ENGINE_H_
+#define TIME_WARP_ENGINE_H_
+
+#include <stdint.h>
+#include "ParallelEngine.h"
+#include "OptimisticProcess.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 乐观同步并行仿真引擎
+ */
+class TimeWarpEngine:public ParallelEngine{
+private:
+	/**
+	 * @brief 每次推进逻辑进程时最多执行的事件数量
+	 */
+	unsigned batchSize;
+	/**
+	 * @brief 两次计算GVT之间的推进轮数
+	 */
+	unsigned gvtInterval;
+	/**
+	 * @brief 乐观窗口，DBL_MAX表示不限制
+	 */
+	double window;
+	/**
+	 * @brief 全局虚拟时间，只在全部工作线程暂停时修改
+	 */
+	double gvt;
+	/**
+	 * @brief GVT计算次数
+	 */
+	uint64_t gvtRounds;
+protected:
+	/**
+	 * @brief 推进逻辑进程，在屏障处计算GVT并化石收集
+	 * @param  thread   工作线程序号
+	 */
+	virtual void runThread(unsigned thread);
+	/**
+	 * @brief 接收消息并投机执行事件
+	 * @param  lp   逻辑进程
+	 * @return bool 是否有进展
+	 */
+	virtual bool advance(LogicalProcess * lp);
+	/**
+	 * @brief 创建乐观并行仿真的逻辑进程
+	 */
+	virtual LogicalProcess * createLogicalProcess(int id,const char * name,unsigned long seed){
+		return new OptimisticProcess(id,name,seed);
+	}
+public:
+	/**
+	 * @brief 创建引擎
+	 * @param  batchSize    每次推进逻辑进程时最多执行的事件数量
+	 * @param  gvtInterval  两次计算GVT之间的推进轮数
+	 */
+	TimeWarpEngine(unsigned batchSize = 16,unsigned gvtInterval = 16);
+	/**
+	 * @brief 设置乐观窗口
+	 * @param  window   逻辑进程不执行时间大于GVT加窗口的事件，DBL_MAX表示不限制
+	 */
+	void setWindow(double window){
+		this->window = window;
+	}
+	/**
+	 * @brief 获取最近一次计算的全局虚拟时间
+	 * @return double GVT
+	 */
+	double getGVT(){
+		return gvt;
+	}
+	/**
+	 * @brief 获取GVT计算次数
+	 * @return uint64_t 计算次数
+	 */
+	uint64_t getGvtRounds(){
+		return gvtRounds;
+	}
+	/**
+	 * @brief 获取全部逻辑进程的回滚次数
+	 * @return uint64_t 回滚次数
+	 */
+	uint64_t getRollbackCount();
+	/**
+	 * @brief 获取全部逻辑进程发送的反消息数量
+	 * @return uint64_t 反消息数量
+	 */
+	uint64_t getAntiMessageCount();
+	/**
+	 * @brief 获取效率，即提交的事件数量与执行的事件数量之比
+	 * @return double 效率，没有执行事件时为1
+	 */
+	double getEfficiency();
+	/**
+	 * @brief 获取同步协议名称
+	 * @return const char* 协议名称
+	 */
+	virtual const char * getProtocol(){
+		return "TIME WARP";
+	}
+	/**
+	 * @brief 打印各逻辑进程的统计结果，以及回滚、反消息和效率
+	 */
+	virtual void report();
+};
+
+}
+
+#endif /* TIME_WARP_ENGINE_H_ */
@@ -0,0 +1,95 @@
+/**
+ * @file WindowEngine.cpp
+ * @brief 时间窗口同步（YAWNS）并行仿真引擎WindowEngine的实现
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <float.h>
+#include <cmath>
+#include <iostream>
+#include "WindowEngine.h"
+
+using namespace std;
+
+namespace rubber_duck{
+
+WindowEngine::WindowEngine(){
+	lookahead = DBL_MAX;
+	windowEnd = 0;
+	windows = 0;
+}
+
+bool WindowEngine::advance(LogicalProcess * lp){
+	Simulator * pSimulator = lp->getSimulator();
+	uint64_t before = pSimulator->getEventCount();
+	double limit = nextafter(endTime,DBL_MAX);
+	pSimulator->runUntil(windowEnd < limit ? windowEnd : limit);
+	return pSimulator->getEventCount() != before;
+}
+
+void WindowEngine::runThread(unsigned thread){
+	vector<LogicalProcess *> assigned;
+	for(size_t i = thread;i < processes.size();i += threadCount){
+		assigned.push_back(processes[i]);
+	}
+	if(thread == 0){
+		lookahead = DBL_MAX;
+		for(size_t i = 0;i < channels.size();i ++){
+			lookahead = channels[i]->getLookahead() < lookahead ? channels[i]->getLookahead() : lookahead;
+		}
+		minimums.assign(threadCount,DBL_MAX);
+		windows = 0;
+	}
+	barrier();
+	double minimum = DBL_MAX;
+	for(size_t i = 0;i < assigned.size();i ++){
+		double time = assigned[i]->getSimulator()->getNextEventTime();
+		minimum = time < minimum ? time : minimum;
+	}
+	minimums[thread] = minimum;
+	barrier();
+	while(true){
+		//每个线程由相同的各线程最小值得到相同的窗口，下一次写入minimums在下一个屏障之后
+		double start = DBL_MAX;
+		for(unsigned t = 0;t < threadCount;t ++){
+			start = minimums[t] < start ? minimums[t] : start;
+		}
+		if(start > endTime){
+			break;
+		}
+		double end = lookahead < DBL_MAX ? start + lookahead : DBL_MAX;
+		if(thread == 0){
+			windowEnd = end;
+			windows ++;
+		}
+		barrier();
+		for(size_t i = 0;i < assigned.size();i ++){
+			advance(assigned[i]);
+		}
+		//窗口内的事件全部执行后交换消息
+		barrier();
+		minimum = DBL_MAX;
+		for(size_t i = 0;i < assigned.size();i ++){
+			assigned[i]->receive();
+			double time = assigned[i]->getSimulator()->getNextEventTime();
+			minimum = time < minimum ? time : minimum;
+		}
+		minimums[thread] = minimum;
+		barrier();
+	}
+	for(size_t i = 0;i < assigned.size();i ++){
+		assigned[i]->setFinished(true);
+	}
+}
+
+void WindowEngine::report(){
+	ParallelEngine::report();
+	cout << "窗口宽度：" << lookahead << "，窗口数量：" << windows << "，平均每个窗口的事件数量："
+		<< (windows > 0 ? (double)getEventCount() / windows : 0) << endl;
+}
+
+}
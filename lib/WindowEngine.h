@@ -0,0 +1,89 @@
+/**
+ * @file WindowEngine.h
+ * @brief 时间窗口同步（YAWNS）并行仿真引擎WindowEngine
+ * 全部逻辑进程按照时间窗口[T,T+L)同步推进，T为全部逻辑进程下一个事件时间的最小值，
+ * L为全部通道前瞻量的最小值。窗口内发送的消息时间戳不小于T+L，只能在以后的窗口中执行，
+ * 因此各工作线程并行执行本窗口内的事件，不需要空消息。窗口结束后全部线程在屏障处交换消息，
+ * 每个逻辑进程按照时间和发送方序号排序接收的事件，再在屏障处计算下一个窗口。
+ * 窗口边界与线程数量无关，时间相同的事件执行顺序确定，仿真结果与线程数量无关，可以重现。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#ifndef WINDOW_ENGINE_H_
+#define WINDOW_ENGINE_H_
+
+#include <stdint.h>
+#include <vector>
+#include "ParallelEngine.h"
+
+namespace rubber_duck{
+
+/**
+ * @brief 时间窗口同步并行仿真引擎
+ */
+class WindowEngine:public ParallelEngine{
+private:
+	/**
+	 * @brief 窗口宽度，即全部通道前瞻量的最小值，没有通道时为DBL_MAX
+	 */
+	double lookahead;
+	/**
+	 * @brief 当前窗口的结束时间（不包括）
+	 */
+	double windowEnd;
+	/**
+	 * @brief 已执行的窗口数量
+	 */
+	uint64_t windows;
+	/**
+	 * @brief 各工作线程所分配逻辑进程的下一个事件时间最小值
+	 */
+	std::vector<double> minimums;
+protected:
+	/**
+	 * @brief 按照窗口同步推进分配给本线程的逻辑进程
+	 * @param  thread   工作线程序号
+	 */
+	virtual void runThread(unsigned thread);
+	/**
+	 * @brief 执行逻辑进程在当前窗口内的事件
+	 * @param  lp   逻辑进程
+	 * @return bool 是否执行了事件
+	 */
+	virtual bool advance(LogicalProcess * lp);
+public:
+	WindowEngine();
+	/**
+	 * @brief 获取窗口宽度
+	 * @return double 窗口宽度
+	 */
+	double getLookahead(){
+		return lookahead;
+	}
+	/**
+	 * @brief 获取最近一次运行执行的窗口数量
+	 * @return uint64_t 窗口数量
+	 */
+	uint64_t getWindowCount(){
+		return windows;
+	}
+	/**
+	 * @brief 获取同步协议名称
+	 * @return const char* 协议名称
+	 */
+	virtual const char * getProtocol(){
+		return "YAWNS WINDOW";
+	}
+	/**
+	 * @brief 打印各逻辑进程的统计结果，以及窗口宽度和窗口数量
+	 */
+	virtual void report();
+};
+
+}
+
+#endif /* WINDOW_ENGINE_H_ */
@@ -0,0 +1,339 @@
+/**
+ * @file ModelRegression.cpp
+ * @brief 示例和演示仿真模型的端到端性能回归测试程序
+ * 依次运行各模型的*_regress版本（模型程序与RunStats.cpp链接生成），屏蔽模型的控制台输出，
+ * 在临时目录中运行以免覆盖模型的输出文件。记录每个模型的墙钟时间（多次运行取最小值）、
+ * 执行的事件数量、内存用量峰值和内存分配次数，与基准文件比较：
+ *     事件数量与基准不同表示模型行为发生了变化（EVENTS）；不使用Simulator的模型没有事件数量，
+ *     基准文件中记为null，只比较其它指标
+ *     墙钟时间超过基准的(1+时间容差)倍且超过基准最小差值（SLOWER）
+ *     内存用量峰值超过基准的(1+内存容差)倍（MEMORY）
+ *     内存分配次数超过基准的(1+分配容差)倍（ALLOCS）
+ * 墙钟时间与编译模式和机器有关，更换机器或编译模式后应使用-update重新生成基准文件。
+ * 用法：ModelRegression [-bin 模型程序目录] [-baseline 基准文件] [-repeat 运行次数（缺省5）] [-update]
+ *                       [-time-tol 0.25] [-min-ms 2] [-mem-tol 0.2] [-alloc-tol 0.05] [-json 文件] [模型名称...]
+ * 存在回归或模型运行失败时返回1，否则返回0。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <ftw.h>
+	#include <unistd.h>
+	#include <sys/wait.h>
+	#include <sys/resource.h>
+#endif
+#include <chrono>
+
+using namespace std;
+
+//缺省的基准文件
+#ifndef MODEL_REGRESSION_BASELINE
+#define MODEL_REGRESSION_BASELINE "baseline.json"
+#endif
+
+//缺省测试的模型
+const char * DefaultModels[] = {
+	"Queue", "QueueBatch", "QueueRandom", "Queue3P", "QueueES", "QueuePI", "Queue_PI2",
+	"AbleBaker_3P", "AbleBaker_ES", "AbleBaker_PI",
+	"DumpTruck_3P", "DumpTruck_ES", "DumpTruck_PI",
+	"Philosopher_3P", "Philosopher_ES", "Philosopher_PI",
+	"Assembly", "FMS", "Inventory", "Philosopher", "QueueReplication"
+};
+
+/**
+ * @brief 模型的运行结果
+ */
+struct ModelResult{
+	string model;
+	double wallMs = 0;
+	uint64_t events = 0;
+	double peakRssKB = 0;
+	uint64_t allocations = 0;
+	/**
+	 * @brief 是否统计了事件数量，模型没有运行Simulator时为false
+	 */
+	bool eventsCounted = false;
+	/**
+	 * @brief 是否运行成功
+	 */
+	bool ok = false;
+};
+
+//从基准文件的一行中读取指定关键字的数值
+static bool readNumber(const string & line,const char * key,double & value){
+	string pattern = string("\"") + key + "\":";
+	size_t pos = line.find(pattern);
+	if(pos == string::npos){
+		return false;
+	}
+	value = strtod(line.c_str() + pos + pattern.size(),NULL);
+	return true;
+}
+
+//读取基准文件，基准文件由-update生成，每行一个模型
+static map<string,ModelResult> readBaseline(const char * fileName){
+	map<string,ModelResult> baseline;
+	FILE * file = fopen(fileName,"r");
+	if(file == NULL){
+		return baseline;
+	}
+	char buf[1024];
+	while(fgets(buf,sizeof(buf),file) != NULL){
+		string line(buf);
+		size_t pos = line.find("\"model\": \"");
+		if(pos == string::npos){
+			continue;
+		}
+		pos += strlen("\"model\": \"");
+		size_t end = line.find('"',pos);
+		ModelResult result;
+		result.model = line.substr(pos,end - pos);
+		double value;
+		if(readNumber(line,"wall_ms",value)) result.wallMs = value;
+		if(readNumber(line,"events",value) && line.find("\"events\": null") == string::npos){
+			result.events = (uint64_t)value;
+			result.eventsCounted = true;
+		}
+		if(readNumber(line,"peak_rss_kb",value)) result.peakRssKB = value;
+		if(readNumber(line,"allocations",value)) result.allocations = (uint64_t)value;
+		result.ok = true;
+		baseline[result.model] = result;
+	}
+	fclose(file);
+	return baseline;
+}
+
+//写入运行结果，status为空时不写入状态
+static void writeResults(const char * fileName,const vector<ModelResult> & results,const vector<string> & statuses){
+	FILE * file = fopen(fileName,"w");
+	if(file == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",fileName);
+		exit(1);
+	}
+	fprintf(file,"{\n  \"models\": [");
+	for(size_t i = 0;i < results.size();i ++){
+		const ModelResult & r = results[i];
+		string events = r.eventsCounted ? to_string((unsigned long long)r.events) : "null";
+		fprintf(file,"%s\n    {\"model\": \"%s\", \"wall_ms\": %.3f, \"events\": %s, \"peak_rss_kb\": %.0f, \"allocations\": %llu",
+				i == 0 ? "" : ",",r.model.c_str(),r.wallMs,events.c_str(),r.peakRssKB,
+				(unsigned long long)r.allocations);
+		if(!statuses.empty()){
+			fprintf(file,", \"status\": \"%s\"",statuses[i].c_str());
+		}
+		fprintf(file,"}");
+	}
+	fprintf(file,"\n  ]\n}\n");
+	fclose(file);
+}
+
+#ifndef _WIN32
+//删除临时目录中的一个文件或子目录，nftw按照先子项后目录的顺序调用
+static int removeEntry(const char * path,const struct stat * sb,int type,struct FTW * ftw){
+	return remove(path);
+}
+
+//运行一次模型，在临时目录中运行并屏蔽输入输出
+static bool runOnce(const string & executable,ModelResult & result){
+	char workDir[] = "/tmp/rubberduck_regress_XXXXXX";
+	if(mkdtemp(workDir) == NULL){
+		return false;
+	}
+	string statsFile = string(workDir) + "/runstats.txt";
+	auto start = std::chrono::steady_clock::now();
+	pid_t pid = fork();
+	if(pid < 0){
+		return false;
+	}
+	if(pid == 0){
+		if(chdir(workDir) != 0){
+			_exit(127);
+		}
+		int devNull = open("/dev/null",O_RDWR);
+		dup2(devNull,0);
+		dup2(devNull,1);
+		dup2(devNull,2);
+		setenv("RUBBERDUCK_RUNSTATS",statsFile.c_str(),1);
+		execl(executable.c_str(),executable.c_str(),(char *)NULL);
+		_exit(127);
+	}
+	int status = 0;
+	struct rusage usage;
+	if(wait4(pid,&status,0,&usage) < 0){
+		return false;
+	}
+	double wallMs = std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now() - start).count();
+	bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	if(ok){
+		result.wallMs = result.ok ? min(result.wallMs,wallMs) : wallMs;
+		result.peakRssKB = (double)usage.ru_maxrss;
+		FILE * file = fopen(statsFile.c_str(),"r");
+		unsigned long long events = 0, allocations = 0;
+		if(file == NULL || fscanf(file,"events %llu\nallocations %llu",&events,&allocations) != 2){
+			ok = false;
+		}
+		if(file != NULL){
+			fclose(file);
+		}
+		result.events = events;
+		result.eventsCounted = events > 0;
+		result.allocations = allocations;
+	}
+	//删除模型在临时目录中生成的文件
+	if(nftw(workDir,removeEntry,16,FTW_DEPTH | FTW_PHYS) != 0){
+		printf("警告：删除临时目录失败（%s）\n",workDir);
+	}
+	return ok;
+}
+#endif
+
+void usage(){
+	printf("用法：ModelRegression [-bin 模型程序目录] [-baseline 基准文件] [-repeat 运行次数（缺省5）] [-update]\n"
+			"                       [-time-tol 0.25] [-min-ms 2] [-mem-tol 0.2] [-alloc-tol 0.05] [-json 文件] [模型名称...]\n");
+	exit(1);
+}
+
+int main(int argc, char* argv[]){
+#ifdef _WIN32
+	printf("ModelRegression仅支持Linux平台\n");
+	return 1;
+#else
+	string binDir;
+	const char * baselineFileName = MODEL_REGRESSION_BASELINE;
+	const char * jsonFileName = NULL;
+	int repeat = 5;
+	bool update = false;
+	double timeTolerance = 0.25, minMs = 2, memoryTolerance = 0.2, allocTolerance = 0.05;
+	vector<string> models;
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-bin") == 0 && i + 1 < argc){
+			binDir = argv[++ i];
+		}else if(strcmp(argv[i],"-baseline") == 0 && i + 1 < argc){
+			baselineFileName = argv[++ i];
+		}else if(strcmp(argv[i],"-repeat") == 0 && i + 1 < argc){
+			repeat = atoi(argv[++ i]);
+		}else if(strcmp(argv[i],"-update") == 0){
+			update = true;
+		}else if(strcmp(argv[i],"-time-tol") == 0 && i + 1 < argc){
+			timeTolerance = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-min-ms") == 0 && i + 1 < argc){
+			minMs = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-mem-tol") == 0 && i + 1 < argc){
+			memoryTolerance = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-alloc-tol") == 0 && i + 1 < argc){
+			allocTolerance = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-json") == 0 && i + 1 < argc){
+			jsonFileName = argv[++ i];
+		}else if(argv[i][0] != '-'){
+			models.push_back(argv[i]);
+		}else{
+			usage();
+		}
+	}
+	if(repeat < 1){
+		usage();
+	}
+	//缺省在本程序所在目录中查找模型程序
+	if(binDir.empty()){
+		string self = argv[0];
+		size_t pos = self.rfind('/');
+		binDir = pos == string::npos ? "." : self.substr(0,pos);
+	}
+	//模型在临时目录中运行，需要使用绝对路径
+	char * absoluteDir = realpath(binDir.c_str(),NULL);
+	if(absoluteDir == NULL){
+		printf("错误：模型程序目录不存在（%s）\n",binDir.c_str());
+		return 1;
+	}
+	binDir = absoluteDir;
+	free(absoluteDir);
+	if(models.empty()){
+		for(size_t m = 0;m < sizeof(DefaultModels) / sizeof(DefaultModels[0]);m ++){
+			models.push_back(DefaultModels[m]);
+		}
+	}
+
+	map<string,ModelResult> baseline = readBaseline(baselineFileName);
+	if(baseline.empty() && !update){
+		printf("警告：基准文件不存在或为空（%s），仅记录运行结果\n",baselineFileName);
+	}
+	vector<ModelResult> results;
+	vector<string> statuses;
+	int failures = 0;
+	printf("%-18s %12s %12s %12s %10s %10s %12s %12s  %s\n",
+			"MODEL","WALL(ms)","BASE(ms)","EVENTS","RSS(KB)","BASE(KB)","ALLOCS","BASE ALLOCS","STATUS");
+	for(size_t m = 0;m < models.size();m ++){
+		ModelResult result;
+		result.model = models[m];
+		string executable = binDir + "/" + models[m] + "_regress";
+		bool ok = true;
+		for(int r = 0;r < repeat && ok;r ++){
+			ok = runOnce(executable,result);
+			result.ok = result.ok || ok;
+		}
+		result.ok = ok;
+
+		string status;
+		map<string,ModelResult>::iterator it = baseline.find(models[m]);
+		ModelResult base;
+		if(!ok){
+			status = "FAILED";
+		}else if(it == baseline.end()){
+			status = "NEW";
+		}else{
+			base = it->second;
+			if(result.eventsCounted != base.eventsCounted || result.events != base.events){
+				status += "+EVENTS";
+			}
+			if(result.wallMs > base.wallMs * (1 + timeTolerance) && result.wallMs - base.wallMs > minMs){
+				status += "+SLOWER";
+			}
+			if(result.peakRssKB > base.peakRssKB * (1 + memoryTolerance)){
+				status += "+MEMORY";
+			}
+			if(result.allocations > base.allocations * (1 + allocTolerance)){
+				status += "+ALLOCS";
+			}
+			status = status.empty() ? "ok" : status.substr(1);
+		}
+		if(status != "ok" && status != "NEW"){
+			failures ++;
+		}
+		string events = result.eventsCounted ? to_string((unsigned long long)result.events) : "-";
+		printf("%-18s %12.2f %12.2f %12s %10.0f %10.0f %12llu %12llu  %s\n",
+				result.model.c_str(),result.wallMs,base.wallMs,events.c_str(),
+				result.peakRssKB,base.peakRssKB,(unsigned long long)result.allocations,
+				(unsigned long long)base.allocations,status.c_str());
+		results.push_back(result);
+		statuses.push_back(status);
+	}
+
+	if(jsonFileName != NULL){
+		writeResults(jsonFileName,results,statuses);
+	}
+	if(update){
+		for(size_t i = 0;i < results.size();i ++){
+			if(!results[i].ok){
+				printf("错误：模型%s运行失败，未更新基准文件\n",results[i].model.c_str());
+				return 1;
+			}
+		}
+		writeResults(baselineFileName,results,vector<string>());
+		printf("已更新基准文件：%s\n",baselineFileName);
+		return 0;
+	}
+	printf("%d个模型，%d个回归或失败\n",(int)models.size(),failures);
+	return failures > 0 ? 1 : 0;
+#endif
+}
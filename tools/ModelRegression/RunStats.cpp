@@ -0,0 +1,110 @@
+/**
+ * @file RunStats.cpp
+ * @brief 仿真模型运行统计，与模型程序一起链接生成*_regress回归测试版本
+ * 替换全局operator new统计内存分配次数，通过Simulator::setInstanceHook记录模型创建的仿真引擎，
+ * 进程退出时如果设置了环境变量RUBBERDUCK_RUNSTATS，则将各仿真引擎执行的事件数量之和与内存分配次数
+ * 写入该环境变量指定的文件，由ModelRegression读取。
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+#include "Simulator.h"
+
+using namespace rubber_duck;
+
+//内存分配次数
+static std::atomic<uint64_t> Allocations(0);
+
+//存在的仿真引擎和已删除仿真引擎执行的事件数量，使用固定数组和自旋锁，不影响内存分配次数，
+//也不依赖静态对象的析构顺序
+static const int MaxSimulators = 1024;
+static Simulator * Simulators[MaxSimulators];
+static int SimulatorCount = 0;
+static uint64_t FinishedEvents = 0;
+static std::atomic_flag SimulatorLock = ATOMIC_FLAG_INIT;
+
+static void trackSimulator(Simulator * pSimulator,bool created){
+	while(SimulatorLock.test_and_set(std::memory_order_acquire)){
+	}
+	if(created){
+		if(SimulatorCount == MaxSimulators){
+			printf("错误：仿真引擎数量超过运行统计的上限（%d）\n",MaxSimulators);
+			exit(0);
+		}
+		Simulators[SimulatorCount ++] = pSimulator;
+	}else{
+		for(int i = 0;i < SimulatorCount;i ++){
+			if(Simulators[i] == pSimulator){
+				FinishedEvents += pSimulator->getEventCount();
+				Simulators[i] = Simulators[-- SimulatorCount];
+				break;
+			}
+		}
+	}
+	SimulatorLock.clear(std::memory_order_release);
+}
+
+static void * allocate(size_t size){
+	Allocations.fetch_add(1,std::memory_order_relaxed);
+	void * p = malloc(size == 0 ? 1 : size);
+	if(p == NULL){
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void * operator new(size_t size){
+	return allocate(size);
+}
+
+void * operator new[](size_t size){
+	return allocate(size);
+}
+
+void operator delete(void * p) noexcept{
+	free(p);
+}
+
+void operator delete[](void * p) noexcept{
+	free(p);
+}
+
+void operator delete(void * p,size_t) noexcept{
+	free(p);
+}
+
+void operator delete[](void * p,size_t) noexcept{
+	free(p);
+}
+
+//进程退出时写入运行统计
+static void writeRunStats(){
+	const char * fileName = getenv("RUBBERDUCK_RUNSTATS");
+	if(fileName == NULL){
+		return;
+	}
+	FILE * file = fopen(fileName,"w");
+	if(file == NULL){
+		return;
+	}
+	uint64_t events = FinishedEvents;
+	for(int i = 0;i < SimulatorCount;i ++){
+		events += Simulators[i]->getEventCount();
+	}
+	fprintf(file,"events %llu\nallocations %llu\n",(unsigned long long)events,(unsigned long long)Allocations.load());
+	fclose(file);
+}
+
+static struct RunStatsRegistrar{
+	RunStatsRegistrar(){
+		Simulator::setInstanceHook(trackSimulator);
+		atexit(writeRunStats);
+	}
+} registrar;
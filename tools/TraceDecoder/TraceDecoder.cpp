@@ -0,0 +1,179 @@
+/**
+ * @file TraceDecoder.cpp
+ * @brief 二进制事件跟踪文件解码程序，将Simulator::setBinaryTrace记录的跟踪文件转换为文本或CSV格式
+ * 用法：TraceDecoder 跟踪文件 [-csv] [-from 开始时间] [-to 结束时间] [-type 事件类名称] [-op 操作] [-o 输出文件]
+ *     -csv     输出CSV格式，缺省输出文本格式
+ *     -from    仅输出仿真时间不小于开始时间的记录
+ *     -to      仅输出仿真时间不大于结束时间的记录
+ *     -type    仅输出事件类名称包含指定字符串的记录，可以多次指定
+ *     -op      仅输出指定操作的记录：schedule、trigger、cancel、fel或cel
+ * @author liqun (liqun@nudt.edu.cn)
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright(C) 2026 liqun
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "BinaryTrace.h"
+
+using namespace std;
+using namespace rubber_duck;
+
+//操作名称
+const char * OpNames[] = {"", "FEL添加", "CEL添加", "执行未来事件", "执行条件事件", "取消事件"};
+//CSV格式的操作名称
+const char * OpKeys[] = {"", "schedule_fel", "schedule_cel", "trigger_fel", "trigger_cel", "cancel"};
+
+//读取名称表
+bool readTable(const vector<char> & data,uint64_t offset,vector<string> & table){
+	uint32_t count;
+	if(offset + sizeof(count) > data.size()) return false;
+	memcpy(&count,&data[offset],sizeof(count));
+	offset += sizeof(count);
+	for(uint32_t i = 0;i < count;i ++){
+		uint32_t len;
+		if(offset + sizeof(len) > data.size()) return false;
+		memcpy(&len,&data[offset],sizeof(len));
+		offset += sizeof(len);
+		if(offset + len > data.size()) return false;
+		table.push_back(string(&data[offset],len));
+		offset += len;
+	}
+	return true;
+}
+
+//判断操作是否满足-op过滤条件
+bool matchOp(uint32_t op,const char * filter){
+	if(filter == NULL) return true;
+	if(strcmp(filter,"schedule") == 0) return op == TRACE_SCHEDULE_FEL || op == TRACE_SCHEDULE_CEL;
+	if(strcmp(filter,"trigger") == 0) return op == TRACE_TRIGGER_FEL || op == TRACE_TRIGGER_CEL;
+	if(strcmp(filter,"cancel") == 0) return op == TRACE_CANCEL;
+	if(strcmp(filter,"fel") == 0) return op == TRACE_SCHEDULE_FEL || op == TRACE_TRIGGER_FEL;
+	if(strcmp(filter,"cel") == 0) return op == TRACE_SCHEDULE_CEL || op == TRACE_TRIGGER_CEL;
+	return false;
+}
+
+//CSV字段中的双引号需要转义
+string csvQuote(const string & s){
+	string result = "\"";
+	for(size_t i = 0;i < s.size();i ++){
+		if(s[i] == '"') result += '"';
+		result += s[i];
+	}
+	return result + "\"";
+}
+
+void usage(){
+	printf("用法：TraceDecoder 跟踪文件 [-csv] [-from 开始时间] [-to 结束时间] [-type 事件类名称] [-op schedule|trigger|cancel|fel|cel] [-o 输出文件]\n");
+	exit(0);
+}
+
+int main(int argc, char* argv[]){
+	const char * traceFileName = NULL;
+	const char * outFileName = NULL;
+	const char * opFilter = NULL;
+	bool csv = false;
+	double from = -1e300, to = 1e300;
+	vector<string> typeFilters;
+
+	for(int i = 1;i < argc;i ++){
+		if(strcmp(argv[i],"-csv") == 0){
+			csv = true;
+		}else if(strcmp(argv[i],"-from") == 0 && i + 1 < argc){
+			from = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-to") == 0 && i + 1 < argc){
+			to = atof(argv[++ i]);
+		}else if(strcmp(argv[i],"-type") == 0 && i + 1 < argc){
+			typeFilters.push_back(argv[++ i]);
+		}else if(strcmp(argv[i],"-op") == 0 && i + 1 < argc){
+			opFilter = argv[++ i];
+		}else if(strcmp(argv[i],"-o") == 0 && i + 1 < argc){
+			outFileName = argv[++ i];
+		}else if(argv[i][0] != '-' && traceFileName == NULL){
+			traceFileName = argv[i];
+		}else{
+			usage();
+		}
+	}
+	if(traceFileName == NULL){
+		usage();
+	}
+
+	FILE * in = fopen(traceFileName,"rb");
+	if(in == NULL){
+		printf("错误：打开文件失败（%s），请检查路径或访问权限\n",traceFileName);
+		return 1;
+	}
+	vector<char> data;
+	char block[65536];
+	size_t n;
+	while((n = fread(block,1,sizeof(block),in)) > 0){
+		data.insert(data.end(),block,block + n);
+	}
+	fclose(in);
+
+	TraceFileHeader header;
+	if(data.size() < sizeof(header)){
+		printf("错误：跟踪文件格式错误（%s）\n",traceFileName);
+		return 1;
+	}
+	memcpy(&header,&data[0],sizeof(header));
+	if(memcmp(header.magic,TRACE_MAGIC,8) != 0 || header.recordSize != sizeof(TraceRecord)
+			|| sizeof(header) + header.recordCount * sizeof(TraceRecord) > data.size()){
+		printf("错误：跟踪文件格式错误（%s）\n",traceFileName);
+		return 1;
+	}
+	vector<string> typeNames, names;
+	if(!readTable(data,header.typeTableOffset,typeNames) || !readTable(data,header.nameTableOffset,names)){
+		printf("错误：跟踪文件名称表错误（%s）\n",traceFileName);
+		return 1;
+	}
+	//按照事件类名称过滤
+	vector<bool> typeSelected(typeNames.size(),typeFilters.empty());
+	for(size_t t = 0;t < typeNames.size();t ++){
+		for(size_t f = 0;f < typeFilters.size();f ++){
+			if(typeNames[t].find(typeFilters[f]) != string::npos){
+				typeSelected[t] = true;
+			}
+		}
+	}
+
+	FILE * out = stdout;
+	if(outFileName != NULL){
+		out = fopen(outFileName,"w");
+		if(out == NULL){
+			printf("错误：打开文件失败（%s），请检查路径或访问权限\n",outFileName);
+			return 1;
+		}
+	}
+	if(csv){
+		fprintf(out,"clock,op,type,name,event_time,object_id\n");
+	}
+	const TraceRecord * records = (const TraceRecord *)(&data[0] + sizeof(header));
+	uint64_t selected = 0;
+	for(uint64_t i = 0;i < header.recordCount;i ++){
+		TraceRecord r;
+		memcpy(&r,records + i,sizeof(r));
+		if(r.clock < from || r.clock > to) continue;
+		if(r.typeId >= typeNames.size() || r.nameId >= names.size() || r.op < 1 || r.op > TRACE_CANCEL) continue;
+		if(!typeSelected[r.typeId] || !matchOp(r.op,opFilter)) continue;
+		if(csv){
+			fprintf(out,"%f,%s,%s,%s,%f,%llu\n",r.clock,OpKeys[r.op],csvQuote(typeNames[r.typeId]).c_str(),
+					csvQuote(names[r.nameId]).c_str(),r.eventTime,(unsigned long long)r.objectId);
+		}else{
+			fprintf(out,"仿真时间=%f %s(%s) 类型：%s 发生时间：%f 对象：%llx\n",r.clock,OpNames[r.op],
+					names[r.nameId].c_str(),typeNames[r.typeId].c_str(),r.eventTime,(unsigned long long)r.objectId);
+		}
+		selected ++;
+	}
+	if(out != stdout){
+		fclose(out);
+	}
+	fprintf(stderr,"共%llu条记录，输出%llu条记录\n",(unsigned long long)header.recordCount,(unsigned long long)selected);
+	return 0;
+}